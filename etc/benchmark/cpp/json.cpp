@@ -0,0 +1,132 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include <libstdhl/Json>
+
+#include <hayai/hayai.hpp>
+
+#include <random>
+
+using namespace libstdhl;
+
+namespace
+{
+    /**
+       fixed seed, every run works on the same synthetic document
+    */
+    static constexpr u32 Seed = 0x5eed;
+
+    static constexpr std::size_t Items = 1024;
+
+    /**
+       LSP-like document with nested objects, numbers and escaped texts
+    */
+    const std::string& document( void )
+    {
+        static const std::string cache = [ ]( ) {
+            std::mt19937 engine( Seed );
+            std::uniform_int_distribution< std::size_t > length( 16, 256 );
+            std::uniform_int_distribution< int > character( ' ', '~' );
+            std::uniform_int_distribution< i64 > number( -100000, 100000 );
+
+            Json::Object items = Json::Object::array();
+            for( std::size_t i = 0; i < Items; i++ )
+            {
+                std::string text( length( engine ), ' ' );
+                for( auto& c : text )
+                {
+                    c = static_cast< char >( character( engine ) );
+                }
+                text += '\n';
+
+                items.push_back(
+                    { { "range",
+                        { { "start", { { "line", i }, { "character", number( engine ) } } },
+                          { "end", { { "line", i + 1 }, { "character", 0 } } } } },
+                      { "severity", 1.5 },
+                      { "message", text } } );
+            }
+
+            return Json::Object( { { "jsonrpc", "2.0" }, { "items", items } } ).dump();
+        }();
+        return cache;
+    }
+}
+
+BENCHMARK( libstdhl_json, parse_reference, 10, 10 )
+{
+    const auto& data = document();
+    Json::Object::parse( data.data(), data.data() + data.size() );
+}
+
+BENCHMARK( libstdhl_json, parse, 10, 10 )
+{
+    const auto& data = document();
+    Json::parse( data.data(), data.size() );
+}
+
+BENCHMARK( libstdhl_json, document, 10, 10 )
+{
+    const auto& data = document();
+    Json::Document( data.data(), data.size() );
+}
+
+BENCHMARK( libstdhl_json, dump_reference, 10, 10 )
+{
+    static const auto object = Json::parse( document() );
+    object.dump();
+}
+
+BENCHMARK( libstdhl_json, dump, 10, 10 )
+{
+    static const auto object = Json::parse( document() );
+    Json::dump( object );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
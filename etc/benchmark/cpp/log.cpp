@@ -0,0 +1,382 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include <libstdhl/Log>
+
+#include <hayai/hayai.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+using namespace libstdhl;
+
+namespace
+{
+    /**
+       fixed seed, every run works on the same synthetic records
+    */
+    static constexpr u32 Seed = 0x5eed;
+
+    static constexpr std::size_t Records = 1024;
+
+    static constexpr std::size_t Threads = 4;
+
+    class NullSink final : public Log::Channel
+    {
+      public:
+        using Ptr = std::shared_ptr< NullSink >;
+
+        void process( const Log::Stream& stream ) override
+        {
+            m_records.fetch_add( stream.data().size(), std::memory_order_relaxed );
+        }
+
+      private:
+        std::atomic< std::size_t > m_records{ 0 };
+    };
+
+    struct Workload
+    {
+        std::vector< Log::Source::Ptr > sources;
+
+        std::vector< Log::Category::Ptr > categories;
+
+        std::vector< std::string > texts;
+
+        Workload( void )
+        {
+            std::mt19937 engine( Seed );
+            std::uniform_int_distribution< std::size_t > length( 16, 128 );
+            std::uniform_int_distribution< int > character( 'a', 'z' );
+
+            for( std::size_t i = 0; i < 16; i++ )
+            {
+                const auto name = std::to_string( i );
+                sources.emplace_back(
+                    std::make_shared< Log::Source >( "source" + name, "benchmark source" ) );
+                categories.emplace_back( std::make_shared< Log::Category >(
+                    "category" + name, "benchmark category" ) );
+            }
+
+            for( std::size_t i = 0; i < 64; i++ )
+            {
+                std::string text( length( engine ), ' ' );
+                for( auto& c : text )
+                {
+                    c = static_cast< char >( character( engine ) );
+                }
+                texts.emplace_back( text );
+            }
+        }
+    };
+
+    const Workload& workload( void )
+    {
+        static const Workload cache;
+        return cache;
+    }
+
+    void fill( Log::Stream& stream, const std::size_t items )
+    {
+        const auto& workload = ::workload();
+        std::mt19937 engine( Seed );
+        std::uniform_int_distribution< std::size_t > index( 0, 15 );
+        std::uniform_int_distribution< std::size_t > text( 0, 63 );
+        std::uniform_int_distribution< int > level(
+            static_cast< int >( Log::Level::ID::ERROR ),
+            static_cast< int >( Log::Level::ID::DEBUG ) );
+
+        for( std::size_t record = 0; record < Records; record++ )
+        {
+            stream.add(
+                static_cast< Log::Level::ID >( level( engine ) ),
+                workload.sources[ index( engine ) ],
+                workload.categories[ index( engine ) ] );
+
+            for( std::size_t item = 0; item < items; item++ )
+            {
+                stream.data().back().add< Log::TextItem >( workload.texts[ text( engine ) ] );
+            }
+        }
+    }
+
+    void log( Logger& logger )
+    {
+        const auto& workload = ::workload();
+        std::mt19937 engine( Seed );
+        std::uniform_int_distribution< std::size_t > text( 0, 63 );
+
+        for( std::size_t record = 0; record < Records; record++ )
+        {
+            logger.info( workload.texts[ text( engine ) ] );
+        }
+    }
+
+    class FilterFixture : public ::hayai::Fixture
+    {
+      public:
+        void SetUp( void ) override
+        {
+            fill( m_stream, 1 );
+
+            const auto& workload = ::workload();
+            const auto sink = std::make_shared< NullSink >();
+
+            for( const auto filters : { 1, 8, 64 } )
+            {
+                auto& router = m_routers[ filters ];
+                router.reset( new Log::Router() );
+
+                for( int i = 0; i < filters; i++ )
+                {
+                    auto filter = router->add< Log::Filter >();
+                    filter->setCategory( workload.categories[ i % workload.categories.size() ] );
+                    filter->setChannel( sink );
+                }
+            }
+        }
+
+        void TearDown( void ) override
+        {
+            m_routers.clear();
+            m_stream = Log::Stream();
+        }
+
+        void route( const std::size_t filters )
+        {
+            m_routers.at( filters )->process( m_stream );
+        }
+
+      protected:
+        Log::Stream m_stream;
+
+        std::unordered_map< std::size_t, std::unique_ptr< Log::Router > > m_routers;
+    };
+
+    class FormatterFixture : public ::hayai::Fixture
+    {
+      public:
+        void SetUp( void ) override
+        {
+            fill( m_stream, 2 );
+        }
+
+        void TearDown( void ) override
+        {
+            m_stream = Log::Stream();
+        }
+
+        void format( Log::Formatter& formatter )
+        {
+            std::string buffer;
+            for( auto& data : m_stream.data() )
+            {
+                buffer.clear();
+                data.accept( formatter, buffer );
+            }
+        }
+
+      protected:
+        Log::Stream m_stream;
+    };
+
+    class FileSinkFixture : public ::hayai::Fixture
+    {
+      public:
+        void TearDown( void ) override
+        {
+            std::remove( filename().c_str() );
+        }
+
+        static std::string filename( void )
+        {
+            return "libstdhl-benchmark-log.txt";
+        }
+    };
+}
+
+//
+// records/s per thread count, each record is logged, flushed and routed
+//
+
+BENCHMARK( libstdhl_log, logger_1_thread, 10, 10 )
+{
+    const auto sink = std::make_shared< NullSink >();
+
+    Log::Stream stream;
+    Logger logger( stream );
+    log( logger );
+    stream.flush( *sink );
+}
+
+BENCHMARK( libstdhl_log, logger_4_threads, 10, 10 )
+{
+    const auto sink = std::make_shared< NullSink >();
+    Log::Router router;
+    router.add< Log::Filter >()->setChannel( sink );
+
+    std::vector< std::thread > threads;
+    for( std::size_t thread = 0; thread < Threads; thread++ )
+    {
+        threads.emplace_back( [&]( void ) {
+            Log::Stream stream;
+            Logger logger( stream );
+            log( logger );
+            stream.flush( router );
+        } );
+    }
+
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+}
+
+//
+// cost per record by item count
+//
+
+BENCHMARK( libstdhl_log, stream_1_item, 10, 10 )
+{
+    NullSink sink;
+    Log::Stream stream;
+    fill( stream, 1 );
+    stream.flush( sink );
+}
+
+BENCHMARK( libstdhl_log, stream_4_items, 10, 10 )
+{
+    NullSink sink;
+    Log::Stream stream;
+    fill( stream, 4 );
+    stream.flush( sink );
+}
+
+BENCHMARK( libstdhl_log, stream_16_items, 10, 10 )
+{
+    NullSink sink;
+    Log::Stream stream;
+    fill( stream, 16 );
+    stream.flush( sink );
+}
+
+//
+// filter matching cost against N filters
+//
+
+BENCHMARK_F( FilterFixture, router_1_filter, 10, 100 )
+{
+    route( 1 );
+}
+
+BENCHMARK_F( FilterFixture, router_8_filters, 10, 100 )
+{
+    route( 8 );
+}
+
+BENCHMARK_F( FilterFixture, router_64_filters, 10, 100 )
+{
+    route( 64 );
+}
+
+//
+// formatter cost per Formatter type
+//
+
+BENCHMARK_F( FormatterFixture, string_formatter, 10, 100 )
+{
+    Log::StringFormatter formatter;
+    format( formatter );
+}
+
+BENCHMARK_F( FormatterFixture, console_formatter, 10, 100 )
+{
+    Log::ConsoleFormatter formatter;
+    format( formatter );
+}
+
+BENCHMARK_F( FormatterFixture, application_formatter, 10, 100 )
+{
+    Log::ApplicationFormatter formatter( "benchmark" );
+    format( formatter );
+}
+
+//
+// end-to-end latency from the logger to a sink
+//
+
+BENCHMARK( libstdhl_log, null_sink, 10, 10 )
+{
+    std::ostream null( nullptr );
+    Log::StringFormatter formatter;
+    Log::OutputStreamSink sink( null, formatter );
+
+    Log::Stream stream;
+    Logger logger( stream );
+    log( logger );
+    stream.flush( sink );
+}
+
+BENCHMARK_F( FileSinkFixture, file_sink, 10, 10 )
+{
+    Log::StringFormatter formatter;
+    Log::FileSink sink( filename(), formatter );
+
+    Log::Stream stream;
+    Logger logger( stream );
+    log( logger );
+    stream.flush( sink );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
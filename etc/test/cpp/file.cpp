@@ -182,6 +182,81 @@ eof)***";
     EXPECT_FALSE( libstdhl::File::exists( filename ) );
 }
 
+TEST( libstdhl_cpp_File_Cache, readLine_is_invalidated_on_change )
+{
+    // GIVEN
+    const std::string filename = TEST_NAME + ".txt";
+    auto file = libstdhl::File::open( filename, std::fstream::out );
+    file << "\nfoo\nbar foo\n";
+    file.close();
+
+    // WHEN
+    EXPECT_EQ( libstdhl::File::Cache::lines( filename ), 3 );
+
+    // THEN
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 1 ).c_str(), "" );
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 2 ).c_str(), "foo" );
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 3 ).c_str(), "bar foo" );
+    EXPECT_THROW( libstdhl::File::Cache::readLine( filename, 0 ), FileNumberOutOfRangeException );
+    EXPECT_THROW( libstdhl::File::Cache::readLine( filename, 4 ), FileNumberOutOfRangeException );
+
+    // WHEN
+    file = libstdhl::File::open( filename, std::fstream::out | std::fstream::trunc );
+    file << "qux\neof";
+    file.close();
+
+    // THEN
+    EXPECT_EQ( libstdhl::File::Cache::lines( filename ), 2 );
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 2 ).c_str(), "eof" );
+
+    // CLEANUP
+    libstdhl::File::Cache::remove( filename );
+    libstdhl::File::remove( filename );
+    EXPECT_THROW( libstdhl::File::Cache::readLine( filename, 1 ), std::invalid_argument );
+}
+
+TEST( libstdhl_cpp_File_Cache, reload_on_same_size_change_and_evict_beyond_capacity )
+{
+    // GIVEN
+    const std::string filename = TEST_NAME + ".txt";
+    const std::string other = TEST_NAME + "_other.txt";
+    auto file = libstdhl::File::open( filename, std::fstream::out );
+    file << "aaa\n";
+    file.close();
+    file = libstdhl::File::open( other, std::fstream::out );
+    file << "other\n";
+    file.close();
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 1 ).c_str(), "aaa" );
+
+    // WHEN
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    file = libstdhl::File::open( filename, std::fstream::out | std::fstream::trunc );
+    file << "bbb\n";
+    file.close();
+
+    // THEN
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 1 ).c_str(), "bbb" );
+
+    // WHEN
+    const auto capacity = libstdhl::File::Cache::capacity();
+    libstdhl::File::Cache::clear();
+    libstdhl::File::Cache::setCapacity( 1 );
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( filename, 1 ).c_str(), "bbb" );
+    const auto size = libstdhl::File::Cache::size();
+    EXPECT_STREQ( libstdhl::File::Cache::readLine( other, 1 ).c_str(), "other" );
+
+    // THEN
+    EXPECT_GT( size, 0 );
+    EXPECT_NE( libstdhl::File::Cache::size(), size );
+    EXPECT_LT( libstdhl::File::Cache::size(), 2 * size );
+
+    // CLEANUP
+    libstdhl::File::Cache::setCapacity( capacity );
+    libstdhl::File::Cache::clear();
+    libstdhl::File::remove( filename );
+    libstdhl::File::remove( other );
+}
+
 //
 //
 // File::Path
@@ -43,11 +43,117 @@
 
 using namespace libstdhl;
 
+/**
+   runs 'test' with the scalar and, if supported, with the AVX2 structural index
+*/
+static void forEachClassifier( const std::function< void( void ) >& test )
+{
+    for( const auto accelerated : { false, true } )
+    {
+        if( not Json::Document::accelerate( accelerated ) )
+        {
+            continue;
+        }
+
+        SCOPED_TRACE( accelerated ? "avx2" : "scalar" );
+        test();
+    }
+
+    Json::Document::accelerate( true );
+}
+
 TEST( libstdhl_cpp_Json, example )
 {
     libstdhl::Json::Object obj = "{ \"key\" : true }"_json;
 }
 
+TEST( libstdhl_cpp_Json, parse_and_dump_equal_reference )
+{
+    forEachClassifier( [&]() {
+        const std::vector< std::string > inputs = {
+            "{}",
+            "[]",
+            "  { \"a\" : [ 1, -2, 3.5, -0, 1e3, 2E-2, true, false, null ] , \"b\" : {} }  ",
+            "\"plain\"",
+            "\"esc \\\" \\\\ \\/ \\b \\f \\n \\r \\t \\u0001 \\u00e4 \\u20AC \\ud83d\\ude00\"",
+            "\"utf-8 \xc3\xa4 \xe2\x82\xac \xf0\x9f\x98\x80\"",
+            "18446744073709551615",
+            "18446744073709551616",
+            "-9223372036854775808",
+            "-9223372036854775809",
+            "1e400",
+            "{ \"key\" : 1, \"key\" : 2 }",
+            "[[[[[[[[[[\"deep\"]]]]]]]]]]",
+            "{\"a\\\"b\":\"[{,:}]\",\"c\\\\\":\"\\\\\"}",
+        };
+
+        for( const auto& input : inputs )
+        {
+            const auto reference = Json::Object::parse( input );
+            const auto object = Json::parse( input );
+            EXPECT_EQ( object, reference ) << input;
+            EXPECT_EQ( Json::dump( object ), reference.dump() ) << input;
+        }
+    } );
+}
+
+TEST( libstdhl_cpp_Json, parse_across_blocks )
+{
+    forEachClassifier( [&]() {
+        Json::Object reference = Json::Object::array();
+        for( std::size_t i = 0; i < 100; i++ )
+        {
+            reference.push_back( { { "index", i },
+                                   { "text", std::string( i, '\\' ) + std::string( i % 7, '"' ) },
+                                   { "value", -0.25 * i } } );
+        }
+
+        const auto input = reference.dump();
+        EXPECT_EQ( Json::parse( input ), reference );
+        EXPECT_EQ( Json::dump( reference ), input );
+
+        for( std::size_t i = 0; i < 64; i++ )
+        {
+            const auto padded = std::string( i, ' ' ) + input;
+            EXPECT_EQ( Json::parse( padded ), reference );
+        }
+    } );
+}
+
+TEST( libstdhl_cpp_Json, parse_invalid_throws )
+{
+    forEachClassifier( [&]() {
+        const std::vector< std::string > inputs = {
+            "",
+            "{",
+            "[1,]",
+            "{\"a\" 1}",
+            "{\"a\":1,}",
+            "[1 2]",
+            "\"open",
+            "\"bad \\x escape\"",
+            "\"\\ud83d alone\"",
+            "\"\\ude00 alone\"",
+            "\"control \x01\"",
+            "\"invalid \xc0\xaf\"",
+            "01",
+            "1.",
+            "-",
+            "tru",
+            "nulll",
+            "[] []",
+        };
+
+        for( const auto& input : inputs )
+        {
+            EXPECT_THROW( Json::Object::parse( input ), std::invalid_argument ) << input;
+            EXPECT_THROW( Json::parse( input ), std::invalid_argument ) << input;
+            EXPECT_THROW( Json::Document( input.data(), input.size() ), std::invalid_argument )
+                << input;
+        }
+    } );
+}
+
 //
 //  Local variables:
 //  mode: c++
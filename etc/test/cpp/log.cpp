@@ -41,6 +41,9 @@
 
 #include <libstdhl/Test>
 
+#include <csignal>
+#include <thread>
+
 using namespace libstdhl;
 
 TEST( libstdhl_cpp_Log, example )
@@ -122,6 +125,1019 @@ TEST( libstdhl_cpp_Log, merging_two_streams_and_routing_them_to_two_sinks )
     s.flush( rr );
 }
 
+TEST( libstdhl_cpp_Log, formatter_append_to_buffer )
+{
+    Log::Data data( Log::Level::ID::WARNING, "text" );
+    data.add< Log::LocationItem >( "file.txt", 1, 2, 3, 4 );
+
+    Log::StringFormatter f;
+
+    std::string buffer = "prefix ";
+    data.accept( f, buffer );
+
+    EXPECT_EQ( buffer, "prefix " + data.accept( f ) );
+    EXPECT_EQ( f.visit( data ), data.accept( f ) );
+
+    const auto suffix = std::string( ": warning: text, file.txt:1:2..3:4" );
+    EXPECT_EQ( buffer.substr( buffer.size() - suffix.size() ), suffix );
+}
+
+TEST( libstdhl_cpp_Log, output_stream_sink_writes_batch )
+{
+    Log::Stream s;
+    s.add( Log::Level::ID::ERROR, "A" );
+    s.add( Log::Level::ID::WARNING, "B" );
+
+    Log::ConsoleFormatter f;
+    std::stringstream out;
+    Log::OutputStreamSink z( out, f );
+
+    s.flush( z );
+    s.add( Log::Level::ID::NOTICE, "C" );
+    s.flush( z );
+
+    EXPECT_EQ(
+        out.str(),
+        "libstdhl::Log: error: A\n"
+        "libstdhl::Log: warning: B\n"
+        "libstdhl::Log: notice: C\n" );
+}
+
+TEST( libstdhl_cpp_Log, filter_forwards_each_matching_record_once )
+{
+    const auto src = std::make_shared< Log::Source >( "src", "test source" );
+    const auto cat = std::make_shared< Log::Category >( "cat", "test category" );
+
+    Log::Stream s;
+    s.add( Log::Level::ID::ERROR, src, cat, "A" );
+    s.add( Log::Level::ID::ERROR, "B" );
+    s.add( Log::Level::ID::WARNING, src, Log::Category::defaultCategory(), "C" );
+    s.add( Log::Level::ID::NOTICE, "D" );
+
+    Log::ConsoleFormatter f;
+    std::stringstream out;
+    std::stringstream inv;
+
+    Log::Router rr;
+
+    auto f0 = rr.add< Log::Filter >();
+    f0->setLevel( Log::Level::ID::ERROR );
+    f0->setSource( std::make_shared< Log::Source >( "src", "test source" ) );
+    f0->setCategory( cat );
+    f0->set< Log::OutputStreamSink >( out, f );
+
+    auto f1 = rr.add< Log::Filter >();
+    f1->setInverse( true );
+    f1->setLevel( Log::Level::ID::ERROR );
+    f1->setSource( src );
+    f1->set< Log::OutputStreamSink >( inv, f );
+
+    EXPECT_TRUE( f0->match( s.data()[ 0 ] ) );
+    EXPECT_FALSE( f0->match( s.data()[ 3 ] ) );
+
+    s.flush( rr );
+
+    EXPECT_EQ( out.str(), "src: error: A\nlibstdhl::Log: error: B\nsrc: warning: C\n" );
+    EXPECT_EQ( inv.str(), "libstdhl::Log: notice: D\n" );
+}
+
+TEST( libstdhl_cpp_Log, filter_forwards_passing_batches_without_copying )
+{
+    class Recording final : public Log::Channel
+    {
+      public:
+        void process( const Log::Stream& stream ) override
+        {
+            streams.emplace_back( &stream );
+            records.emplace_back( stream.data().size() );
+        }
+
+        std::vector< const Log::Stream* > streams;
+
+        std::vector< std::size_t > records;
+    };
+
+    Log::Stream s;
+    s.add( Log::Level::ID::ERROR, "A" );
+    s.add( Log::Level::ID::WARNING, "B" );
+
+    Log::Filter filter;
+    filter.setLevel( Log::Level::ID::ERROR );
+    const auto channel = std::make_shared< Recording >();
+    filter.setChannel( channel );
+
+    filter.process( s );
+    filter.setLevel( Log::Level::ID::WARNING );
+    filter.process( s );
+
+    ASSERT_EQ( channel->streams.size(), 2 );
+    EXPECT_NE( channel->streams[ 0 ], &s );
+    EXPECT_EQ( channel->records[ 0 ], 1 );
+    EXPECT_EQ( channel->streams[ 1 ], &s );
+    EXPECT_EQ( channel->records[ 1 ], 2 );
+    EXPECT_EQ( s.data().size(), 2 );
+}
+
+TEST( libstdhl_cpp_Log, parallel_switch_fans_out_to_all_channels )
+{
+    Log::StringFormatter sf;
+    Log::ConsoleFormatter cf;
+    std::stringstream a;
+    std::stringstream b;
+
+    Log::Switch sw;
+    sw.add< Log::OutputStreamSink >( a, sf );
+    sw.setParallel( true, 2 );
+    sw.add< Log::OutputStreamSink >( b, cf );
+    EXPECT_TRUE( sw.parallel() );
+
+    Log::Stream s;
+    for( std::size_t batch = 0; batch < 8; batch++ )
+    {
+        s.add( Log::Level::ID::INFORMATIONAL, "batch " + std::to_string( batch ) );
+        s.flush( sw );
+    }
+
+    sw.wait();
+
+    std::string expected = "";
+    for( std::size_t batch = 0; batch < 8; batch++ )
+    {
+        expected += "libstdhl::Log: info: batch " + std::to_string( batch ) + "\n";
+    }
+
+    const auto output = a.str();
+    EXPECT_EQ( std::count( output.begin(), output.end(), '\n' ), 8 );
+    EXPECT_EQ( b.str(), expected );
+}
+
+TEST( libstdhl_cpp_Log, parallel_switch_isolates_channels )
+{
+    struct Failing final : public Log::Channel
+    {
+        void process( const Log::Stream& stream ) override
+        {
+            if( stream.data().size() > 1 )
+            {
+                throw std::runtime_error( "processing failed" );
+            }
+        }
+    };
+
+    Log::StringFormatter f;
+    std::stringstream output;
+
+    Log::Switch sw;
+    sw.add< Failing >();
+    sw.add< Log::OutputStreamSink >( output, f );
+    sw.setParallel( true, 4 );
+
+    Log::Stream s;
+    s.add( Log::Level::ID::INFORMATIONAL, "a" );
+    s.add( Log::Level::ID::INFORMATIONAL, "b" );
+    s.flush( sw );
+    s.add( Log::Level::ID::INFORMATIONAL, "c" );
+    s.flush( sw );
+
+    // the failing channel neither terminates its worker nor affects the other channel
+    EXPECT_THROW( sw.wait(), std::runtime_error );
+    EXPECT_NO_THROW( sw.wait() );
+    const auto text = output.str();
+    EXPECT_EQ( std::count( text.begin(), text.end(), '\n' ), 3 );
+    EXPECT_NE( text.find( "info: c\n" ), std::string::npos );
+}
+
+TEST( libstdhl_cpp_Log, parallel_switch_drains_replaced_workers )
+{
+    struct Slow final : public Log::Channel
+    {
+        std::atomic< std::size_t > records{ 0 };
+
+        void process( const Log::Stream& stream ) override
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            records += stream.data().size();
+        }
+    };
+
+    const auto removed = std::make_shared< Slow >();
+    const auto kept = std::make_shared< Slow >();
+
+    Log::Switch sw;
+    sw.addChannel( removed );
+    sw.addChannel( kept );
+    sw.setParallel( true, 64 );
+
+    Log::Stream s;
+    for( std::size_t batch = 0; batch < 16; batch++ )
+    {
+        s.add( Log::Level::ID::INFORMATIONAL, "batch" );
+        s.flush( sw );
+    }
+
+    // reconfiguration returns once the replaced workers processed their batches
+    sw.removeChannel( removed );
+    EXPECT_EQ( removed->records.load(), 16 );
+
+    s.add( Log::Level::ID::INFORMATIONAL, "batch" );
+    s.flush( sw );
+    sw.setParallel( false );
+    EXPECT_EQ( kept->records.load(), 17 );
+    EXPECT_EQ( removed->records.load(), 16 );
+}
+
+TEST( libstdhl_cpp_Log, switch_reconfigures_from_inside_a_channel )
+{
+    struct Reconfiguring final : public Log::Channel
+    {
+        Log::Switch* owner = nullptr;
+
+        Log::Channel::Ptr other;
+
+        void process( const Log::Stream& ) override
+        {
+            owner->removeChannel( other );
+            owner->addChannel( other );
+        }
+    };
+
+    Log::ConsoleFormatter f;
+    std::stringstream output;
+
+    Log::Switch sw;
+    const auto reconfiguring = sw.add< Reconfiguring >();
+    const auto other = sw.add< Log::OutputStreamSink >( output, f );
+    std::static_pointer_cast< Reconfiguring >( reconfiguring )->owner = &sw;
+    std::static_pointer_cast< Reconfiguring >( reconfiguring )->other = other;
+
+    Log::Stream s;
+    s.add( Log::Level::ID::INFORMATIONAL, "a" );
+    s.flush( sw );
+    s.add( Log::Level::ID::INFORMATIONAL, "b" );
+    s.flush( sw );
+
+    // the call started with the graph before the reconfiguration
+    EXPECT_EQ( output.str(), "libstdhl::Log: info: a\nlibstdhl::Log: info: b\n" );
+    EXPECT_EQ( sw.channels().size(), 2 );
+}
+
+TEST( libstdhl_cpp_Log, parallel_switch_backpressure_does_not_stall_reclamation )
+{
+    struct Blocking final : public Log::Channel
+    {
+        std::atomic< u1 > released{ false };
+
+        void process( const Log::Stream& ) override
+        {
+            while( not released.load() )
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    const auto blocking = std::make_shared< Blocking >();
+
+    Log::Switch sw;
+    sw.addChannel( blocking );
+    sw.setParallel( true, 1 );
+
+    std::atomic< u1 > submitted( false );
+    std::thread producer( [&]( void ) {
+        Log::Stream s;
+        for( std::size_t batch = 0; batch < 4; batch++ )
+        {
+            s.add( Log::Level::ID::INFORMATIONAL, "batch" );
+            s.flush( sw );
+        }
+        submitted.store( true );
+    } );
+
+    // the producer blocks on the full queue without holding an epoch guard
+    Log::Epoch::synchronize();
+    EXPECT_FALSE( submitted.load() );
+
+    blocking->released.store( true );
+    producer.join();
+    sw.wait();
+}
+
+TEST( libstdhl_cpp_Log, binary_sink_and_reader_roundtrip )
+{
+    const auto src = std::make_shared< Log::Source >( "src", "test source" );
+    const auto cat = std::make_shared< Log::Category >( "cat", "test category" );
+
+    Log::Stream s;
+    s.add( Log::Level::ID::ERROR, src, cat, "A" );
+    s.add( Log::Level::ID::WARNING, "B" );
+    s.data().back().add< Log::LocationItem >( "file.txt", 1, 2, 3, 400 );
+    s.data().back().add< Log::RangeItem >( Log::PositionItem( 5, 6 ), Log::PositionItem( 7, 8 ) );
+    s.add( Log::Level::ID::OUTPUT, src, cat, std::string( 300, 'x' ) );
+
+    Log::StringFormatter f;
+    std::string expected;
+    for( auto& data : s.data() )
+    {
+        data.accept( f, expected );
+        expected += "\n";
+    }
+
+    std::stringstream binary;
+    Log::BinarySink sink( binary );
+    s.flush( sink );
+    s.add( Log::Level::ID::NOTICE, src, cat, "C" );
+    expected += s.data().back().accept( f ) + "\n";
+    s.flush( sink );
+
+    Log::BinaryReader reader( binary );
+    std::stringstream text;
+    Log::OutputStreamSink z( text, f );
+    reader.replay( z, 2 );
+
+    EXPECT_EQ( text.str(), expected );
+}
+
+TEST( libstdhl_cpp_Log, binary_reader_rejects_invalid_input )
+{
+    std::stringstream binary( "LSHX" );
+    Log::BinaryReader reader( binary );
+    Log::Stream s;
+
+    EXPECT_THROW( reader.read( s ), std::domain_error );
+
+    // a text length far beyond the input must not be allocated
+    std::string header( Log::Binary::Magic );
+    header += static_cast< char >( Log::Binary::Version );
+    header += static_cast< char >( Log::Binary::Record::SOURCE );
+    header += '\0';
+    header += std::string( 9, '\xff' ) + '\x01';
+    header += "name";
+
+    std::stringstream truncated( header );
+    Log::BinaryReader truncatedReader( truncated );
+    EXPECT_THROW( truncatedReader.read( s ), std::domain_error );
+}
+
+static std::string readFile( const std::string& filename )
+{
+    std::ifstream file( filename, std::ios::binary );
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+TEST( libstdhl_cpp_Log, file_sink_rotates_by_size )
+{
+    const auto filename = File::Path::temporary() + "/" + TEST_NAME + ".log";
+    std::remove( filename.c_str() );
+    std::remove( ( filename + ".1" ).c_str() );
+    std::remove( ( filename + ".2" ).c_str() );
+
+    Log::ConsoleFormatter f;
+
+    {
+        Log::FileSink sink( filename, f );
+        sink.setMaxSize( 64 );
+        sink.setMaxFiles( 2 );
+        sink.setSync( Log::FileSink::Sync::BATCH );
+
+        Log::Stream s;
+        for( std::size_t index = 0; index < 6; index++ )
+        {
+            // each record is 'libstdhl::Log: info: N\n' (23 bytes)
+            s.add( Log::Level::ID::INFORMATIONAL, std::to_string( index ) );
+        }
+        s.flush( sink );
+
+        EXPECT_EQ( sink.size(), 46 );
+    }
+
+    EXPECT_EQ( readFile( filename ), "libstdhl::Log: info: 4\nlibstdhl::Log: info: 5\n" );
+    EXPECT_EQ( readFile( filename + ".1" ), "libstdhl::Log: info: 2\nlibstdhl::Log: info: 3\n" );
+    EXPECT_EQ( readFile( filename + ".2" ), "libstdhl::Log: info: 0\nlibstdhl::Log: info: 1\n" );
+
+    TEST_FILE_REMOVE( filename );
+    TEST_FILE_REMOVE( filename + ".1" );
+    TEST_FILE_REMOVE( filename + ".2" );
+}
+
+TEST( libstdhl_cpp_Log, file_sink_reports_failed_rotation )
+{
+    const auto filename = File::Path::temporary() + "/" + TEST_NAME + ".log";
+    std::remove( filename.c_str() );
+    File::Path::create( filename + ".1" );
+
+    Log::ConsoleFormatter f;
+
+    {
+        Log::FileSink sink( filename, f );
+        sink.setMaxSize( 32 );
+
+        Log::Stream s;
+        s.add( Log::Level::ID::INFORMATIONAL, "0" );
+        s.add( Log::Level::ID::INFORMATIONAL, "1" );
+        EXPECT_THROW( s.flush( sink ), std::domain_error );
+
+        // the records are kept in the live file and the sink stays usable
+        Log::Stream t;
+        t.add( Log::Level::ID::INFORMATIONAL, "2" );
+        EXPECT_THROW( t.flush( sink ), std::domain_error );
+        EXPECT_EQ( sink.size(), 69 );
+    }
+
+    EXPECT_EQ(
+        readFile( filename ),
+        "libstdhl::Log: info: 0\nlibstdhl::Log: info: 1\nlibstdhl::Log: info: 2\n" );
+
+    File::Path::remove( filename + ".1" );
+    TEST_FILE_REMOVE( filename );
+}
+
+TEST( libstdhl_cpp_Log, file_sink_memory_mapped )
+{
+    const auto filename = File::Path::temporary() + "/" + TEST_NAME + ".log";
+    std::remove( filename.c_str() );
+
+    Log::ConsoleFormatter f;
+    std::string expected;
+
+    {
+        Log::FileSink sink( filename, f );
+        sink.setMemoryMapped( true, 4096 );
+
+        Log::Stream s;
+        for( std::size_t index = 0; index < 512; index++ )
+        {
+            s.add( Log::Level::ID::WARNING, std::to_string( index ) );
+            expected += "libstdhl::Log: warning: " + std::to_string( index ) + "\n";
+        }
+        s.flush( sink );
+
+        EXPECT_EQ( sink.size(), expected.size() );
+    }
+
+    EXPECT_EQ( readFile( filename ), expected );
+
+    TEST_FILE_REMOVE( filename );
+}
+
+TEST( libstdhl_cpp_Log, timestamp_format_with_fraction )
+{
+    const auto point = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast< std::chrono::system_clock::duration >(
+            std::chrono::seconds( 1234567890 ) + std::chrono::microseconds( 123456 ) ) );
+
+    Log::Timestamp a( point );
+    Log::Timestamp b( point + std::chrono::microseconds( 42 ) );
+
+    EXPECT_EQ( a.utc( "%Y-%m-%d %H:%M:%S.%f" ), "2009-02-13 23:31:30.123456" );
+    EXPECT_EQ( b.utc( "%Y-%m-%d %H:%M:%S.%f" ), "2009-02-13 23:31:30.123498" );
+    EXPECT_EQ( b.utc( "%H:%M:%S.%f [%Y]" ), "23:31:30.123498 [2009]" );
+    EXPECT_EQ( b.utc( "%%f %S" ), "%f 30" );
+
+    std::string buffer = "> ";
+    a.utc( buffer, "%S.%f" );
+    EXPECT_EQ( buffer, "> 30.123456" );
+}
+
+TEST( libstdhl_cpp_Log, timestamp_coarse_clock )
+{
+    EXPECT_EQ( Log::Timestamp::clock(), Log::Timestamp::Clock::SYSTEM );
+
+    Log::Timestamp::setClock( Log::Timestamp::Clock::COARSE );
+    const auto coarse = Log::Timestamp();
+    Log::Timestamp::setClock( Log::Timestamp::Clock::SYSTEM );
+
+    const auto delta = Log::Timestamp().timestamp() - coarse.timestamp();
+    EXPECT_LT( std::chrono::duration_cast< std::chrono::seconds >( delta ).count(), 1 );
+}
+
+TEST( libstdhl_cpp_Log, histogram_percentiles )
+{
+    Log::Histogram histogram;
+
+    for( u64 value = 1; value <= 1000; value++ )
+    {
+        histogram.record( value * 1000 );
+    }
+
+    EXPECT_EQ( histogram.count(), 1000 );
+    EXPECT_EQ( histogram.min(), 1000 );
+    EXPECT_EQ( histogram.max(), 1000000 );
+    EXPECT_NEAR( histogram.percentile( 50.0 ), 500000, 500000 * 0.04 );
+    EXPECT_NEAR( histogram.percentile( 99.0 ), 990000, 990000 * 0.04 );
+    EXPECT_NEAR( histogram.percentile( 99.9 ), 999000, 999000 * 0.04 );
+
+    for( std::size_t index = 1; index < Log::Histogram::Buckets; index++ )
+    {
+        EXPECT_EQ( Log::Histogram::index( Log::Histogram::value( index ) ), index );
+    }
+
+    histogram.reset();
+    EXPECT_EQ( histogram.count(), 0 );
+    EXPECT_EQ( histogram.percentile( 50.0 ), 0 );
+}
+
+static void profiledInner( void )
+{
+    LIBSTDHL_PROFILE( "inner" );
+}
+
+static void profiledOuter( void )
+{
+    LIBSTDHL_PROFILE( "outer" );
+    profiledInner();
+    profiledInner();
+}
+
+TEST( libstdhl_cpp_Log, profiler_call_tree )
+{
+    Log::Profiler::reset();
+
+    std::thread thread( [] { profiledOuter(); } );
+    profiledOuter();
+    profiledInner();
+    thread.join();
+
+    auto& root = Log::Profiler::root();
+    auto& outer = *root.child( "outer" );
+    auto& inner = *outer.child( "inner" );
+
+    EXPECT_EQ( &Log::Profiler::current(), &root );
+    EXPECT_EQ( outer.histogram().count(), 2 );
+    EXPECT_EQ( inner.histogram().count(), 4 );
+    EXPECT_EQ( root.child( "inner" )->histogram().count(), 1 );
+    EXPECT_GE( outer.histogram().max(), inner.histogram().min() );
+
+    Log::Stream stream;
+    Log::Profiler::report( stream );
+    ASSERT_EQ( stream.data().size(), 3 );
+    EXPECT_EQ( stream.data()[ 0 ].category(), Log::Profiler::defaultCategory() );
+
+    Log::StringFormatter formatter;
+    const auto text = stream.data()[ 1 ].items()[ 0 ]->accept( formatter );
+    EXPECT_EQ( text.find( "  inner: count=4" ), 0 );
+}
+
+TEST( libstdhl_cpp_Log, profiler_merges_thread_histograms )
+{
+    Log::Profiler::reset();
+
+    for( std::size_t round = 0; round < 3; round++ )
+    {
+        std::vector< std::thread > threads;
+        for( std::size_t thread = 0; thread < 4; thread++ )
+        {
+            threads.emplace_back( [] {
+                for( std::size_t index = 0; index < 100; index++ )
+                {
+                    profiledOuter();
+                }
+            } );
+        }
+
+        for( auto& thread : threads )
+        {
+            thread.join();
+        }
+    }
+
+    auto& outer = *Log::Profiler::root().child( "outer" );
+    auto& inner = *outer.child( "inner" );
+    EXPECT_EQ( outer.histogram().count(), 1200 );
+    EXPECT_EQ( inner.histogram().count(), 2400 );
+
+    Log::Profiler::reset();
+    EXPECT_EQ( outer.histogram().count(), 0 );
+
+    std::thread thread( [] { profiledOuter(); } );
+    thread.join();
+    EXPECT_EQ( outer.histogram().count(), 1 );
+    EXPECT_EQ( inner.histogram().count(), 2 );
+}
+
+TEST( libstdhl_cpp_Log, trace_chrome_events )
+{
+    Log::Trace::start( 64 );
+    Log::Trace::setProcessName( TEST_NAME );
+
+    std::thread thread( [] {
+        Log::Trace::setThreadName( "worker \"1\"" );
+        profiledOuter();
+    } );
+    thread.join();
+
+    {
+        Log::Trace::Scope scope( "main" );
+        profiledInner();
+    }
+
+    Log::Trace::stop();
+    profiledInner();
+
+    std::stringstream stream;
+    Log::Trace::write( stream );
+
+    const auto trace = Json::Object::parse( stream.str() );
+    const auto& events = trace[ "traceEvents" ];
+
+    std::size_t begins = 0;
+    std::size_t ends = 0;
+    std::size_t metadata = 0;
+    for( const auto& event : events )
+    {
+        const auto phase = event[ "ph" ].get< std::string >();
+        begins += phase == "B";
+        ends += phase == "E";
+        metadata += phase == "M";
+    }
+
+    EXPECT_EQ( begins, 5 );
+    EXPECT_EQ( ends, 5 );
+    EXPECT_EQ( metadata, 2 );
+    EXPECT_EQ( events[ 0 ][ "args" ][ "name" ], TEST_NAME );
+    EXPECT_EQ( events[ 1 ][ "args" ][ "name" ], "worker \"1\"" );
+    EXPECT_EQ( events[ 2 ][ "name" ], "outer" );
+    EXPECT_EQ( events.back()[ "name" ], "main" );
+    EXPECT_EQ( Log::Trace::dropped(), 0 );
+}
+
+TEST( libstdhl_cpp_Log, trace_drops_when_full )
+{
+    Log::Trace::start( 4 );
+
+    {
+        Log::Trace::Scope a( "a" );
+        Log::Trace::Scope b( "b" );
+        Log::Trace::Scope c( "c" );
+    }
+
+    Log::Trace::stop();
+
+    std::stringstream stream;
+    Log::Trace::write( stream );
+
+    const auto trace = Json::Object::parse( stream.str() );
+    EXPECT_EQ( trace[ "traceEvents" ].size(), 1 + 4 );
+    EXPECT_EQ( Log::Trace::dropped(), 1 );
+}
+
+TEST( libstdhl_cpp_Log, trace_restart_while_recording )
+{
+    std::atomic< u1 > running( true );
+    Log::Trace::start( 64 );
+
+    std::thread thread( [&] {
+        while( running.load() )
+        {
+            Log::Trace::Scope scope( "busy" );
+        }
+    } );
+
+    for( std::size_t restart = 0; restart < 16; restart++ )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        Log::Trace::start( 64 );
+    }
+
+    Log::Chronograph elapsed( true );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    running.store( false );
+    thread.join();
+    Log::Trace::stop();
+
+    std::stringstream stream;
+    Log::Trace::write( stream );
+
+    // every event of the last session is timed relative to its start
+    const auto limit = elapsed.duration().count() / 1000.0;
+    const auto trace = Json::Object::parse( stream.str() );
+    for( const auto& event : trace[ "traceEvents" ] )
+    {
+        if( event[ "ph" ] != "M" )
+        {
+            EXPECT_LE( std::stod( event[ "ts" ].dump() ), limit + 1.0 );
+        }
+    }
+}
+
+TEST( libstdhl_cpp_Log, limiter_samples_and_rate_limits )
+{
+    const auto hot = std::make_shared< Log::Category >( "Hot", "hot loop" );
+    const auto cold = std::make_shared< Log::Category >( "Cold", "cold path" );
+
+    Log::StringFormatter f;
+    std::stringstream output;
+
+    Log::Limiter limiter;
+    limiter.set< Log::OutputStreamSink >( output, f );
+    limiter.setSampling( hot, 4 );
+    limiter.setRate( hot, 0.001, 5 );
+    limiter.setInterval( std::chrono::milliseconds( 0 ) );
+
+    Log::Stream s;
+    for( std::size_t index = 0; index < 100; index++ )
+    {
+        s.add( Log::Level::ID::WARNING, Log::Source::defaultSource(), hot, "hot" );
+    }
+    s.add( Log::Level::ID::WARNING, Log::Source::defaultSource(), cold, "cold" );
+    s.flush( limiter );
+
+    const auto text = output.str();
+    EXPECT_EQ( std::count( text.begin(), text.end(), '\n' ), 5 + 1 + 1 );
+    EXPECT_NE( text.find( "95 messages suppressed for category 'Hot'" ), std::string::npos );
+    EXPECT_EQ( limiter.suppressed(), 95 );
+
+    output.str( "" );
+    limiter.setSampling( hot, 0 );
+    limiter.setRate( hot, 0 );
+
+    s.add( Log::Level::ID::WARNING, Log::Source::defaultSource(), hot, "hot" );
+    s.flush( limiter );
+    EXPECT_NE( output.str().find( "Hot: warning: hot\n" ), std::string::npos );
+}
+
+TEST( libstdhl_cpp_Log, limiter_handles_any_category_and_keeps_source_tokens )
+{
+    const auto source = std::make_shared< Log::Source >( "Shared", "shared source" );
+    const auto quiet = std::make_shared< Log::Category >( "Quiet", "limited category" );
+
+    // limits must apply independent of how many categories were interned before
+    Log::Category::Ptr late;
+    for( std::size_t index = 0; index < 300; index++ )
+    {
+        late = std::make_shared< Log::Category >( "Late" + std::to_string( index ), "late" );
+    }
+    ASSERT_GE( late->handle(), 256 );
+
+    Log::StringFormatter f;
+    std::stringstream output;
+
+    Log::Limiter limiter;
+    limiter.set< Log::OutputStreamSink >( output, f );
+    limiter.setRate( source, 0.001, 2 );
+    limiter.setRate( quiet, 0.001, 1 );
+    limiter.setRate( late, 0.001, 1 );
+    limiter.setInterval( std::chrono::hours( 1 ) );
+
+    Log::Stream s;
+    s.add( Log::Level::ID::WARNING, source, quiet, "first" );
+    s.add( Log::Level::ID::WARNING, source, quiet, "rejected by category" );
+    s.add( Log::Level::ID::WARNING, source, Log::Category::defaultCategory(), "second" );
+    s.add( Log::Level::ID::WARNING, Log::Source::defaultSource(), late, "late" );
+    s.add( Log::Level::ID::WARNING, Log::Source::defaultSource(), late, "late" );
+    s.flush( limiter );
+
+    const auto text = output.str();
+    EXPECT_NE( text.find( "first" ), std::string::npos );
+    EXPECT_EQ( text.find( "rejected by category" ), std::string::npos );
+    EXPECT_NE( text.find( "second" ), std::string::npos );
+    EXPECT_EQ( std::count( text.begin(), text.end(), '\n' ), 3 );
+    EXPECT_EQ( limiter.suppressed(), 2 );
+}
+
+TEST( libstdhl_cpp_Log, flight_recorder_keeps_last_records )
+{
+    const auto recorder = std::make_shared< Log::FlightRecorder >( 4, 16 );
+
+    Log::Stream s;
+    for( std::size_t index = 0; index < 10; index++ )
+    {
+        s.add( Log::Level::ID::DEBUG, "record " + std::to_string( index ) );
+    }
+    s.add( Log::Level::ID::ERROR, "a very long record which is truncated" );
+    s.data().back().add< Log::LocationItem >( "file.txt", 1, 2, 3, 4 );
+    s.flush( *recorder );
+
+    EXPECT_EQ( recorder->recorded(), 11 );
+
+    Log::Stream dump;
+    recorder->dump( dump );
+    ASSERT_EQ( dump.data().size(), 4 );
+
+    Log::StringFormatter f;
+    EXPECT_EQ( dump.data()[ 0 ].items()[ 0 ]->accept( f ), "record 7" );
+    EXPECT_EQ( dump.data()[ 3 ].items()[ 0 ]->accept( f ), "a very long" );
+    EXPECT_EQ( dump.data()[ 3 ].items().size(), 1 );
+    EXPECT_EQ( dump.data()[ 3 ].level(), Log::Level::ID::ERROR );
+    EXPECT_EQ( dump.data()[ 3 ].source(), Log::Source::defaultSource() );
+
+    auto file = std::tmpfile();
+    ASSERT_NE( file, nullptr );
+    recorder->dump( fileno( file ) );
+    std::rewind( file );
+
+    std::string text;
+    char buffer[ 256 ];
+    std::size_t length;
+    while( ( length = std::fread( buffer, 1, sizeof( buffer ), file ) ) > 0 )
+    {
+        text.append( buffer, length );
+    }
+    std::fclose( file );
+
+    EXPECT_EQ( std::count( text.begin(), text.end(), '\n' ), 4 );
+    EXPECT_NE( text.find( "] libstdhl::Log: Default: debug: record 7\n" ), std::string::npos );
+    EXPECT_NE(
+        text.find( "] libstdhl::Log: Default: error: a very long\n" ), std::string::npos );
+
+    recorder->clear();
+    EXPECT_EQ( recorder->recorded(), 0 );
+}
+
+TEST( libstdhl_cpp_Log, flight_recorder_formats_items_on_dump )
+{
+    const auto recorder = std::make_shared< Log::FlightRecorder >( 8, 128 );
+
+    std::string name = "borrowed";
+    Log::Stream s;
+    s.add( Log::Level::ID::INFORMATIONAL, "at" );
+    s.data().back().add< Log::LocationItem >( "file.txt", 1, 2, 3, 4 );
+    s.data().back().add< Log::FormatItem >(
+        "%s %d %u %x %.1f %c", Log::borrow( name.c_str() ), -7, 42u, 255, 1.5, 'z' );
+    s.flush( *recorder );
+    name = "overwritten";
+
+    Log::Stream dump;
+    recorder->dump( dump );
+    ASSERT_EQ( dump.data().size(), 1 );
+    ASSERT_EQ( dump.data()[ 0 ].items().size(), 3 );
+
+    Log::StringFormatter f;
+    EXPECT_EQ( dump.data()[ 0 ].items()[ 1 ]->accept( f ), "file.txt:1:2..3:4" );
+    EXPECT_EQ( dump.data()[ 0 ].items()[ 2 ]->accept( f ), "borrowed -7 42 ff 1.5 z" );
+
+    auto file = std::tmpfile();
+    ASSERT_NE( file, nullptr );
+    recorder->dump( fileno( file ) );
+    std::rewind( file );
+
+    char buffer[ 256 ] = { 0 };
+    std::fread( buffer, 1, sizeof( buffer ) - 1, file );
+    std::fclose( file );
+
+    EXPECT_NE(
+        std::string( buffer ).find(
+            "info: at, file.txt:1:2..3:4, borrowed -7 42 ff 1.500000 z\n" ),
+        std::string::npos );
+}
+
+TEST( libstdhl_cpp_Log, flight_recorder_names_any_handle )
+{
+    Log::Category::Ptr late;
+    for( std::size_t index = 0; index < 300; index++ )
+    {
+        late = std::make_shared< Log::Category >(
+            "Recorded" + std::to_string( index ), "recorded category" );
+    }
+    ASSERT_GE( late->handle(), 256 );
+
+    const auto source = std::make_shared< Log::Source >( "Recorder", "recorded source" );
+    const auto recorder = std::make_shared< Log::FlightRecorder >( 4, 64 );
+
+    Log::Stream s;
+    s.add( Log::Level::ID::WARNING, source, late, "late" );
+    s.flush( *recorder );
+
+    Log::Stream dump;
+    recorder->dump( dump );
+    ASSERT_EQ( dump.data().size(), 1 );
+    EXPECT_EQ( dump.data()[ 0 ].category(), late );
+    EXPECT_EQ( dump.data()[ 0 ].source(), source );
+
+    auto file = std::tmpfile();
+    ASSERT_NE( file, nullptr );
+    recorder->dump( fileno( file ) );
+    std::rewind( file );
+
+    char buffer[ 256 ] = { 0 };
+    std::fread( buffer, 1, sizeof( buffer ) - 1, file );
+    std::fclose( file );
+
+    EXPECT_NE(
+        std::string( buffer ).find( "] Recorder: Recorded299: warning: late\n" ),
+        std::string::npos );
+}
+
+TEST( libstdhl_cpp_Log, flight_recorder_writers_do_not_share_slots )
+{
+    const auto recorder = std::make_shared< Log::FlightRecorder >( 2, 64 );
+
+    std::vector< std::thread > threads;
+    for( std::size_t thread = 0; thread < 4; thread++ )
+    {
+        threads.emplace_back( [&recorder, thread]() {
+            const auto text = std::string( 48, static_cast< char >( 'a' + thread ) );
+            for( std::size_t index = 0; index < 2000; index++ )
+            {
+                Log::Stream s;
+                s.add( Log::Level::ID::DEBUG, text );
+                s.flush( *recorder );
+            }
+        } );
+    }
+
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ( recorder->recorded(), 8000 );
+
+    Log::Stream dump;
+    recorder->dump( dump );
+    EXPECT_EQ( dump.data().size(), 2 );
+
+    Log::StringFormatter f;
+    for( const auto& data : dump.data() )
+    {
+        const auto text = data.items()[ 0 ]->accept( f );
+        ASSERT_EQ( text.size(), 48 );
+        EXPECT_EQ( std::count( text.begin(), text.end(), text[ 0 ] ), 48 );
+    }
+}
+
+TEST( libstdhl_cpp_Log, flight_recorder_dumps_on_signal )
+{
+    EXPECT_DEATH(
+        {
+            const auto recorder = std::make_shared< Log::FlightRecorder >();
+            Log::FlightRecorder::install( recorder );
+
+            Log::Stream s;
+            s.add( Log::Level::ID::DEBUG, "last words" );
+            s.flush( *recorder );
+
+            std::raise( SIGABRT );
+        },
+        "debug: last words" );
+}
+
+TEST( libstdhl_cpp_Log, router_reconfigures_while_processing )
+{
+    struct Counter final : public Log::Channel
+    {
+        std::atomic< std::size_t > records{ 0 };
+
+        void process( const Log::Stream& stream ) override
+        {
+            records += stream.data().size();
+        }
+    };
+
+    const auto hot = std::make_shared< Log::Category >( "hot", "test hot category" );
+    const auto counter = std::make_shared< Counter >();
+
+    Log::Router router;
+    std::atomic< u1 > running( true );
+
+    std::vector< std::thread > threads;
+    for( std::size_t thread = 0; thread < 4; thread++ )
+    {
+        threads.emplace_back( [&]( void ) {
+            Log::Stream s;
+            while( running )
+            {
+                s.add( Log::Level::ID::DEBUG, Log::Source::defaultSource(), hot, "debug" );
+                s.add( Log::Level::ID::NOTICE, "notice" );
+                s.flush( router );
+            }
+        } );
+    }
+
+    // enable debug routing for one category in the live router
+    for( std::size_t round = 0; round < 16; round++ )
+    {
+        auto filter = std::make_shared< Log::Filter >();
+        filter->setChannel( counter );
+        router.addFilter( filter );
+
+        const auto before = counter->records.load();
+        filter->setCategory( hot );
+        while( counter->records.load() == before )
+        {
+            std::this_thread::yield();
+        }
+
+        router.removeFilter( filter );
+    }
+
+    running = false;
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    EXPECT_TRUE( router.filters().empty() );
+    EXPECT_EQ( Log::Epoch::collect(), 0 );
+
+    const auto records = counter->records.load();
+    Log::Stream s;
+    s.add( Log::Level::ID::DEBUG, Log::Source::defaultSource(), hot, "debug" );
+    s.flush( router );
+    EXPECT_EQ( counter->records.load(), records );
+}
+
 TEST( libstdhl_cpp_log, chronograph )
 {
     Log::Chronograph c;
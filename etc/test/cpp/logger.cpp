@@ -41,6 +41,8 @@
 
 #include <libstdhl/Test>
 
+#include <thread>
+
 using namespace libstdhl;
 using namespace Log;
 using namespace Memory;
@@ -92,6 +94,281 @@ TEST( libstdhl_cpp_logger, location_with_text )
     EXPECT_EQ( log.warnings(), 1 );
 }
 
+TEST( libstdhl_cpp_logger, runtime_threshold_skips_disabled_levels )
+{
+    Stream stream;
+    Logger log( stream );
+
+    log.setThreshold( Level::ID::WARNING );
+    EXPECT_EQ( log.threshold(), Level::ID::WARNING );
+
+    log.error( "error %d", 1 );
+    log.warning( "warning" );
+    log.info( "info %d", 2 );
+    log.hint( "hint" );
+    log.output( "output" );
+
+    u64 evaluated = 0;
+    const auto expensive = [&evaluated]( void ) -> std::string {
+        evaluated++;
+        return "expensive";
+    };
+
+    LIBSTDHL_LOG_INFO( log, expensive() );
+    LIBSTDHL_LOG_WARNING( log, expensive() );
+    log.lazy< Level::ID::NOTICE >( expensive );
+    log.lazy< Level::ID::ERROR >( expensive );
+
+    EXPECT_EQ( evaluated, 2 );
+    EXPECT_FALSE( log.enabled< Level::ID::INFORMATIONAL >() );
+    EXPECT_TRUE( log.enabled< Level::ID::OUTPUT >() );
+
+    ASSERT_EQ( stream.data().size(), 5 );
+    EXPECT_EQ( stream.data()[ 0 ].level(), Level::ID::ERROR );
+    EXPECT_EQ( stream.data()[ 1 ].level(), Level::ID::WARNING );
+    EXPECT_EQ( stream.data()[ 2 ].level(), Level::ID::OUTPUT );
+    EXPECT_EQ( log.errors(), 2 );
+    EXPECT_EQ( log.warnings(), 2 );
+}
+
+TEST( libstdhl_cpp_logger, category_threshold )
+{
+    Stream stream;
+    Logger log( stream );
+
+    const auto quiet = std::make_shared< Category >( "quiet", "test category" );
+    quiet->setThreshold( Level::ID::ERROR );
+
+    log.warning( "visible" );
+    log.setCategory( quiet );
+    log.warning( "suppressed" );
+    log.error( "visible" );
+    log.setCategory( Category::defaultCategory() );
+    log.warning( "visible" );
+
+    EXPECT_EQ( stream.data().size(), 3 );
+}
+
+TEST( libstdhl_cpp_logger, deferred_formatting )
+{
+    Stream stream;
+    Logger log( stream );
+
+    std::string name = "copied";
+    const char* borrowed = "borrowed";
+    char mutable_text[] = "mutable";
+
+    log.deferred< Level::ID::WARNING >(
+        "%s/%s/%s %d %5.2f %x %c %% %*d|%-4u|%zu", name, borrow( borrowed ), mutable_text,
+        -42, 3.14159, 255u, 'z', 3, 7, 9u, std::size_t( 12 ) );
+    name = "changed";
+
+    log.deferred< Level::ID::ERROR >( "missing %d and %q", 1 );
+
+    log.setThreshold( Level::ID::ERROR );
+    log.deferred< Level::ID::INFORMATIONAL >( "skipped %d", 1 );
+
+    ASSERT_EQ( stream.data().size(), 2 );
+    EXPECT_EQ( log.warnings(), 1 );
+    EXPECT_EQ( log.errors(), 1 );
+
+    StringFormatter format;
+    EXPECT_EQ(
+        stream.data()[ 0 ].items()[ 0 ]->accept( format ),
+        "copied/borrowed/mutable -42  3.14 ff z %   7|9   |12" );
+    EXPECT_EQ( stream.data()[ 1 ].items()[ 0 ]->accept( format ), "missing 1 and %q" );
+
+    std::string large( 200, 'x' );
+    FormatItem item( "%s!", large );
+    EXPECT_EQ( item.text(), large + "!" );
+}
+
+TEST( libstdhl_cpp_logger, deferred_formatting_rejects_malformed_arguments )
+{
+    FormatItem item( "%d %s", 42, "text" );
+    const std::vector< u8 > arguments( item.arguments(), item.arguments() + item.size() );
+
+    std::string buffer;
+    FormatItem::text( item.format(), arguments.data(), arguments.size(), buffer );
+    EXPECT_EQ( buffer, "42 text" );
+
+    // every truncation keeps the unresolved specifications verbatim
+    for( std::size_t size = 0; size < arguments.size(); size++ )
+    {
+        buffer.clear();
+        FormatItem::text( item.format(), arguments.data(), size, buffer );
+        EXPECT_EQ( buffer.substr( buffer.size() - 2 ), "%s" );
+    }
+
+    FormatItem::Value value;
+    const u8 unknown[] = { 0xff, 0, 0, 0, 0, 0, 0, 0, 0 };
+    const u8* position = unknown;
+    EXPECT_FALSE( FormatItem::decode( position, unknown + sizeof( unknown ), value ) );
+    EXPECT_EQ( position, unknown + sizeof( unknown ) );
+
+    // a string length beyond the buffer and a missing terminator
+    const u8 overlong[] = { static_cast< u8 >( FormatItem::Argument::STRING ), 0xff, 0xff,
+                            0xff, 0xff, 'a' };
+    position = overlong;
+    EXPECT_FALSE( FormatItem::decode( position, overlong + sizeof( overlong ), value ) );
+    EXPECT_EQ( value.text, nullptr );
+
+    const u8 unterminated[] = { static_cast< u8 >( FormatItem::Argument::STRING ), 1, 0, 0, 0,
+                                'a', 'b' };
+    position = unterminated;
+    EXPECT_FALSE( FormatItem::decode( position, unterminated + sizeof( unterminated ), value ) );
+}
+
+TEST( libstdhl_cpp_logger, metrics_per_level_and_category )
+{
+    auto parser = std::make_shared< Category >( "parser", "test parser category" );
+    auto metrics = std::make_shared< Metrics >( 256 );
+
+    std::vector< std::thread > threads;
+    for( std::size_t thread = 0; thread < 4; thread++ )
+    {
+        threads.emplace_back( [&]( void ) {
+            Stream stream;
+            Logger log( stream );
+            log.setMetrics( metrics );
+            log.setCategory( parser );
+
+            for( std::size_t i = 0; i < 1000; i++ )
+            {
+                log.error( "e" );
+                log.warning( "w" );
+                log.warning( "w" );
+            }
+        } );
+    }
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    Stream stream;
+    Logger log( stream );
+    log.setMetrics( metrics );
+    log.info( "default category" );
+
+    EXPECT_EQ( metrics->count( Level::ID::ERROR ), 4000 );
+    EXPECT_EQ( metrics->count( Level::ID::WARNING, *parser ), 8000 );
+    EXPECT_EQ( metrics->count( Level::ID::WARNING, *Category::defaultCategory() ), 0 );
+    EXPECT_EQ( log.errors(), 4000 );
+    EXPECT_EQ( log.warnings(), 8000 );
+
+    const auto samples = metrics->snapshot();
+    ASSERT_EQ( samples.size(), 3 );
+    EXPECT_EQ( samples[ 0 ].level, Level::ID::ERROR );
+    EXPECT_EQ( samples[ 0 ].category->name(), "parser" );
+    EXPECT_EQ( samples[ 0 ].count, 4000 );
+    EXPECT_EQ( samples[ 1 ].level, Level::ID::WARNING );
+    EXPECT_EQ( samples[ 2 ].level, Level::ID::INFORMATIONAL );
+    EXPECT_EQ( samples[ 2 ].category->name(), "Default" );
+
+    metrics->reset();
+    EXPECT_EQ( log.errors(), 0 );
+    EXPECT_TRUE( metrics->snapshot().empty() );
+}
+
+TEST( libstdhl_cpp_logger, shared_logger_across_threads )
+{
+    class CountingChannel final : public Channel
+    {
+      public:
+        void process( const Stream& stream ) override
+        {
+            records += stream.data().size();
+        }
+
+        std::size_t records = 0;
+    };
+
+    Stream stream;
+    Logger log( stream );
+    CountingChannel channel;
+
+    std::atomic< u1 > done( false );
+    std::thread flusher( [&]( void ) {
+        while( not done.load() )
+        {
+            log.flush( channel );
+        }
+    } );
+
+    std::vector< std::thread > threads;
+    for( std::size_t thread = 0; thread < 4; thread++ )
+    {
+        threads.emplace_back( [&]( void ) {
+            for( std::size_t i = 0; i < 1000; i++ )
+            {
+                log.error( "e" );
+                log.warning( "w" );
+                log.deferred< Level::ID::NOTICE >( "%u", i );
+            }
+        } );
+    }
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+    done.store( true );
+    flusher.join();
+    log.flush( channel );
+
+    EXPECT_EQ( channel.records, 12000 );
+    EXPECT_TRUE( stream.data().empty() );
+    EXPECT_EQ( log.errors(), 4000 );
+    EXPECT_EQ( log.warnings(), 4000 );
+}
+
+TEST( libstdhl_cpp_logger, replaced_metrics_are_released )
+{
+    Stream stream;
+    Logger log( stream );
+
+    std::weak_ptr< Metrics > first = log.metrics();
+    log.error( "e" );
+
+    for( std::size_t i = 0; i < 100; i++ )
+    {
+        log.setMetrics( std::make_shared< Metrics >() );
+    }
+    log.error( "e" );
+
+    Epoch::synchronize();
+    Epoch::collect();
+
+    EXPECT_TRUE( first.expired() );
+    EXPECT_EQ( log.errors(), 1 );
+    EXPECT_EQ( log.metrics()->count( Level::ID::ERROR ), 1 );
+}
+
+TEST( libstdhl_cpp_logger, metrics_grow_beyond_initial_capacity )
+{
+    Metrics metrics( 0 );
+
+    std::vector< Category::Ptr > categories;
+    for( std::size_t index = 0; index < 3 * Metrics::Rows + 1; index++ )
+    {
+        categories.emplace_back(
+            std::make_shared< Category >( "grow" + std::to_string( index ), "test category" ) );
+        metrics.increment( Level::ID::NOTICE, categories.back() );
+    }
+    metrics.increment( Level::ID::NOTICE, categories.front() );
+
+    EXPECT_EQ( metrics.count( Level::ID::NOTICE ), categories.size() + 1 );
+    EXPECT_EQ( metrics.count( Level::ID::NOTICE, *categories.front() ), 2 );
+    EXPECT_EQ( metrics.count( Level::ID::NOTICE, *categories.back() ), 1 );
+
+    const auto samples = metrics.snapshot();
+    ASSERT_EQ( samples.size(), categories.size() );
+    for( const auto& sample : samples )
+    {
+        ASSERT_NE( sample.category, nullptr );
+    }
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -1236,6 +1236,40 @@ TEST( libstdhl_cpp_network_lsp_content, FoldingRangeResult )
     test = FoldingRangeResult( result );
 }
 
+TEST( libstdhl_cpp_network_lsp_content, PublishDiagnosticsParams_copy_and_move )
+{
+    std::vector< Diagnostic > diagnostics;
+    for( std::size_t line = 0; line < 100; line++ )
+    {
+        diagnostics.emplace_back(
+            Range( Position( line, 0 ), Position( line, 4 ) ), message + std::to_string( line ) );
+    }
+
+    const auto copied = PublishDiagnosticsParams( uri, diagnostics );
+    EXPECT_EQ( diagnostics.size(), 100 );
+
+    const auto moved = PublishDiagnosticsParams( uri, std::move( diagnostics ) );
+    EXPECT_EQ( static_cast< const Data& >( copied ), static_cast< const Data& >( moved ) );
+    EXPECT_EQ( moved.diagnostics().size(), 100 );
+    EXPECT_EQ( moved.diagnostics()[ 42 ].range().start().line(), 42 );
+    EXPECT_EQ( moved.diagnostics()[ 42 ].message(), message + "42" );
+
+    auto notification = NotificationMessage( method );
+    notification.setParams( moved );
+    EXPECT_EQ( notification.params(), static_cast< const Data& >( moved ) );
+
+    auto error = ResponseError( ErrorCode::InternalError, message );
+    Data data = Data::object();
+    data[ "key" ] = "value";
+    error.setData( std::move( data ) );
+    EXPECT_EQ( error.data()[ "key" ], "value" );
+
+    auto response = ResponseMessage( id );
+    response.setError( std::move( error ) );
+    EXPECT_EQ( response.error().message(), message );
+    EXPECT_EQ( response.error().data()[ "key" ], "value" );
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -43,6 +43,9 @@
 
 #include <libstdhl/net/lsp/LSP>
 
+#include <chrono>
+#include <thread>
+
 using namespace libstdhl;
 using namespace Network;
 using namespace LSP;
@@ -274,6 +277,426 @@ TEST( libstdhl_cpp_network_lsp, parse_packet_request_initialize_vscode )
     } );
 }
 
+TEST( libstdhl_cpp_network_lsp, framer_pipelined_and_partial_messages )
+{
+    const std::string a = "{\"jsonrpc\":\"2.0\",\"method\":\"exit\"}";
+    const std::string b =
+        "{\"id\":1,\"jsonrpc\":\"2.0\",\"method\":\"shutdown\",\"params\":null}";
+
+    std::string stream = "Content-Length: " + std::to_string( a.size() ) + "\r\n\r\n" + a;
+    stream += "content-length:" + std::to_string( b.size() ) + "\r\n";
+    stream += "Content-Type: application/vscode-jsonrpc; charset=utf-8\r\n\r\n" + b;
+
+    // feed in irregular chunks, including chunks splitting the header separator
+    for( std::size_t chunk : { 1, 3, 7, 64 } )
+    {
+        Framer framer( 16 );
+        std::vector< std::string > payloads;
+
+        for( std::size_t offset = 0; offset < stream.size(); offset += chunk )
+        {
+            framer.feed( stream.data() + offset, std::min( chunk, stream.size() - offset ) );
+
+            Framer::View view;
+            while( framer.next( view ) )
+            {
+                payloads.emplace_back( view.str() );
+            }
+        }
+
+        ASSERT_EQ( payloads.size(), 2 );
+        EXPECT_EQ( payloads[ 0 ], a );
+        EXPECT_EQ( payloads[ 1 ], b );
+        EXPECT_EQ( framer.buffered(), 0 );
+    }
+
+    // pipelined messages in a single chunk yield views into the same buffer
+    Framer framer;
+    framer.feed( stream );
+    Framer::View first;
+    Framer::View second;
+    ASSERT_TRUE( framer.next( first ) );
+    ASSERT_TRUE( framer.next( second ) );
+    EXPECT_FALSE( framer.next( second ) );
+    EXPECT_EQ( first.parse().dump(), Message::parse( a ).dump() );
+    EXPECT_EQ( second.str(), b );
+
+    // a malformed header is skipped and framing resumes with the next message
+    framer.feed( "Content-Length: x\r\n\r\n" + stream );
+    Framer::View view;
+    EXPECT_THROW( framer.next( view ), std::domain_error );
+    ASSERT_TRUE( framer.next( view ) );
+    EXPECT_EQ( view.str(), a );
+    ASSERT_TRUE( framer.next( view ) );
+    EXPECT_EQ( view.str(), b );
+
+    EXPECT_THROW( LSP::Packet::parse( "Content-Length: 1\r\n\r\n" + a ), std::domain_error );
+    EXPECT_EQ(
+        LSP::Packet::parse( "Content-Length: " + std::to_string( a.size() ) + "\r\n\r\n" + a )
+            .payload()
+            .dump(),
+        Message::parse( a ).dump() );
+}
+
+TEST( libstdhl_cpp_network_lsp, parse_large_text_payload )
+{
+    std::string text = "line \"one\"\ttab \\ backslash ä 😀\n";
+    while( text.size() < 64 * 1024 )
+    {
+        text += text;
+    }
+
+    Data document = Data::object();
+    document[ "uri" ] = "file:///large.txt";
+    document[ "languageId" ] = "text";
+    document[ "version" ] = 1;
+    document[ "text" ] = text;
+
+    Data change = Data::object();
+    change[ "text" ] = text;
+
+    Data params = Data::object();
+    params[ "textDocument" ] = document;
+    params[ "contentChanges" ] = Data::array( { Data::object(), change } );
+
+    Data payload = Data::object();
+    payload[ "jsonrpc" ] = "2.0";
+    payload[ "method" ] = "textDocument/didOpen";
+    payload[ "params" ] = params;
+    const auto data = payload.dump();
+
+    const auto message = Message::parse( data );
+    EXPECT_EQ( message.id(), Message::ID::NOTIFICATION_MESSAGE );
+    EXPECT_EQ( message.obj(), payload );
+
+    const auto& notification = static_cast< const NotificationMessage& >( message );
+    const auto item = DidOpenTextDocumentParams( notification.params() ).textDocument();
+    EXPECT_EQ( item.text(), text );
+
+    std::string escaped = "{\"jsonrpc\":\"2.0\",\"method\":\"m\",\"params\":{\"text\":\"";
+    for( std::size_t i = 0; i < 1000; i++ )
+    {
+        escaped += "\\ud83d\\ude00\\u00e4\\n";
+    }
+    escaped += "\"}}";
+    EXPECT_EQ( Message::parse( escaped ).obj(), Data::parse( escaped ) );
+
+    const std::string request = "{\"id\": 42 ,\"method\":\"x\\/y\",\"jsonrpc\":\"2.0\"}";
+    const auto requestMessage = Message::parse( request );
+    EXPECT_EQ( requestMessage.id(), Message::ID::REQUEST_MESSAGE );
+    EXPECT_EQ( requestMessage.obj(), Data::parse( request ) );
+
+    EXPECT_THROW( Message::parse( "{\"jsonrpc\":\"2.0\",\"method\":" ), std::invalid_argument );
+    EXPECT_THROW(
+        Message::parse( "{\"jsonrpc\":\"1.0\",\"method\":\"x\"}" ), std::invalid_argument );
+}
+
+TEST( libstdhl_cpp_network_lsp, dispatcher_methods )
+{
+    TestServer server;
+    auto& dispatcher = server.dispatcher();
+    const auto builtins = dispatcher.size();
+
+    const auto hover = dispatcher.find( std::string( Identifier::textDocument_hover ) );
+    ASSERT_NE( hover, nullptr );
+    EXPECT_TRUE( static_cast< u1 >( hover->request ) );
+    EXPECT_FALSE( static_cast< u1 >( hover->notification ) );
+    EXPECT_EQ( dispatcher.find( "textDocument/hoverX", 18 ), hover );
+    EXPECT_EQ( dispatcher.find( "textDocument/hove", 17 ), nullptr );
+    EXPECT_NE( dispatcher.find( std::string( Identifier::cancelRequest ) ), nullptr );
+
+    std::size_t progress = 0;
+    dispatcher.registerRequest(
+        "custom/echo", []( ServerInterface&, const Data& params ) { return params; } );
+    dispatcher.registerNotification(
+        "$/progress", [&]( ServerInterface&, const Data& ) { progress++; } );
+    EXPECT_EQ( dispatcher.size(), builtins + 2 );
+
+    const std::vector< std::string > messages = {
+        "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"custom/echo\",\"params\":{\"value\":42}}",
+        "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"custom/unknown\"}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"$/progress\",\"params\":{}}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"$/unknown\",\"params\":{}}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"custom/unknown\",\"params\":{}}",
+    };
+    for( const auto& message : messages )
+    {
+        Message::parse( message ).process( server );
+    }
+    EXPECT_EQ( progress, 1 );
+
+    std::vector< ResponseMessage > responses;
+    server.flush( [&]( const Message& message ) {
+        responses.emplace_back( static_cast< const Data& >( message ) );
+    } );
+    ASSERT_EQ( responses.size(), 3 );
+    EXPECT_EQ( responses[ 0 ].result()[ "value" ], 42 );
+    EXPECT_EQ( responses[ 1 ].error().code(), ErrorCode::MethodNotFound );
+    EXPECT_EQ( responses[ 2 ].error().code(), ErrorCode::MethodNotFound );
+
+    dispatcher.registerNotification(
+        Identifier::textDocument_hover, []( ServerInterface&, const Data& ) {} );
+    EXPECT_EQ( dispatcher.find( std::string( Identifier::textDocument_hover ) ), hover );
+    EXPECT_FALSE( static_cast< u1 >( hover->request ) );
+    EXPECT_EQ( dispatcher.size(), builtins + 2 );
+
+    EXPECT_THROW(
+        dispatcher.registerRequest( "", []( ServerInterface&, const Data& ) { return Data(); } ),
+        std::invalid_argument );
+    EXPECT_THROW(
+        {
+            for( std::size_t i = 0; i < Dispatcher::Capacity; i++ )
+            {
+                dispatcher.registerNotification(
+                    "custom/" + std::to_string( i ), []( ServerInterface&, const Data& ) {} );
+            }
+        },
+        std::domain_error );
+}
+
+TEST( libstdhl_cpp_network_lsp, concurrent_requests_and_cancellation )
+{
+    TestServer server;
+    server.setWorkers( 4 );
+    EXPECT_EQ( server.workers(), 4 );
+
+    std::atomic< u1 > started( false );
+    server.dispatcher().registerRequest(
+        "test/slow", [&]( ServerInterface& interface, const Data& ) {
+            started = true;
+            while( not interface.cancelled() )
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            }
+            return Data( "slow" );
+        } );
+    server.dispatcher().registerRequest(
+        "test/fast", []( ServerInterface&, const Data& ) { return Data( "fast" ); } );
+
+    std::mutex lock;
+    std::unordered_map< std::string, std::vector< i64 > > documents;
+    server.dispatcher().registerNotification(
+        "test/append", [&]( ServerInterface&, const Data& params ) {
+            const auto value = params[ "value" ].get< i64 >();
+            std::this_thread::sleep_for( std::chrono::microseconds( value % 3 * 100 ) );
+            std::lock_guard< std::mutex > guard( lock );
+            documents[ params[ "textDocument" ][ "uri" ] ].emplace_back( value );
+        } );
+
+    const auto request = []( const std::string& id, const std::string& method ) {
+        return Message::parse(
+            "{\"jsonrpc\":\"2.0\",\"id\":\"" + id + "\",\"method\":\"" + method + "\"}" );
+    };
+
+    request( "1", "test/slow" ).process( server );
+    request( "2", "test/fast" ).process( server );
+
+    for( i64 value = 0; value < 64; value++ )
+    {
+        Data params = Data::object();
+        params[ "textDocument" ] = { { "uri", value % 2 ? "file:///a" : "file:///b" } };
+        params[ "value" ] = value;
+        NotificationMessage notification( std::string( "test/append" ) );
+        notification.setParams( std::move( params ) );
+        notification.process( server );
+    }
+
+    // the fast request is answered while the slow one is still running
+    std::vector< ResponseMessage > responses;
+    const auto collect = [&]() {
+        server.flush( [&]( const Message& message ) {
+            responses.emplace_back( static_cast< const Data& >( message ) );
+        } );
+    };
+    for( std::size_t retry = 0; retry < 5000 and responses.empty(); retry++ )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        collect();
+    }
+    ASSERT_EQ( responses.size(), 1 );
+    EXPECT_EQ( responses[ 0 ].id(), "2" );
+    EXPECT_EQ( responses[ 0 ].result(), "fast" );
+    EXPECT_TRUE( started );
+
+    Message::parse(
+        "{\"jsonrpc\":\"2.0\",\"method\":\"$/cancelRequest\",\"params\":{\"id\":\"1\"}}" )
+        .process( server );
+    EXPECT_FALSE( server.cancel( "2" ) );
+
+    server.wait();
+    collect();
+    ASSERT_EQ( responses.size(), 2 );
+    EXPECT_EQ( responses[ 1 ].id(), "1" );
+    EXPECT_EQ( responses[ 1 ].error().code(), ErrorCode::RequestCancelled );
+    EXPECT_FALSE( server.cancel( "1" ) );
+
+    ASSERT_EQ( documents.size(), 2 );
+    for( const auto& document : documents )
+    {
+        EXPECT_EQ( document.second.size(), 32 );
+        EXPECT_TRUE( std::is_sorted( document.second.begin(), document.second.end() ) );
+    }
+
+    // requests about a document observe the earlier notifications of the document
+    std::atomic< i64 > edited( 0 );
+    server.dispatcher().registerNotification(
+        "test/edit", [&]( ServerInterface&, const Data& params ) {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            edited = params[ "value" ].get< i64 >();
+        } );
+    server.dispatcher().registerRequest( "test/read", [&]( ServerInterface&, const Data& ) {
+        return Data( edited.load() );
+    } );
+
+    const Data document = { { "uri", "file:///c" } };
+    for( i64 value = 1; value <= 4; value++ )
+    {
+        NotificationMessage edit( std::string( "test/edit" ) );
+        edit.setParams( Data( { { "textDocument", document }, { "value", value } } ) );
+        edit.process( server );
+
+        RequestMessage read( "read" + std::to_string( value ), std::string( "test/read" ) );
+        read.setParams( Data( { { "textDocument", document } } ) );
+        read.process( server );
+    }
+
+    server.wait();
+    responses.clear();
+    collect();
+    ASSERT_EQ( responses.size(), 4 );
+    for( const auto& response : responses )
+    {
+        EXPECT_EQ( "read" + std::to_string( response.result().get< i64 >() ), response.id() );
+    }
+
+    server.setWorkers( 0 );
+    EXPECT_EQ( server.workers(), 0 );
+}
+
+TEST( libstdhl_cpp_network_lsp, coalesced_document_changes )
+{
+    TestServer server;
+    server.setWorkers( 2 );
+    // long enough that only 'wait' and other messages deliver the merged batches
+    server.setDebounce( std::chrono::milliseconds( 60000 ) );
+    EXPECT_EQ( server.debounce(), std::chrono::milliseconds( 60000 ) );
+
+    std::mutex lock;
+    std::vector< std::string > log;
+    std::atomic< u1 > running( false );
+    std::atomic< std::size_t > cancelled( 0 );
+
+    server.dispatcher().registerNotification(
+        Identifier::textDocument_didChange, [&]( ServerInterface& interface, const Data& params ) {
+            const auto changes = DidChangeTextDocumentParams( params ).contentChanges();
+            const auto version = params[ "textDocument" ][ "version" ].get< std::size_t >();
+            {
+                std::lock_guard< std::mutex > guard( lock );
+                log.emplace_back(
+                    "change " + std::to_string( version ) + " " +
+                    std::to_string( changes.size() ) + " " + changes[ 0 ].text() );
+            }
+
+            if( version == 100 )
+            {
+                // stale analysis, stopped by the next change
+                running = true;
+                for( std::size_t i = 0; i < 5000 and not interface.cancelled(); i++ )
+                {
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+                }
+                cancelled += interface.cancelled();
+            }
+        } );
+    server.dispatcher().registerNotification(
+        Identifier::textDocument_didSave, [&]( ServerInterface&, const Data& ) {
+            std::lock_guard< std::mutex > guard( lock );
+            log.emplace_back( "save" );
+        } );
+
+    const auto change = [&]( const std::size_t version, const std::string& text, u1 full ) {
+        Data event = Data::object();
+        event[ "text" ] = text;
+        if( not full )
+        {
+            event[ "range" ] =
+                static_cast< const Data& >( Range( Position( 0, 0 ), Position( 0, 0 ) ) );
+        }
+
+        Data params = Data::object();
+        params[ "textDocument" ] = { { "uri", "file:///a" }, { "version", version } };
+        params[ "contentChanges" ] = Data::array( { event } );
+
+        NotificationMessage notification( std::string( Identifier::textDocument_didChange ) );
+        notification.setParams( std::move( params ) );
+        notification.process( server );
+    };
+
+    const auto entries = [&]() {
+        std::lock_guard< std::mutex > guard( lock );
+        return log;
+    };
+
+    // consecutive changes are merged, a full text change supersedes the previous ones
+    for( std::size_t version = 1; version <= 10; version++ )
+    {
+        change( version, std::to_string( version ), version == 5 );
+    }
+    server.wait();
+    EXPECT_EQ( entries(), std::vector< std::string >( { "change 10 6 5" } ) );
+
+    // pending changes are delivered before other messages about the document
+    change( 11, "x", false );
+    Data save = Data::object();
+    save[ "textDocument" ] = { { "uri", "file:///a" } };
+    NotificationMessage notification( std::string( Identifier::textDocument_didSave ) );
+    notification.setParams( std::move( save ) );
+    notification.process( server );
+    server.wait();
+    EXPECT_EQ(
+        entries(), std::vector< std::string >( { "change 10 6 5", "change 11 1 x", "save" } ) );
+
+    // requests about the document observe the pending changes
+    server.dispatcher().registerRequest( "test/log", [&]( ServerInterface&, const Data& ) {
+        return Data( entries().back() );
+    } );
+    change( 12, "v", false );
+    RequestMessage request( "log", std::string( "test/log" ) );
+    request.setParams( Data( { { "textDocument", { { "uri", "file:///a" } } } } ) );
+    request.process( server );
+    server.wait();
+    std::vector< ResponseMessage > responses;
+    server.flush( [&]( const Message& message ) {
+        responses.emplace_back( static_cast< const Data& >( message ) );
+    } );
+    ASSERT_EQ( responses.size(), 1 );
+    EXPECT_EQ( responses[ 0 ].result(), "change 12 1 v" );
+
+    // the quiet period delivers the batch without an explicit flush
+    server.setDebounce( std::chrono::milliseconds( 20 ) );
+    change( 13, "y", true );
+    for( std::size_t retry = 0; retry < 5000 and entries().size() < 5; retry++ )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    ASSERT_EQ( entries().size(), 5 );
+    EXPECT_EQ( entries().back(), "change 13 1 y" );
+
+    // a newer version cancels the running analysis of the previous batch
+    change( 100, "z", true );
+    for( std::size_t retry = 0; retry < 5000 and not running; retry++ )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    ASSERT_TRUE( running );
+    change( 101, "w", true );
+    server.wait();
+    EXPECT_EQ( cancelled, 1 );
+    EXPECT_EQ( entries().back(), "change 101 1 w" );
+
+    server.setWorkers( 0 );
+}
+
 TEST( libstdhl_cpp_network_lsp, window_showMessage )
 {
     TestServer server;
@@ -323,6 +746,85 @@ TEST( libstdhl_cpp_network_lsp, window_logMessage )
     } );
 }
 
+TEST( libstdhl_cpp_network_lsp, window_logMessage_from_log_sink )
+{
+    TestServer server;
+    Log::StringFormatter formatter;
+
+    {
+        LogSink sink( server, formatter );
+        sink.setWindow( std::chrono::milliseconds( 10 ) );
+
+        Log::Stream stream;
+        stream.add( Log::Level::ID::ERROR, "first error" );
+        stream.add( Log::Level::ID::CRITICAL, "second error" );
+        stream.add( Log::Level::ID::WARNING, "a warning" );
+        stream.add( Log::Level::ID::ERROR, "third error" );
+        stream.add( Log::Level::ID::DEBUG, "some details" );
+        stream.flush( sink );
+
+        sink.flush();
+        EXPECT_EQ( server.notifications(), 4 );
+
+        stream.add( Log::Level::ID::NOTICE, "pending until destruction" );
+        stream.flush( sink );
+    }
+
+    EXPECT_EQ( server.notifications(), 5 );
+
+    std::vector< ShowMessageParams > messages;
+    server.flush( [&]( const Message& message ) {
+        const NotificationMessage notification( message.obj() );
+        EXPECT_STREQ( notification.method().c_str(), Identifier::window_logMessage );
+        messages.emplace_back( notification.params() );
+    } );
+
+    // consecutive records of one type are coalesced, the arrival order is kept
+    ASSERT_EQ( messages.size(), 5 );
+    EXPECT_EQ( messages[ 0 ].messageType(), MessageType::Error );
+    EXPECT_NE( messages[ 0 ].message().find( "first error\n" ), std::string::npos );
+    EXPECT_NE( messages[ 0 ].message().find( "second error" ), std::string::npos );
+    EXPECT_EQ( messages[ 1 ].messageType(), MessageType::Warning );
+    EXPECT_EQ( messages[ 2 ].messageType(), MessageType::Error );
+    EXPECT_NE( messages[ 2 ].message().find( "third error" ), std::string::npos );
+    EXPECT_EQ( messages[ 3 ].messageType(), MessageType::Log );
+    EXPECT_EQ( messages[ 4 ].messageType(), MessageType::Info );
+}
+
+TEST( libstdhl_cpp_network_lsp, window_logMessage_from_log_sink_drops_at_capacity )
+{
+    TestServer server;
+    Log::StringFormatter formatter;
+
+    LogSink sink( server, formatter );
+    sink.setCapacity( 64 );
+    sink.setNotifications( 0 );
+
+    // the client never catches up, logging on the flushing thread must not block
+    Log::Stream stream;
+    for( std::size_t i = 0; i < 100; i++ )
+    {
+        stream.add( Log::Level::ID::ERROR, "error " + std::to_string( i ) );
+    }
+    stream.flush( sink );
+    EXPECT_GT( sink.dropped(), 0 );
+    EXPECT_LT( sink.dropped(), 100 );
+
+    sink.flush();
+
+    std::vector< ShowMessageParams > messages;
+    server.flush( [&]( const Message& message ) {
+        messages.emplace_back( NotificationMessage( message.obj() ).params() );
+    } );
+
+    ASSERT_EQ( messages.size(), 2 );
+    EXPECT_EQ( messages[ 0 ].messageType(), MessageType::Error );
+    EXPECT_EQ( messages[ 1 ].messageType(), MessageType::Warning );
+    EXPECT_EQ(
+        messages[ 1 ].message(),
+        std::to_string( sink.dropped() ) + " log records dropped, capacity of 64 bytes reached" );
+}
+
 TEST( libstdhl_cpp_network_lsp, telemetry_event )
 {
     TestServer server;
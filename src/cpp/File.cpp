@@ -41,6 +41,13 @@
 
 #include "File.h"
 
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
 #if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
 #include <direct.h>
 #else
@@ -170,6 +177,250 @@ std::fstream& File::gotoLine( std::fstream& file, const std::size_t lineNumber )
     return file;
 }
 
+#if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
+using CacheStatus = struct _stat;
+#define CACHE_GET_STATUS( PATH, STATUS ) _stat( PATH.c_str(), STATUS )
+#define CACHE_NANOSECONDS( STATUS ) 0
+#elif defined( __APPLE__ )
+using CacheStatus = struct stat;
+#define CACHE_GET_STATUS( PATH, STATUS ) stat( PATH.c_str(), STATUS )
+#define CACHE_NANOSECONDS( STATUS ) ( STATUS ).st_mtimespec.tv_nsec
+#else
+using CacheStatus = struct stat;
+#define CACHE_GET_STATUS( PATH, STATUS ) stat( PATH.c_str(), STATUS )
+#define CACHE_NANOSECONDS( STATUS ) ( STATUS ).st_mtim.tv_nsec
+#endif
+
+namespace
+{
+    /**
+       identity and version of a file, a file replaced by a rename gets a new inode and
+       an in-place modification a new nanosecond modification time
+    */
+    struct CacheStamp
+    {
+        CacheStamp( const CacheStatus& status )
+        : seconds( status.st_mtime )
+        , nanoseconds( CACHE_NANOSECONDS( status ) )
+        , device( status.st_dev )
+        , inode( status.st_ino )
+        , size( status.st_size )
+        {
+        }
+
+        u1 operator==( const CacheStamp& rhs ) const
+        {
+            return seconds == rhs.seconds and nanoseconds == rhs.nanoseconds and
+                   device == rhs.device and inode == rhs.inode and size == rhs.size;
+        }
+
+        i64 seconds;
+        i64 nanoseconds;
+        u64 device;
+        u64 inode;
+        i64 size;
+    };
+
+    /**
+       the content is read into memory once, a mapping of the file would fault on access
+       once another process truncates it
+    */
+    class CacheEntry
+    {
+      public:
+        CacheEntry( const std::string& filename, const CacheStatus& status )
+        : stamp( status )
+        , m_data()
+        , m_lines()
+        {
+            std::stringstream stream;
+            stream << File::open( filename, std::ios::in | std::ios::binary ).rdbuf();
+            m_data = stream.str();
+
+            m_lines.emplace_back( 0 );
+            for( std::size_t position = 0; position < m_data.size(); position++ )
+            {
+                if( m_data[ position ] == '\n' and position + 1 < m_data.size() )
+                {
+                    m_lines.emplace_back( position + 1 );
+                }
+            }
+        }
+
+        CacheEntry( const CacheEntry& ) = delete;
+
+        CacheEntry& operator=( const CacheEntry& ) = delete;
+
+        std::size_t lines( void ) const
+        {
+            return m_data.empty() ? 0 : m_lines.size();
+        }
+
+        std::string line( const std::size_t index ) const
+        {
+            const auto begin = m_lines[ index ];
+            auto end = index + 1 < m_lines.size() ? m_lines[ index + 1 ] - 1 : m_data.size();
+
+            if( end > begin and m_data[ end - 1 ] == '\n' )
+            {
+                // last line with a trailing newline
+                end--;
+            }
+
+            return m_data.substr( begin, end - begin );
+        }
+
+        std::size_t size( void ) const
+        {
+            return m_data.size() + m_lines.size() * sizeof( std::size_t );
+        }
+
+        const CacheStamp stamp;
+
+      private:
+        std::string m_data;
+
+        std::vector< std::size_t > m_lines;
+    };
+
+    /**
+       cached files in least recently used order, bounded by 'capacity' bytes
+    */
+    struct CacheTable
+    {
+        using Entry = std::shared_ptr< const CacheEntry >;
+
+        using Order = std::list< std::string >;
+
+        std::unordered_map< std::string, std::pair< Entry, Order::iterator > > entries;
+
+        Order order;
+
+        std::size_t size = 0;
+
+        std::size_t capacity = 64 * 1024 * 1024;
+
+        void erase( const std::string& filename )
+        {
+            const auto result = entries.find( filename );
+            if( result != entries.end() )
+            {
+                size -= result->second.first->size();
+                order.erase( result->second.second );
+                entries.erase( result );
+            }
+        }
+
+        void shrink( void )
+        {
+            // the most recently used file stays cached even if it exceeds the capacity
+            while( size > capacity and order.size() > 1 )
+            {
+                erase( order.back() );
+            }
+        }
+    };
+}
+
+static std::mutex cacheMutex;
+
+static CacheTable& cache( void )
+{
+    static CacheTable cache;
+    return cache;
+}
+
+static std::shared_ptr< const CacheEntry > cacheEntry( const std::string& filename )
+{
+    CacheStatus status;
+    if( CACHE_GET_STATUS( filename, &status ) != 0 )
+    {
+        throw std::invalid_argument( "filename '" + filename + "' does not exist" );
+    }
+
+    const CacheStamp stamp( status );
+    {
+        std::lock_guard< std::mutex > guard( cacheMutex );
+        auto& cache = ::cache();
+        const auto result = cache.entries.find( filename );
+
+        if( result != cache.entries.end() and result->second.first->stamp == stamp )
+        {
+            cache.order.splice( cache.order.begin(), cache.order, result->second.second );
+            return result->second.first;
+        }
+    }
+
+    // load outside of the lock, concurrent loads of the same file are harmless
+    const auto entry = std::make_shared< const CacheEntry >( filename, status );
+
+    std::lock_guard< std::mutex > guard( cacheMutex );
+    auto& cache = ::cache();
+    cache.erase( filename );
+    cache.order.emplace_front( filename );
+    cache.entries.emplace( filename, std::make_pair( entry, cache.order.begin() ) );
+    cache.size += entry->size();
+    cache.shrink();
+    return entry;
+}
+
+std::string File::Cache::readLine( const std::string& filename, const u32 num )
+{
+    const auto entry = cacheEntry( filename );
+
+    if( num == 0 or num > entry->lines() )
+    {
+        throw FileNumberOutOfRangeException(
+            "unable to read a line from file '" + filename +
+            "', because the file does not contain a line at '" + std::to_string( num ) + "'" );
+    }
+
+    return entry->line( num - 1 );
+}
+
+std::size_t File::Cache::lines( const std::string& filename )
+{
+    return cacheEntry( filename )->lines();
+}
+
+void File::Cache::remove( const std::string& filename )
+{
+    std::lock_guard< std::mutex > guard( cacheMutex );
+    cache().erase( filename );
+}
+
+void File::Cache::clear( void )
+{
+    std::lock_guard< std::mutex > guard( cacheMutex );
+    auto& cache = ::cache();
+    cache.entries.clear();
+    cache.order.clear();
+    cache.size = 0;
+}
+
+void File::Cache::setCapacity( const std::size_t capacity )
+{
+    std::lock_guard< std::mutex > guard( cacheMutex );
+    auto& cache = ::cache();
+    cache.capacity = capacity;
+    cache.shrink();
+}
+
+std::size_t File::Cache::capacity( void )
+{
+    std::lock_guard< std::mutex > guard( cacheMutex );
+    return cache().capacity;
+}
+
+std::size_t File::Cache::size( void )
+{
+    std::lock_guard< std::mutex > guard( cacheMutex );
+    return cache().size;
+}
+
+#undef CACHE_GET_STATUS
+#undef CACHE_NANOSECONDS
+
 #if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
 #define PATH_CREATE( PATH ) _mkdir( PATH.c_str() )
 #else
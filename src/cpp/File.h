@@ -91,6 +91,31 @@ namespace libstdhl
 
         std::fstream& gotoLine( std::fstream& file, const std::size_t num );
 
+        /**
+           process-wide cache of file contents with a line offset index, so reading a line
+           is O(1); a cached file is reloaded when its inode, size or nanosecond modification
+           time changed, least recently used files are evicted beyond 'capacity' bytes
+        */
+        namespace Cache
+        {
+            std::string readLine( const std::string& filename, const u32 num );
+
+            std::size_t lines( const std::string& filename );
+
+            void remove( const std::string& filename );
+
+            void clear( void );
+
+            void setCapacity( const std::size_t capacity );
+
+            std::size_t capacity( void );
+
+            /**
+               bytes held by the cached files
+            */
+            std::size_t size( void );
+        }
+
         namespace Path
         {
             void create( const std::string& path );
@@ -41,6 +41,20 @@
 
 #include "Json.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if( defined( __x86_64__ ) or defined( __i386__ ) ) and defined( __GNUC__ )
+#define LIBSTDHL_JSON_AVX2
+#include <immintrin.h>
+#endif
+
 using namespace libstdhl;
 
 u1 Json::hasProperty( const Object& object, const std::string& field )
@@ -183,13 +197,1118 @@ void Json::validatePropertyIsArrayOfString(
     validatePropertyIsArray( context, object, field, required );
     if( hasProperty( object, field ) )
     {
-        for( auto element : object[ field ] )
+        for( const auto& element : object[ field ] )
         {
             validateTypeIsString( context, element );
         }
     }
 }
 
+//
+// Json::Document
+//
+
+namespace
+{
+    static constexpr std::size_t MaxDepth = 1024;
+
+    static constexpr u64 PayloadMask = ( 1ull << 56 ) - 1;
+
+    struct Masks
+    {
+        u64 quote;
+
+        u64 backslash;
+
+        u64 structural;
+    };
+
+    static void classifyScalar( const u8* block, Masks& masks )
+    {
+        masks = Masks{ 0, 0, 0 };
+        for( std::size_t i = 0; i < 64; i++ )
+        {
+            const u64 bit = 1ull << i;
+            switch( block[ i ] )
+            {
+                case '"':
+                {
+                    masks.quote |= bit;
+                    break;
+                }
+                case '\\':
+                {
+                    masks.backslash |= bit;
+                    break;
+                }
+                case '{':  // [[fallthrough]]
+                case '}':  // [[fallthrough]]
+                case '[':  // [[fallthrough]]
+                case ']':  // [[fallthrough]]
+                case ':':  // [[fallthrough]]
+                case ',':
+                {
+                    masks.structural |= bit;
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+#ifdef LIBSTDHL_JSON_AVX2
+    __attribute__( ( target( "avx2" ) ) ) static u64 equals(
+        const __m256i low, const __m256i high, const char character )
+    {
+        const auto pattern = _mm256_set1_epi8( character );
+        const u64 l = static_cast< u32 >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( low, pattern ) ) );
+        const u64 h =
+            static_cast< u32 >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( high, pattern ) ) );
+        return l | ( h << 32 );
+    }
+
+    __attribute__( ( target( "avx2" ) ) ) static void classifyAvx2(
+        const u8* block, Masks& masks )
+    {
+        const auto low = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( block ) );
+        const auto high = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( block + 32 ) );
+
+        masks.quote = equals( low, high, '"' );
+        masks.backslash = equals( low, high, '\\' );
+        masks.structural = equals( low, high, '{' ) | equals( low, high, '}' ) |
+                           equals( low, high, '[' ) | equals( low, high, ']' ) |
+                           equals( low, high, ':' ) | equals( low, high, ',' );
+    }
+#endif
+
+    using Classify = void ( * )( const u8* block, Masks& masks );
+
+    static u1 supported( void )
+    {
+#ifdef LIBSTDHL_JSON_AVX2
+        static const u1 avx2 = __builtin_cpu_supports( "avx2" );
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    static std::atomic< Classify >& selected( void )
+    {
+#ifdef LIBSTDHL_JSON_AVX2
+        static std::atomic< Classify > current( supported() ? &classifyAvx2 : &classifyScalar );
+#else
+        static std::atomic< Classify > current( &classifyScalar );
+#endif
+        return current;
+    }
+
+    static Classify classifier( void )
+    {
+        return selected().load( std::memory_order_relaxed );
+    }
+
+    static u64 prefixXor( u64 bits )
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /**
+       stage 1, records the positions of all unescaped quotes and of all structural
+       characters outside of strings
+    */
+    static u1 index( const char* data, const std::size_t size, std::vector< u32 >& positions )
+    {
+        const auto classify = classifier();
+
+        u64 escapedCarry = 0;
+        u64 stringCarry = 0;
+        u8 padded[ 64 ];
+
+        for( std::size_t offset = 0; offset < size; offset += 64 )
+        {
+            auto block = reinterpret_cast< const u8* >( data + offset );
+            if( size - offset < 64 )
+            {
+                std::memset( padded, ' ', sizeof( padded ) );
+                std::memcpy( padded, block, size - offset );
+                block = padded;
+            }
+
+            Masks masks;
+            classify( block, masks );
+
+            // a backslash escapes the next character unless it is escaped itself
+            u64 escaped = escapedCarry;
+            escapedCarry = 0;
+            u64 backslash = masks.backslash & ~escaped;
+            while( backslash )
+            {
+                const u64 bit = backslash & ( ~backslash + 1 );
+                backslash &= ~bit;
+                if( bit == ( 1ull << 63 ) )
+                {
+                    escapedCarry = 1;
+                }
+                else
+                {
+                    escaped |= bit << 1;
+                    backslash &= ~( bit << 1 );
+                }
+            }
+
+            const u64 quotes = masks.quote & ~escaped;
+            const u64 strings = prefixXor( quotes ) ^ stringCarry;
+            stringCarry = static_cast< u64 >( static_cast< i64 >( strings ) >> 63 );
+
+            u64 structural = ( masks.structural & ~strings ) | quotes;
+            while( structural )
+            {
+                positions.push_back(
+                    static_cast< u32 >( offset + __builtin_ctzll( structural ) ) );
+                structural &= structural - 1;
+            }
+        }
+
+        return stringCarry == 0 and escapedCarry == 0;
+    }
+
+    static inline u1 whitespace( const char c )
+    {
+        return c == ' ' or c == '\n' or c == '\r' or c == '\t';
+    }
+
+    /**
+       rejects control characters and malformed UTF-8 sequences (RFC 3629) inside
+       string literals like the lexer of the JSON library does
+    */
+    static u1 characters( const char* begin, const char* end, u1& escaped )
+    {
+        auto c = reinterpret_cast< const u8* >( begin );
+        const auto last = reinterpret_cast< const u8* >( end );
+        while( c < last )
+        {
+            const auto lead = *c++;
+            if( lead < 0x80 )
+            {
+                if( lead < 0x20 )
+                {
+                    return false;
+                }
+                escaped |= ( lead == '\\' );
+                continue;
+            }
+
+            std::size_t length = 0;
+            u8 low = 0x80;
+            u8 high = 0xbf;
+            if( lead >= 0xc2 and lead <= 0xdf )
+            {
+                length = 1;
+            }
+            else if( lead >= 0xe0 and lead <= 0xef )
+            {
+                length = 2;
+                low = ( lead == 0xe0 ) ? 0xa0 : 0x80;
+                high = ( lead == 0xed ) ? 0x9f : 0xbf;
+            }
+            else if( lead >= 0xf0 and lead <= 0xf4 )
+            {
+                length = 3;
+                low = ( lead == 0xf0 ) ? 0x90 : 0x80;
+                high = ( lead == 0xf4 ) ? 0x8f : 0xbf;
+            }
+            else
+            {
+                return false;
+            }
+
+            if( static_cast< std::size_t >( last - c ) < length or *c < low or *c > high )
+            {
+                return false;
+            }
+            c++;
+            for( std::size_t i = 1; i < length; i++, c++ )
+            {
+                if( *c < 0x80 or *c > 0xbf )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+       stage 2, records the values on the tape, every entry holds its type in the top
+       byte, containers point to their matching end and strings to their offset
+    */
+    class Builder
+    {
+      public:
+        Builder(
+            const char* data,
+            const std::size_t size,
+            const std::vector< u32 >& index,
+            std::vector< u64 >& tape,
+            std::string& strings )
+        : m_data( data )
+        , m_size( size )
+        , m_index( index )
+        , m_next( 0 )
+        , m_tape( tape )
+        , m_strings( strings )
+        {
+        }
+
+        u1 build( void )
+        {
+            std::size_t end = 0;
+            if( not value( 0, skip( 0 ), end ) )
+            {
+                return false;
+            }
+            return m_next == m_index.size() and blank( end, m_size );
+        }
+
+      private:
+        std::size_t skip( std::size_t position ) const
+        {
+            while( position < m_size and whitespace( m_data[ position ] ) )
+            {
+                position++;
+            }
+            return position;
+        }
+
+        u1 blank( std::size_t from, const std::size_t to ) const
+        {
+            for( ; from < to; from++ )
+            {
+                if( not whitespace( m_data[ from ] ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        u1 current( const char c ) const
+        {
+            return m_next < m_index.size() and m_data[ m_index[ m_next ] ] == c;
+        }
+
+        void push( const char type, const u64 payload = 0 )
+        {
+            m_tape.push_back( ( static_cast< u64 >( type ) << 56 ) | payload );
+        }
+
+        u1 value( const std::size_t depth, const std::size_t position, std::size_t& end )
+        {
+            if( position >= m_size or depth > MaxDepth )
+            {
+                return false;
+            }
+
+            if( m_next < m_index.size() and m_index[ m_next ] == position )
+            {
+                switch( m_data[ position ] )
+                {
+                    case '"':
+                    {
+                        return string( end );
+                    }
+                    case '{':
+                    {
+                        return container( depth, '{', '}', end );
+                    }
+                    case '[':
+                    {
+                        return container( depth, '[', ']', end );
+                    }
+                    default:
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            const auto limit = m_next < m_index.size() ? m_index[ m_next ] : m_size;
+            end = position;
+            while( end < limit and not whitespace( m_data[ end ] ) )
+            {
+                end++;
+            }
+            return scalar( m_data + position, m_data + end );
+        }
+
+        u1 string( std::size_t& end )
+        {
+            if( m_next + 1 >= m_index.size() )
+            {
+                return false;
+            }
+
+            const auto begin = m_data + m_index[ m_next ] + 1;
+            const auto close = m_data + m_index[ m_next + 1 ];
+            m_next += 2;
+            end = close - m_data + 1;
+
+            const auto offset = m_strings.size();
+            m_strings.append( sizeof( u32 ), '\0' );
+
+            u1 escaped = false;
+            if( not characters( begin, close, escaped ) )
+            {
+                return false;
+            }
+
+            if( escaped )
+            {
+                std::string value;
+                if( not Json::unescape( begin, close, value ) )
+                {
+                    return false;
+                }
+                m_strings += value;
+            }
+            else
+            {
+                m_strings.append( begin, close );
+            }
+
+            const u32 length = static_cast< u32 >( m_strings.size() - offset - sizeof( u32 ) );
+            std::memcpy( &m_strings[ offset ], &length, sizeof( u32 ) );
+            push( '"', offset );
+            return true;
+        }
+
+        u1 container(
+            const std::size_t depth, const char open, const char close, std::size_t& end )
+        {
+            const u1 object = ( open == '{' );
+            const auto start = m_tape.size();
+            push( open );
+
+            std::size_t position = m_index[ m_next ] + 1;
+            m_next++;
+
+            if( current( close ) )
+            {
+                if( not blank( position, m_index[ m_next ] ) )
+                {
+                    return false;
+                }
+                position = m_index[ m_next ] + 1;
+                m_next++;
+            }
+            else
+            {
+                while( true )
+                {
+                    if( object )
+                    {
+                        std::size_t key = 0;
+                        if( not current( '"' ) or not blank( position, m_index[ m_next ] ) or
+                            not string( key ) )
+                        {
+                            return false;
+                        }
+                        if( not current( ':' ) or not blank( key, m_index[ m_next ] ) )
+                        {
+                            return false;
+                        }
+                        position = m_index[ m_next ] + 1;
+                        m_next++;
+                    }
+
+                    std::size_t after = 0;
+                    if( not value( depth + 1, skip( position ), after ) )
+                    {
+                        return false;
+                    }
+
+                    if( m_next >= m_index.size() or not blank( after, m_index[ m_next ] ) )
+                    {
+                        return false;
+                    }
+
+                    const auto separator = m_data[ m_index[ m_next ] ];
+                    position = m_index[ m_next ] + 1;
+                    m_next++;
+
+                    if( separator == close )
+                    {
+                        break;
+                    }
+                    if( separator != ',' )
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            m_tape[ start ] |= m_tape.size() + 1;
+            push( close, start );
+            end = position;
+            return true;
+        }
+
+        u1 scalar( const char* begin, const char* end )
+        {
+            const auto size = static_cast< std::size_t >( end - begin );
+            if( size == 4 and std::memcmp( begin, "true", 4 ) == 0 )
+            {
+                push( 't' );
+                return true;
+            }
+            if( size == 5 and std::memcmp( begin, "false", 5 ) == 0 )
+            {
+                push( 'f' );
+                return true;
+            }
+            if( size == 4 and std::memcmp( begin, "null", 4 ) == 0 )
+            {
+                push( 'n' );
+                return true;
+            }
+            return number( begin, end );
+        }
+
+        u1 number( const char* begin, const char* end )
+        {
+            auto c = begin;
+            const u1 negative = ( c < end and *c == '-' );
+            c += negative;
+
+            if( c == end or not std::isdigit( static_cast< u8 >( *c ) ) )
+            {
+                return false;
+            }
+
+            u64 magnitude = 0;
+            u1 overflow = false;
+            if( *c == '0' )
+            {
+                c++;
+            }
+            else
+            {
+                for( ; c < end and std::isdigit( static_cast< u8 >( *c ) ); c++ )
+                {
+                    const u64 digit = *c - '0';
+                    overflow |= magnitude > ( ~0ull - digit ) / 10;
+                    magnitude = magnitude * 10 + digit;
+                }
+            }
+
+            u1 integral = true;
+            if( c < end and *c == '.' )
+            {
+                integral = false;
+                c++;
+                const auto digits = c;
+                while( c < end and std::isdigit( static_cast< u8 >( *c ) ) )
+                {
+                    c++;
+                }
+                if( c == digits )
+                {
+                    return false;
+                }
+            }
+            if( c < end and ( *c == 'e' or *c == 'E' ) )
+            {
+                integral = false;
+                c++;
+                if( c < end and ( *c == '+' or *c == '-' ) )
+                {
+                    c++;
+                }
+                const auto digits = c;
+                while( c < end and std::isdigit( static_cast< u8 >( *c ) ) )
+                {
+                    c++;
+                }
+                if( c == digits )
+                {
+                    return false;
+                }
+            }
+            if( c != end )
+            {
+                return false;
+            }
+
+            if( integral and not overflow )
+            {
+                if( not negative )
+                {
+                    push( 'u' );
+                    m_tape.push_back( magnitude );
+                    return true;
+                }
+                if( magnitude <= ( 1ull << 63 ) )
+                {
+                    push( 'l' );
+                    m_tape.push_back( ~magnitude + 1 );
+                    return true;
+                }
+            }
+
+            // same conversion as the JSON library, which honors the locale decimal point
+            std::string text( begin, end );
+            const auto locale = std::localeconv();
+            if( locale and locale->decimal_point and locale->decimal_point[ 0 ] != '.' )
+            {
+                std::replace( text.begin(), text.end(), '.', locale->decimal_point[ 0 ] );
+            }
+
+            const double value = std::strtod( text.c_str(), nullptr );
+            if( not std::isfinite( value ) )
+            {
+                push( 'n' );
+                return true;
+            }
+
+            u64 bits = 0;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            push( 'd' );
+            m_tape.push_back( bits );
+            return true;
+        }
+
+        const char* m_data;
+
+        const std::size_t m_size;
+
+        const std::vector< u32 >& m_index;
+
+        std::size_t m_next;
+
+        std::vector< u64 >& m_tape;
+
+        std::string& m_strings;
+    };
+}
+
+Json::Document::Document( const char* data, const std::size_t size )
+: m_tape()
+, m_strings()
+{
+    if( size > std::numeric_limits< u32 >::max() )
+    {
+        throw std::invalid_argument( "Json: document exceeds 4 GiB" );
+    }
+
+    std::vector< u32 > positions;
+    positions.reserve( size / 8 + 16 );
+    m_tape.reserve( size / 8 + 16 );
+
+    if( not index( data, size, positions ) or
+        not Builder( data, size, positions, m_tape, m_strings ).build() )
+    {
+        throw std::invalid_argument( "Json: invalid document" );
+    }
+}
+
+std::size_t Json::Document::size( void ) const
+{
+    return m_tape.size();
+}
+
+Json::Object Json::Document::object( void ) const
+{
+    std::size_t position = 0;
+    return convert( position );
+}
+
+u1 Json::Document::accelerated( void )
+{
+#ifdef LIBSTDHL_JSON_AVX2
+    return classifier() == &classifyAvx2;
+#else
+    return false;
+#endif
+}
+
+u1 Json::Document::accelerate( const u1 enabled )
+{
+#ifdef LIBSTDHL_JSON_AVX2
+    if( enabled and supported() )
+    {
+        selected().store( &classifyAvx2, std::memory_order_relaxed );
+        return true;
+    }
+#endif
+
+    selected().store( &classifyScalar, std::memory_order_relaxed );
+    return not enabled;
+}
+
+Json::Object Json::Document::convert( std::size_t& position ) const
+{
+    const auto entry = m_tape[ position++ ];
+    const auto type = static_cast< char >( entry >> 56 );
+
+    const auto string = [&]( const u64 offset, std::string& result ) {
+        u32 length = 0;
+        std::memcpy( &length, &m_strings[ offset ], sizeof( u32 ) );
+        result.assign( &m_strings[ offset + sizeof( u32 ) ], length );
+    };
+
+    switch( type )
+    {
+        case '{':
+        {
+            Object result( Object::value_t::object );
+            auto& members = result.get_ref< Object::object_t& >();
+            while( static_cast< char >( m_tape[ position ] >> 56 ) != '}' )
+            {
+                std::string key;
+                string( m_tape[ position++ ] & PayloadMask, key );
+                members[ std::move( key ) ] = convert( position );
+            }
+            position++;
+            return result;
+        }
+        case '[':
+        {
+            Object result( Object::value_t::array );
+            auto& elements = result.get_ref< Object::array_t& >();
+            while( static_cast< char >( m_tape[ position ] >> 56 ) != ']' )
+            {
+                elements.push_back( convert( position ) );
+            }
+            position++;
+            return result;
+        }
+        case '"':
+        {
+            Object result( Object::value_t::string );
+            string( entry & PayloadMask, result.get_ref< Object::string_t& >() );
+            return result;
+        }
+        case 'u':
+        {
+            return Object( static_cast< Object::number_unsigned_t >( m_tape[ position++ ] ) );
+        }
+        case 'l':
+        {
+            return Object( static_cast< Object::number_integer_t >( m_tape[ position++ ] ) );
+        }
+        case 'd':
+        {
+            double value = 0;
+            std::memcpy( &value, &m_tape[ position++ ], sizeof( value ) );
+            return Object( value );
+        }
+        case 't':
+        {
+            return Object( true );
+        }
+        case 'f':
+        {
+            return Object( false );
+        }
+        default:
+        {
+            return Object( nullptr );
+        }
+    }
+}
+
+Json::Object Json::parse( const char* data, const std::size_t size )
+{
+    try
+    {
+        return Document( data, size ).object();
+    }
+    catch( const std::invalid_argument& )
+    {
+        // reports the same error as the JSON library
+        return Object::parse( data, data + size );
+    }
+}
+
+Json::Object Json::parse( const std::string& data )
+{
+    return parse( data.data(), data.size() );
+}
+
+//
+// Json::dump
+//
+
+namespace
+{
+#ifdef LIBSTDHL_JSON_AVX2
+    __attribute__( ( target( "avx2" ) ) ) static std::size_t plainAvx2(
+        const char* data, const std::size_t size )
+    {
+        const auto quote = _mm256_set1_epi8( '"' );
+        const auto backslash = _mm256_set1_epi8( '\\' );
+        const auto control = _mm256_set1_epi8( 0x1f );
+
+        std::size_t position = 0;
+        for( ; position + 32 <= size; position += 32 )
+        {
+            const auto chunk =
+                _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + position ) );
+            const auto special = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_cmpeq_epi8( chunk, quote ), _mm256_cmpeq_epi8( chunk, backslash ) ),
+                _mm256_cmpeq_epi8( _mm256_max_epu8( chunk, control ), control ) );
+            const u32 mask = static_cast< u32 >( _mm256_movemask_epi8( special ) );
+            if( mask )
+            {
+                return position + __builtin_ctz( mask );
+            }
+        }
+        return position;
+    }
+#endif
+
+    static inline std::size_t plain( const char* data, const std::size_t size )
+    {
+        std::size_t position = 0;
+
+#ifdef LIBSTDHL_JSON_AVX2
+        if( Json::Document::accelerated() )
+        {
+            position = plainAvx2( data, size );
+        }
+#endif
+
+        while( position < size )
+        {
+            const auto c = static_cast< u8 >( data[ position ] );
+            if( c == '"' or c == '\\' or c < 0x20 )
+            {
+                break;
+            }
+            position++;
+        }
+        return position;
+    }
+
+    static void escape( const std::string& text, std::string& result )
+    {
+        static const char hex[] = "0123456789abcdef";
+
+        result += '"';
+        const auto data = text.data();
+        std::size_t position = 0;
+        while( position < text.size() )
+        {
+            const auto length = plain( data + position, text.size() - position );
+            result.append( data + position, length );
+            position += length;
+            if( position == text.size() )
+            {
+                break;
+            }
+
+            const auto c = data[ position++ ];
+            switch( c )
+            {
+                case '"':
+                {
+                    result += "\\\"";
+                    break;
+                }
+                case '\\':
+                {
+                    result += "\\\\";
+                    break;
+                }
+                case '\b':
+                {
+                    result += "\\b";
+                    break;
+                }
+                case '\f':
+                {
+                    result += "\\f";
+                    break;
+                }
+                case '\n':
+                {
+                    result += "\\n";
+                    break;
+                }
+                case '\r':
+                {
+                    result += "\\r";
+                    break;
+                }
+                case '\t':
+                {
+                    result += "\\t";
+                    break;
+                }
+                default:
+                {
+                    result += "\\u00";
+                    result += hex[ ( c >> 4 ) & 0x0f ];
+                    result += hex[ c & 0x0f ];
+                    break;
+                }
+            }
+        }
+        result += '"';
+    }
+
+    static void dump( const Json::Object& object, std::string& result )
+    {
+        switch( object.type() )
+        {
+            case Json::Object::value_t::object:
+            {
+                result += '{';
+                u1 first = true;
+                for( auto it = object.cbegin(); it != object.cend(); ++it )
+                {
+                    if( not first )
+                    {
+                        result += ',';
+                    }
+                    first = false;
+                    escape( it.key(), result );
+                    result += ':';
+                    dump( it.value(), result );
+                }
+                result += '}';
+                break;
+            }
+            case Json::Object::value_t::array:
+            {
+                result += '[';
+                u1 first = true;
+                for( const auto& element : object )
+                {
+                    if( not first )
+                    {
+                        result += ',';
+                    }
+                    first = false;
+                    dump( element, result );
+                }
+                result += ']';
+                break;
+            }
+            case Json::Object::value_t::string:
+            {
+                escape( object.get_ref< const Json::Object::string_t& >(), result );
+                break;
+            }
+            case Json::Object::value_t::boolean:
+            {
+                result += object.get< bool >() ? "true" : "false";
+                break;
+            }
+            case Json::Object::value_t::number_integer:
+            {
+                result += std::to_string( object.get< Json::Object::number_integer_t >() );
+                break;
+            }
+            case Json::Object::value_t::number_unsigned:
+            {
+                result += std::to_string( object.get< Json::Object::number_unsigned_t >() );
+                break;
+            }
+            case Json::Object::value_t::null:
+            {
+                result += "null";
+                break;
+            }
+            default:
+            {
+                // floating-point numbers keep the formatting of the JSON library
+                result += object.dump();
+                break;
+            }
+        }
+    }
+}
+
+std::string Json::dump( const Object& object )
+{
+    std::string result;
+    ::dump( object, result );
+    return result;
+}
+
+u1 Json::unescape( const char* begin, const char* end, std::string& result )
+{
+    result.clear();
+    result.reserve( end - begin );
+
+    const auto encode = [&result]( const u32 code ) {
+        if( code < 0x80 )
+        {
+            result += static_cast< char >( code );
+        }
+        else if( code < 0x800 )
+        {
+            result += static_cast< char >( 0xc0 | ( code >> 6 ) );
+            result += static_cast< char >( 0x80 | ( code & 0x3f ) );
+        }
+        else if( code < 0x10000 )
+        {
+            result += static_cast< char >( 0xe0 | ( code >> 12 ) );
+            result += static_cast< char >( 0x80 | ( ( code >> 6 ) & 0x3f ) );
+            result += static_cast< char >( 0x80 | ( code & 0x3f ) );
+        }
+        else
+        {
+            result += static_cast< char >( 0xf0 | ( code >> 18 ) );
+            result += static_cast< char >( 0x80 | ( ( code >> 12 ) & 0x3f ) );
+            result += static_cast< char >( 0x80 | ( ( code >> 6 ) & 0x3f ) );
+            result += static_cast< char >( 0x80 | ( code & 0x3f ) );
+        }
+    };
+
+    const auto hex = [&end]( const char*& position, u32& code ) -> u1 {
+        if( end - position < 4 )
+        {
+            return false;
+        }
+
+        code = 0;
+        for( std::size_t i = 0; i < 4; i++ )
+        {
+            const auto c = *position++;
+            code <<= 4;
+            if( c >= '0' and c <= '9' )
+            {
+                code |= c - '0';
+            }
+            else if( c >= 'a' and c <= 'f' )
+            {
+                code |= c - 'a' + 10;
+            }
+            else if( c >= 'A' and c <= 'F' )
+            {
+                code |= c - 'A' + 10;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto position = begin;
+    while( position < end )
+    {
+        const auto escape = std::find( position, end, '\\' );
+        result.append( position, escape );
+        if( escape == end )
+        {
+            break;
+        }
+
+        position = escape + 1;
+        if( position == end )
+        {
+            return false;
+        }
+
+        switch( *position++ )
+        {
+            case '"':
+            {
+                result += '"';
+                break;
+            }
+            case '\\':
+            {
+                result += '\\';
+                break;
+            }
+            case '/':
+            {
+                result += '/';
+                break;
+            }
+            case 'b':
+            {
+                result += '\b';
+                break;
+            }
+            case 'f':
+            {
+                result += '\f';
+                break;
+            }
+            case 'n':
+            {
+                result += '\n';
+                break;
+            }
+            case 'r':
+            {
+                result += '\r';
+                break;
+            }
+            case 't':
+            {
+                result += '\t';
+                break;
+            }
+            case 'u':
+            {
+                u32 code = 0;
+                if( not hex( position, code ) )
+                {
+                    return false;
+                }
+
+                if( code >= 0xdc00 and code <= 0xdfff )
+                {
+                    // lone low surrogate
+                    return false;
+                }
+                else if( code >= 0xd800 and code <= 0xdbff )
+                {
+                    // high surrogate, has to be followed by a low surrogate
+                    u32 low = 0;
+                    if( end - position < 2 or position[ 0 ] != '\\' or position[ 1 ] != 'u' )
+                    {
+                        return false;
+                    }
+                    position += 2;
+                    if( not hex( position, low ) or low < 0xdc00 or low > 0xdfff )
+                    {
+                        return false;
+                    }
+                    code = 0x10000 + ( ( code - 0xd800 ) << 10 ) + ( low - 0xdc00 );
+                }
+
+                encode( code );
+                break;
+            }
+            default:
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 //
 //  Local variables:
 //  mode: c++
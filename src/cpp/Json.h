@@ -47,6 +47,9 @@
 #include <libstdhl/std/rfc3986>
 #include <libstdhl/vendor/json/json>
 
+#include <string>
+#include <vector>
+
 /**
    @brief    C++ JSON Wrapper
 
@@ -62,6 +65,65 @@ namespace libstdhl
     {
         using Object = nlohmann::json;
 
+        /**
+           JSON document parsed in two stages in the style of simdjson.
+
+           First a structural index of all quotes and structural characters outside of
+           strings is computed 64 bytes at a time (with AVX2 if the CPU supports it),
+           then the values are recorded on a flat tape, which is converted into an
+           Object on demand. Invalid documents throw a 'std::invalid_argument'.
+        */
+        class Document final
+        {
+          public:
+            Document( const char* data, const std::size_t size );
+
+            /**
+               number of tape entries
+            */
+            std::size_t size( void ) const;
+
+            Object object( void ) const;
+
+            /**
+               true if the structural index is computed with AVX2, by default whenever
+               this CPU supports it
+            */
+            static u1 accelerated( void );
+
+            /**
+               selects the AVX2 (true) or the scalar (false) structural index for all
+               documents, e.g. to test both, returns false if AVX2 is not supported by
+               this CPU and the scalar index stays selected
+            */
+            static u1 accelerate( const u1 enabled );
+
+          private:
+            Object convert( std::size_t& position ) const;
+
+            std::vector< u64 > m_tape;
+
+            std::string m_strings;
+        };
+
+        /**
+           parses 'data' through a Document, invalid data is reported with the same
+           errors as 'Object::parse'
+        */
+        Object parse( const char* data, const std::size_t size );
+
+        Object parse( const std::string& data );
+
+        /**
+           compact serialization, equal to 'object.dump()'
+        */
+        std::string dump( const Object& object );
+
+        /**
+           unescapes the contents [begin, end) of a JSON string (without quotes)
+        */
+        u1 unescape( const char* begin, const char* end, std::string& result );
+
         u1 hasProperty( const Object& object, const std::string& field );
 
         void validateTypeIsObject( const std::string& context, const Object& object );
@@ -155,7 +217,7 @@ namespace libstdhl
             validatePropertyIsArray( context, object, field, required );
             if( hasProperty( object, field ) )
             {
-                for( auto element : object[ field ] )
+                for( const auto& element : object[ field ] )
                 {
                     T::validate( element );
                 }
@@ -172,7 +234,7 @@ namespace libstdhl
         void validateTypeIsArrayOf( const std::string& context, const Object& object )
         {
             validateTypeIsArray( context, object );
-            for( auto element : object )
+            for( const auto& element : object )
             {
                 T::validate( element );
             }
@@ -182,7 +244,7 @@ namespace libstdhl
         void validateTypeIsMixedArrayOf( const std::string& context, const Object& object )
         {
             validateTypeIsArray( context, object );
-            for( auto element : object )
+            for( const auto& element : object )
             {
                 try
                 {
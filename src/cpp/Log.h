@@ -45,20 +45,29 @@
 
 #include <libstdhl/Type>
 
+#include <libstdhl/data/log/Binary>
 #include <libstdhl/data/log/Category>
 #include <libstdhl/data/log/Channel>
 #include <libstdhl/data/log/Data>
+#include <libstdhl/data/log/Epoch>
 #include <libstdhl/data/log/Filter>
+#include <libstdhl/data/log/FlightRecorder>
 #include <libstdhl/data/log/Formatter>
+#include <libstdhl/data/log/Histogram>
 #include <libstdhl/data/log/Item>
 #include <libstdhl/data/log/Level>
+#include <libstdhl/data/log/Limiter>
 #include <libstdhl/data/log/Logger>
+#include <libstdhl/data/log/Metrics>
+#include <libstdhl/data/log/Profiler>
 #include <libstdhl/data/log/Router>
 #include <libstdhl/data/log/Sink>
 #include <libstdhl/data/log/Source>
 #include <libstdhl/data/log/Stream>
 #include <libstdhl/data/log/Switch>
 #include <libstdhl/data/log/Timestamp>
+#include <libstdhl/data/log/Trace>
+#include <libstdhl/data/log/Worker>
 
 /**
    @brief    TODO
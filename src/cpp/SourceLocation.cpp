@@ -203,7 +203,7 @@ std::string SourceLocation::read( void ) const
 
     for( auto pos = beginL; pos <= endL; pos++ )
     {
-        auto line = libstdhl::File::readLine( *fileName(), pos );
+        auto line = libstdhl::File::Cache::readLine( *fileName(), pos );
 
         if( pos == beginL and pos == endL )
         {
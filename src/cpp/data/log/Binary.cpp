@@ -0,0 +1,496 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Binary.h"
+
+#include "Formatter.h"
+#include "Stream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace libstdhl;
+using namespace Log;
+
+static inline void encodeNumber( std::string& buffer, u64 value )
+{
+    do
+    {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        buffer += static_cast< char >( value != 0 ? ( byte | 0x80 ) : byte );
+    } while( value != 0 );
+}
+
+static inline void encodeTimestamp( std::string& buffer, const Timestamp& timestamp )
+{
+    const u64 value = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                          timestamp.timestamp().time_since_epoch() )
+                          .count();
+
+    for( std::size_t shift = 0; shift < 64; shift += 8 )
+    {
+        buffer += static_cast< char >( ( value >> shift ) & 0xff );
+    }
+}
+
+static inline void encodeText( std::string& buffer, const std::string& text )
+{
+    encodeNumber( buffer, text.size() );
+    buffer += text;
+}
+
+static inline void encodePosition( std::string& buffer, const PositionItem& position )
+{
+    encodeNumber( buffer, position.line() );
+    encodeNumber( buffer, position.column() );
+}
+
+static inline void encodeRange( std::string& buffer, const RangeItem& range )
+{
+    encodePosition( buffer, range.begin() );
+    encodePosition( buffer, range.end() );
+}
+
+static inline void encodeDictionary(
+    std::string& buffer,
+    const Binary::Record record,
+    const u32 handle,
+    const std::string& name,
+    const std::string& description )
+{
+    buffer += static_cast< char >( record );
+    encodeNumber( buffer, handle );
+    encodeText( buffer, name );
+    encodeText( buffer, description );
+}
+
+//
+// BinarySink
+//
+
+BinarySink::BinarySink( std::ostream& stream )
+: m_stream( stream )
+, m_buffer()
+, m_payload()
+, m_header( false )
+, m_sources()
+, m_categories()
+{
+}
+
+void BinarySink::process( const Stream& stream )
+{
+    m_buffer.clear();
+
+    if( not m_header )
+    {
+        m_buffer.append( Binary::Magic, std::strlen( Binary::Magic ) );
+        m_buffer += static_cast< char >( Binary::Version );
+        m_header = true;
+    }
+
+    for( auto& data : stream.data() )
+    {
+        const auto& source = *data.source();
+        if( m_sources.emplace( source.handle() ).second )
+        {
+            encodeDictionary(
+                m_buffer,
+                Binary::Record::SOURCE,
+                source.handle(),
+                source.name(),
+                source.description() );
+        }
+
+        const auto& category = *data.category();
+        if( m_categories.emplace( category.handle() ).second )
+        {
+            encodeDictionary(
+                m_buffer,
+                Binary::Record::CATEGORY,
+                category.handle(),
+                category.name(),
+                category.description() );
+        }
+
+        m_buffer += static_cast< char >( Binary::Record::DATA );
+        encodeTimestamp( m_buffer, data.timestamp() );
+        encodeNumber( m_buffer, source.handle() );
+        encodeNumber( m_buffer, category.handle() );
+        m_buffer += static_cast< char >( data.level().id() );
+        encodeNumber( m_buffer, data.items().size() );
+
+        for( const auto& item : data.items() )
+        {
+            auto id = item->id();
+            m_payload.clear();
+
+            switch( id )
+            {
+                case Item::ID::TEXT:
+                {
+                    m_payload = static_cast< const TextItem& >( *item ).text();
+                    break;
+                }
+                case Item::ID::POSITION:
+                {
+                    encodePosition( m_payload, static_cast< const PositionItem& >( *item ) );
+                    break;
+                }
+                case Item::ID::RANGE:
+                {
+                    encodeRange( m_payload, static_cast< const RangeItem& >( *item ) );
+                    break;
+                }
+                case Item::ID::LOCATION:
+                {
+                    const auto& location = static_cast< const LocationItem& >( *item );
+                    encodeText( m_payload, location.filename().text() );
+                    encodeRange( m_payload, location.range() );
+                    break;
+                }
+                default:
+                {
+                    // all other items are stored in their textual representation
+                    StringFormatter formatter;
+                    item->accept( formatter, m_payload );
+                    id = Item::ID::TEXT;
+                    break;
+                }
+            }
+
+            m_buffer += static_cast< char >( id );
+            encodeNumber( m_buffer, m_payload.size() );
+            m_buffer += m_payload;
+        }
+    }
+
+    m_stream.write( m_buffer.data(), m_buffer.size() );
+}
+
+//
+// BinaryReader
+//
+
+static inline u8 decodeByte( const char*& position, const char* end )
+{
+    if( position == end )
+    {
+        throw std::domain_error( "binary log item payload is truncated" );
+    }
+
+    return static_cast< u8 >( *position++ );
+}
+
+static inline u64 decodeNumber( const char*& position, const char* end )
+{
+    u64 value = 0;
+
+    for( std::size_t shift = 0; shift < 64; shift += 7 )
+    {
+        const auto byte = decodeByte( position, end );
+        value |= static_cast< u64 >( byte & 0x7f ) << shift;
+
+        if( not( byte & 0x80 ) )
+        {
+            return value;
+        }
+    }
+
+    throw std::domain_error( "binary log contains an invalid number" );
+}
+
+static inline std::string decodeText( const char*& position, const char* end )
+{
+    const auto length = decodeNumber( position, end );
+
+    if( length > static_cast< u64 >( end - position ) )
+    {
+        throw std::domain_error( "binary log item payload is truncated" );
+    }
+
+    std::string text( position, length );
+    position += length;
+    return text;
+}
+
+static inline PositionItem decodePosition( const char*& position, const char* end )
+{
+    const auto line = decodeNumber( position, end );
+    const auto column = decodeNumber( position, end );
+    return PositionItem( line, column );
+}
+
+static inline RangeItem decodeRange( const char*& position, const char* end )
+{
+    const auto begin = decodePosition( position, end );
+    const auto last = decodePosition( position, end );
+    return RangeItem( begin, last );
+}
+
+static inline u8 readByte( std::istream& stream )
+{
+    const auto character = stream.get();
+
+    if( character == std::istream::traits_type::eof() )
+    {
+        throw std::domain_error( "binary log is truncated" );
+    }
+
+    return static_cast< u8 >( character );
+}
+
+static inline u64 readNumber( std::istream& stream )
+{
+    u64 value = 0;
+
+    for( std::size_t shift = 0; shift < 64; shift += 7 )
+    {
+        const auto byte = readByte( stream );
+        value |= static_cast< u64 >( byte & 0x7f ) << shift;
+
+        if( not( byte & 0x80 ) )
+        {
+            return value;
+        }
+    }
+
+    throw std::domain_error( "binary log contains an invalid number" );
+}
+
+static inline std::string readText( std::istream& stream )
+{
+    const auto length = readNumber( stream );
+
+    // the length is untrusted, allocate only along with the input actually read
+    static constexpr u64 Chunk = 64 * 1024;
+
+    std::string text;
+    while( text.size() < length )
+    {
+        const auto offset = text.size();
+        const auto size = std::min( length - offset, Chunk );
+        text.resize( offset + size );
+
+        if( not stream.read( &text[ offset ], size ) )
+        {
+            throw std::domain_error( "binary log is truncated" );
+        }
+    }
+
+    return text;
+}
+
+BinaryReader::BinaryReader( std::istream& stream )
+: m_stream( stream )
+, m_header( false )
+, m_sources()
+, m_categories()
+{
+}
+
+u1 BinaryReader::read( Stream& stream, const std::size_t limit )
+{
+    if( not m_header )
+    {
+        if( m_stream.peek() == std::istream::traits_type::eof() )
+        {
+            return false;
+        }
+
+        const auto length = std::strlen( Binary::Magic );
+        std::string magic( length, '\0' );
+
+        if( not m_stream.read( &magic[ 0 ], length ) or magic != Binary::Magic )
+        {
+            throw std::domain_error( "binary log has an invalid magic" );
+        }
+
+        if( readByte( m_stream ) != Binary::Version )
+        {
+            throw std::domain_error( "binary log has an unsupported version" );
+        }
+
+        m_header = true;
+    }
+
+    std::size_t count = 0;
+    std::string payload;
+
+    while( limit == 0 or count < limit )
+    {
+        if( m_stream.peek() == std::istream::traits_type::eof() )
+        {
+            return false;
+        }
+
+        const auto record = static_cast< Binary::Record >( readByte( m_stream ) );
+
+        switch( record )
+        {
+            case Binary::Record::SOURCE:
+            {
+                const auto handle = readNumber( m_stream );
+                const auto name = readText( m_stream );
+                const auto description = readText( m_stream );
+                m_sources[ handle ] = std::make_shared< Source >( name, description );
+                break;
+            }
+            case Binary::Record::CATEGORY:
+            {
+                const auto handle = readNumber( m_stream );
+                const auto name = readText( m_stream );
+                const auto description = readText( m_stream );
+                m_categories[ handle ] = std::make_shared< Category >( name, description );
+                break;
+            }
+            case Binary::Record::DATA:
+            {
+                u64 nanoseconds = 0;
+                for( std::size_t shift = 0; shift < 64; shift += 8 )
+                {
+                    nanoseconds |= static_cast< u64 >( readByte( m_stream ) ) << shift;
+                }
+
+                const auto source = m_sources.find( readNumber( m_stream ) );
+                const auto category = m_categories.find( readNumber( m_stream ) );
+
+                if( source == m_sources.end() or category == m_categories.end() )
+                {
+                    throw std::domain_error( "binary log refers to an undefined dictionary entry" );
+                }
+
+                const auto level = static_cast< Level::ID >( readByte( m_stream ) );
+                if( level > Level::ID::OUTPUT )
+                {
+                    throw std::domain_error( "binary log contains an invalid level" );
+                }
+
+                Data data( level, source->second, category->second );
+                data.setTimestamp(
+                    Timestamp( std::chrono::system_clock::time_point(
+                        std::chrono::duration_cast< std::chrono::system_clock::duration >(
+                            std::chrono::nanoseconds( nanoseconds ) ) ) ) );
+
+                const auto items = readNumber( m_stream );
+                for( u64 index = 0; index < items; index++ )
+                {
+                    const auto id = static_cast< Item::ID >( readByte( m_stream ) );
+                    payload = readText( m_stream );
+
+                    const char* position = payload.data();
+                    const char* end = position + payload.size();
+
+                    switch( id )
+                    {
+                        case Item::ID::TEXT:
+                        {
+                            data.add< TextItem >( payload );
+                            break;
+                        }
+                        case Item::ID::POSITION:
+                        {
+                            data.add< PositionItem >( decodePosition( position, end ) );
+                            break;
+                        }
+                        case Item::ID::RANGE:
+                        {
+                            data.add< RangeItem >( decodeRange( position, end ) );
+                            break;
+                        }
+                        case Item::ID::LOCATION:
+                        {
+                            const auto filename = decodeText( position, end );
+                            const auto range = decodeRange( position, end );
+                            data.add< LocationItem >( TextItem( filename ), range );
+                            break;
+                        }
+                        default:
+                        {
+                            // skip unknown items
+                            break;
+                        }
+                    }
+                }
+
+                stream.data().emplace_back( std::move( data ) );
+                count++;
+                break;
+            }
+            default:
+            {
+                throw std::domain_error( "binary log contains an unknown record" );
+            }
+        }
+    }
+
+    return true;
+}
+
+void BinaryReader::replay( Channel& channel, const std::size_t batch )
+{
+    assert( batch > 0 );
+
+    Stream stream;
+    u1 pending = true;
+
+    while( pending )
+    {
+        pending = read( stream, batch );
+
+        if( not stream.data().empty() )
+        {
+            stream.flush( channel );
+        }
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,156 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_BINARY_H_
+#define _LIBSTDHL_CPP_LOG_BINARY_H_
+
+#include <libstdhl/data/log/Category>
+#include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Source>
+
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+   @brief    compact binary log encoding
+
+   A binary log starts with the magic 'LSHL' followed by a format version byte and
+   consists of tagged records. Integers are unsigned LEB128 varints except the
+   timestamp, which is a little-endian u64 of nanoseconds since the epoch.
+
+   - SOURCE   : handle, name, description (sent once per source)
+   - CATEGORY : handle, name, description (sent once per category)
+   - DATA     : timestamp, source handle, category handle, level byte, item count,
+                followed by the items as (tag, length, payload) triples
+
+   Strings are length-prefixed, unknown item tags can be skipped by their length.
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        class Stream;
+
+        namespace Binary
+        {
+            static constexpr const char* Magic = "LSHL";
+
+            static constexpr u8 Version = 1;
+
+            enum class Record : u8
+            {
+                SOURCE = 1,
+                CATEGORY = 2,
+                DATA = 3,
+            };
+        }
+
+        class BinarySink final : public Channel
+        {
+          public:
+            using Ptr = std::shared_ptr< BinarySink >;
+
+            BinarySink( std::ostream& stream );
+
+          private:
+            std::ostream& m_stream;
+
+            std::string m_buffer;
+
+            std::string m_payload;
+
+            u1 m_header;
+
+            std::unordered_set< u32 > m_sources;
+
+            std::unordered_set< u32 > m_categories;
+
+          public:
+            void process( const Stream& stream ) override;
+        };
+
+        class BinaryReader final
+        {
+          public:
+            BinaryReader( std::istream& stream );
+
+            /**
+               decodes up to 'limit' records (0 means all remaining) into 'stream',
+               returns false when the end of the binary log was reached
+            */
+            u1 read( Stream& stream, const std::size_t limit = 0 );
+
+            /**
+               decodes the whole binary log and passes it in batches of 'batch' records
+               to the given channel, e.g. a sink with an arbitrary Formatter
+            */
+            void replay( Channel& channel, const std::size_t batch = 1024 );
+
+          private:
+            std::istream& m_stream;
+
+            u1 m_header;
+
+            std::unordered_map< u32, Source::Ptr > m_sources;
+
+            std::unordered_map< u32, Category::Ptr > m_categories;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_BINARY_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
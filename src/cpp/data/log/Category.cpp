@@ -54,22 +54,39 @@ Category::Category( const std::string& name, const std::string& description )
 : Item( Item::ID::CATEGORY )
 , m_name( name )
 , m_description( description )
+, m_handle( intern( Item::ID::CATEGORY, name, description ) )
+, m_threshold( Level::ID::DEBUG )
 {
 }
 
-std::string Category::name( void ) const
+const std::string& Category::name( void ) const
 {
     return m_name;
 }
 
-std::string Category::description( void ) const
+const std::string& Category::description( void ) const
 {
     return m_description;
 }
 
-std::string Category::accept( Formatter& formatter )
+u32 Category::handle( void ) const
 {
-    return formatter.visit( *this );
+    return m_handle;
+}
+
+void Category::setThreshold( const Level::ID level )
+{
+    m_threshold.store( level, std::memory_order_relaxed );
+}
+
+Level::ID Category::threshold( void ) const
+{
+    return m_threshold.load( std::memory_order_relaxed );
+}
+
+void Category::accept( Formatter& formatter, std::string& buffer ) const
+{
+    formatter.append( buffer, *this );
 }
 
 //
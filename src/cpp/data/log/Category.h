@@ -44,6 +44,9 @@
 #define _LIBSTDHL_CPP_LOG_CATEGORY_H_
 
 #include <libstdhl/data/log/Item>
+#include <libstdhl/data/log/Level>
+
+#include <atomic>
 
 /**
    @brief    TODO
@@ -65,21 +68,26 @@ namespace libstdhl
 
             Category( const std::string& name, const std::string& description );
 
-            std::string name( void ) const;
+            const std::string& name( void ) const;
+
+            const std::string& description( void ) const;
+
+            /**
+               process-wide interned handle, equal for all categories with the same name and
+               description, used for allocation-free matching and lookups
+            */
+            u32 handle( void ) const;
+
+            /**
+               least severe level a Logger emits for this category, can be changed at runtime
+            */
+            void setThreshold( const Level::ID level );
 
-            std::string description( void ) const;
+            Level::ID threshold( void ) const;
 
             inline u1 operator==( const Category& rhs ) const
             {
-                if( this != &rhs )
-                {
-                    if( ( this->name().compare( rhs.name() ) != 0 ) or
-                        ( this->description().compare( rhs.description() ) != 0 ) )
-                    {
-                        return false;
-                    }
-                }
-                return true;
+                return this->handle() == rhs.handle();
             }
 
             inline u1 operator!=( const Category& rhs ) const
@@ -92,8 +100,14 @@ namespace libstdhl
 
             std::string m_description;
 
+            u32 m_handle;
+
+            std::atomic< Level::ID > m_threshold;
+
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
 
             static Category::Ptr defaultCategory( void )
             {
@@ -70,7 +70,12 @@ namespace libstdhl
           public:
             using Ptr = std::shared_ptr< Channel >;
 
-            virtual void process( Stream& stream ) = 0;
+            /**
+               the records of the stream are only valid during the call, a channel which
+               keeps them has to copy them, the stream may be shared by several channels
+               processing it concurrently
+            */
+            virtual void process( const Stream& stream ) = 0;
         };
 
         using Channels = libstdhl::List< Channel >;
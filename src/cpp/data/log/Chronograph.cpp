@@ -94,9 +94,9 @@ void Chronograph::cont( void )
     }
 }
 
-std::string Chronograph::accept( Formatter& formatter )
+void Chronograph::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
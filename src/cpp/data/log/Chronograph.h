@@ -101,7 +101,9 @@ namespace libstdhl
             std::chrono::high_resolution_clock::time_point m_stop;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
 
             friend std::ostream& operator<<( std::ostream& stream, Chronograph& obj )
             {
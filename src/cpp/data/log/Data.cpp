@@ -86,6 +86,11 @@ Data::Data( const Level::ID level )
 {
 }
 
+void Data::setTimestamp( const Timestamp& timestamp )
+{
+    m_timestamp = timestamp;
+}
+
 Timestamp Data::timestamp( void ) const
 {
     return m_timestamp;
@@ -101,7 +106,7 @@ void Data::setSource( const Source::Ptr& source )
     m_source = source;
 }
 
-Source::Ptr Data::source( void ) const
+const Source::Ptr& Data::source( void ) const
 {
     return m_source;
 }
@@ -111,7 +116,7 @@ void Data::setCategory( const Category::Ptr& category )
     m_category = category;
 }
 
-Category::Ptr Data::category( void ) const
+const Category::Ptr& Data::category( void ) const
 {
     return m_category;
 }
@@ -121,14 +126,14 @@ void Data::setItems( const Items& items )
     m_items = items;
 }
 
-Items Data::items( void ) const
+const Items& Data::items( void ) const
 {
     return m_items;
 }
 
-std::string Data::accept( Formatter& formatter )
+void Data::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
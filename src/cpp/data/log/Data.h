@@ -86,21 +86,23 @@ namespace libstdhl
 
             Data( Level::ID level );
 
+            void setTimestamp( const Timestamp& timestamp );
+
             Timestamp timestamp( void ) const;
 
             Level level( void ) const;
 
             void setSource( const Source::Ptr& source );
 
-            Source::Ptr source( void ) const;
+            const Source::Ptr& source( void ) const;
 
             void setCategory( const Category::Ptr& category );
 
-            Category::Ptr category( void ) const;
+            const Category::Ptr& category( void ) const;
 
             void setItems( const Items& items );
 
-            Items items( void ) const;
+            const Items& items( void ) const;
 
             template < typename T, typename... Args >
             void add( Args&&... args )
@@ -116,7 +118,9 @@ namespace libstdhl
             Items m_items;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
     }
 }
@@ -0,0 +1,274 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Epoch.h"
+
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace libstdhl;
+using namespace Log;
+
+namespace
+{
+    /**
+       announcement slot of a reader thread, slots are never freed but reused by
+       threads started later
+    */
+    struct Record
+    {
+        std::atomic< u64 > epoch;
+
+        std::atomic< u1 > used;
+
+        Record* next;
+    };
+
+    struct Retired
+    {
+        u64 epoch;
+
+        std::function< void( void ) > deleter;
+    };
+
+    struct Domain
+    {
+        std::atomic< u64 > epoch{ 1 };
+
+        std::atomic< Record* > records{ nullptr };
+
+        std::mutex mutex;
+
+        std::deque< Retired > retired;
+
+        ~Domain( void )
+        {
+            // no readers remain at exit, release everything still pending
+            for( auto& retired : this->retired )
+            {
+                retired.deleter();
+            }
+        }
+    };
+
+    Domain& domain( void )
+    {
+        static Domain cache;
+        return cache;
+    }
+
+    Record* acquire( void )
+    {
+        auto& domain = ::domain();
+
+        for( auto record = domain.records.load( std::memory_order_acquire ); record;
+             record = record->next )
+        {
+            u1 used = false;
+            if( not record->used.load( std::memory_order_relaxed ) and
+                record->used.compare_exchange_strong( used, true ) )
+            {
+                return record;
+            }
+        }
+
+        auto record = new Record();
+        record->epoch.store( 0, std::memory_order_relaxed );
+        record->used.store( true, std::memory_order_relaxed );
+        record->next = domain.records.load( std::memory_order_relaxed );
+        while( not domain.records.compare_exchange_weak( record->next, record ) )
+        {
+        }
+        return record;
+    }
+
+    struct Participant
+    {
+        Record* record;
+
+        std::size_t depth;
+
+        Participant( void )
+        : record( acquire() )
+        , depth( 0 )
+        {
+        }
+
+        ~Participant( void )
+        {
+            record->epoch.store( 0, std::memory_order_release );
+            record->used.store( false, std::memory_order_release );
+        }
+    };
+
+    Participant& participant( void )
+    {
+        static thread_local Participant cache;
+        return cache;
+    }
+}
+
+//
+// Epoch::Guard
+//
+
+Epoch::Guard::Guard( void )
+{
+    auto& participant = ::participant();
+    if( participant.depth++ > 0 )
+    {
+        return;
+    }
+
+    participant.record->epoch.store( domain().epoch.load(), std::memory_order_seq_cst );
+    // the announcement must be visible before the guarded pointers are loaded
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+}
+
+Epoch::Guard::~Guard( void )
+{
+    auto& participant = ::participant();
+    if( --participant.depth > 0 )
+    {
+        return;
+    }
+
+    participant.record->epoch.store( 0, std::memory_order_release );
+}
+
+//
+// Epoch
+//
+
+void Epoch::retire( std::function< void( void ) > deleter )
+{
+    auto& domain = ::domain();
+    {
+        std::lock_guard< std::mutex > lock( domain.mutex );
+        domain.retired.push_back( Retired{ domain.epoch.fetch_add( 1 ), std::move( deleter ) } );
+    }
+
+    collect();
+}
+
+std::size_t Epoch::collect( void )
+{
+    auto& domain = ::domain();
+
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+    // a reader announcing epoch 'e' may hold objects retired at 'e' or later
+    u64 minimum = std::numeric_limits< u64 >::max();
+    for( auto record = domain.records.load( std::memory_order_acquire ); record;
+         record = record->next )
+    {
+        const auto epoch = record->epoch.load();
+        if( epoch != 0 and epoch < minimum )
+        {
+            minimum = epoch;
+        }
+    }
+
+    std::vector< std::function< void( void ) > > deleters;
+    std::size_t pending = 0;
+    {
+        std::lock_guard< std::mutex > lock( domain.mutex );
+        while( not domain.retired.empty() and domain.retired.front().epoch < minimum )
+        {
+            deleters.emplace_back( std::move( domain.retired.front().deleter ) );
+            domain.retired.pop_front();
+        }
+        pending = domain.retired.size();
+    }
+
+    // deleters run outside of the lock, they may destroy workers which join threads
+    for( const auto& deleter : deleters )
+    {
+        deleter();
+    }
+
+    return pending;
+}
+
+std::size_t Epoch::pending( void )
+{
+    auto& domain = ::domain();
+    std::lock_guard< std::mutex > lock( domain.mutex );
+    return domain.retired.size();
+}
+
+void Epoch::synchronize( void )
+{
+    assert( participant().depth == 0 );
+
+    auto& domain = ::domain();
+    const auto epoch = domain.epoch.fetch_add( 1 );
+
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+    // readers entering from now on announce a later epoch and see the published state
+    for( auto record = domain.records.load( std::memory_order_acquire ); record;
+         record = record->next )
+    {
+        while( true )
+        {
+            const auto announced = record->epoch.load();
+            if( announced == 0 or announced > epoch )
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,174 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_EPOCH_H_
+#define _LIBSTDHL_CPP_LOG_EPOCH_H_
+
+#include <libstdhl/Type>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        /**
+           Process-wide epoch-based reclamation for read-mostly shared state.
+
+           Readers announce the current epoch while they hold a Guard, which costs a
+           thread-local store and no lock. Writers retire replaced objects, which are
+           destroyed once every reader that might still reference them left its guard.
+        */
+        class Epoch final
+        {
+          public:
+            class Guard final
+            {
+              public:
+                Guard( void );
+
+                ~Guard( void );
+
+                Guard( const Guard& ) = delete;
+
+                Guard& operator=( const Guard& ) = delete;
+            };
+
+            /**
+               defers 'deleter' until no reader can observe the retired object anymore
+            */
+            static void retire( std::function< void( void ) > deleter );
+
+            template < typename T >
+            static void retire( const T* object )
+            {
+                retire( [object]( void ) { delete object; } );
+            }
+
+            /**
+               runs the deleters of all objects that are no longer observable and returns
+               the number of objects still pending
+            */
+            static std::size_t collect( void );
+
+            static std::size_t pending( void );
+
+            /**
+               blocks until every reader which held a guard at the time of the call left
+               it, must not be called while holding a guard
+            */
+            static void synchronize( void );
+        };
+
+        /**
+           Immutable value published with a single atomic pointer (read-copy-update).
+
+           'load' must be called while an Epoch::Guard is held and the reference is valid
+           until the guard is released. 'update' copies the current value, applies the
+           modification and publishes the copy, concurrent updates are serialized.
+        */
+        template < typename T >
+        class Snapshot final
+        {
+          public:
+            Snapshot( void )
+            : m_value( new T() )
+            {
+            }
+
+            ~Snapshot( void )
+            {
+                delete m_value.load( std::memory_order_relaxed );
+            }
+
+            Snapshot( const Snapshot& ) = delete;
+
+            Snapshot& operator=( const Snapshot& ) = delete;
+
+            const T& load( void ) const
+            {
+                return *m_value.load( std::memory_order_acquire );
+            }
+
+            template < typename Function >
+            void update( Function&& function )
+            {
+                std::lock_guard< std::mutex > lock( m_mutex );
+
+                std::unique_ptr< T > next( new T( *m_value.load( std::memory_order_relaxed ) ) );
+                function( *next );
+
+                const T* previous = m_value.exchange( next.release(), std::memory_order_seq_cst );
+                Epoch::retire( previous );
+            }
+
+          private:
+            std::atomic< T* > m_value;
+
+            std::mutex m_mutex;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_EPOCH_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
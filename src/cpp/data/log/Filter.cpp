@@ -40,6 +40,7 @@
 //
 
 #include "Filter.h"
+#include "Data.h"
 #include "Stream.h"
 
 #include <cassert>
@@ -52,153 +53,158 @@ using namespace Log;
 //
 
 Filter::Filter( void )
-: m_channel( nullptr )
-, m_inverse( false )
+: m_rules()
+, m_scratch()
+, m_passed()
+, m_filtered()
 {
 }
 
 Channel::Ptr Filter::channel( void ) const
 {
-    return m_channel;
+    Epoch::Guard guard;
+    return m_rules.load().channel;
 }
 
 void Filter::setChannel( const Channel::Ptr& channel )
 {
     assert( channel );
-    m_channel = channel;
+    m_rules.update( [&]( Rules& rules ) { rules.channel = channel; } );
 }
 
 void Filter::clear( void )
 {
-    m_sources.clear();
-    m_categories.clear();
-    m_levels.clear();
+    m_rules.update( []( Rules& rules ) {
+        rules.sources.clear();
+        rules.categories.clear();
+        rules.levels = 0;
+    } );
 }
 
 void Filter::setInverse( u1 inverse )
 {
-    m_inverse = inverse;
+    m_rules.update( [&]( Rules& rules ) { rules.inverse = inverse; } );
 }
 
 u1 Filter::inverse( void ) const
 {
-    return m_inverse;
+    Epoch::Guard guard;
+    return m_rules.load().inverse;
 }
 
 void Filter::setSource( const Source::Ptr& source )
 {
-    m_sources.add( source );
+    assert( source );
+    m_rules.update( [&]( Rules& rules ) { rules.sources.emplace( source->handle() ); } );
 }
 
 void Filter::setCategory( const Category::Ptr& category )
 {
-    m_categories.add( category );
+    assert( category );
+    m_rules.update( [&]( Rules& rules ) { rules.categories.emplace( category->handle() ); } );
 }
 
 void Filter::setLevel( Level level )
 {
-    m_levels.emplace_back( level );
+    setLevel( level.id() );
 }
 
 void Filter::setLevel( Level::ID level )
 {
-    m_levels.emplace_back( level );
+    m_rules.update(
+        [&]( Rules& rules ) { rules.levels |= ( 1u << static_cast< u32 >( level ) ); } );
 }
 
-void Filter::process( Stream& stream )
+u1 Filter::match( const Data& data ) const
 {
-    Stream filtered;
+    Epoch::Guard guard;
+    return m_rules.load().match( data );
+}
 
-    if( not m_channel )
+u1 Filter::Rules::match( const Data& data ) const
+{
+    if( levels & ( 1u << static_cast< u32 >( data.level().id() ) ) )
     {
-        return;
+        return true;
     }
 
-    if( not m_inverse )
+    if( not sources.empty() and sources.find( data.source()->handle() ) != sources.end() )
     {
-        // normal filter case
+        return true;
+    }
 
-        for( auto data : stream.data() )
-        {
-            for( auto source : m_sources )
-            {
-                if( *source == *data.source() )
-                {
-                    filtered.add( std::move( data ) );
-                }
-            }
+    if( not categories.empty() and
+        categories.find( data.category()->handle() ) != categories.end() )
+    {
+        return true;
+    }
 
-            for( auto category : m_categories )
-            {
-                if( *category == *data.category() )
-                {
-                    filtered.add( std::move( data ) );
-                }
-            }
+    return false;
+}
 
-            for( auto level : m_levels )
+void Filter::process( const Stream& stream )
+{
+    const auto& data = stream.data();
+
+    std::unique_lock< std::mutex > lock( m_scratch, std::try_to_lock );
+    std::vector< std::size_t > localPassed;
+    Stream localFiltered;
+    auto& passed = lock.owns_lock() ? m_passed : localPassed;
+    auto& filtered = lock.owns_lock() ? m_filtered : localFiltered;
+
+    // the guard only covers the matching, the channel may block or reconfigure the filter
+    Channel::Ptr channel;
+    {
+        Epoch::Guard guard;
+        const auto& rules = m_rules.load();
+
+        channel = rules.channel;
+        if( not channel )
+        {
+            return;
+        }
+
+        passed.clear();
+        for( std::size_t index = 0; index < data.size(); index++ )
+        {
+            if( rules.match( data[ index ] ) != rules.inverse )
             {
-                if( level == data.level() )
-                {
-                    filtered.add( std::move( data ) );
-                }
+                passed.emplace_back( index );
             }
         }
     }
-    else
+
+    if( passed.empty() )
     {
-        // inverse filter case
+        return;
+    }
 
-        for( auto data : stream.data() )
-        {
-            if( m_sources.size() != 0 )
-            {
-                for( auto source : m_sources )
-                {
-                    if( *source != *data.source() )
-                    {
-                        filtered.add( std::move( data ) );
-                    }
-                }
-            }
-            else
-            {
-                filtered.add( std::move( data ) );
-            }
+    if( passed.size() == data.size() )
+    {
+        // every record passes, forward the stream itself without copying
+        channel->process( stream );
+        return;
+    }
 
-            if( m_categories.size() != 0 )
-            {
-                for( auto category : m_categories )
-                {
-                    if( *category != *data.category() )
-                    {
-                        filtered.add( std::move( data ) );
-                    }
-                }
-            }
-            else
-            {
-                filtered.add( std::move( data ) );
-            }
+    // the stream may be shared with other channels, the subset is a copy of its own
+    filtered.data().clear();
+    filtered.data().reserve( passed.size() );
+    for( const auto index : passed )
+    {
+        filtered.data().emplace_back( data[ index ] );
+    }
 
-            if( m_levels.size() != 0 )
-            {
-                for( auto level : m_levels )
-                {
-                    if( level != data.level() )
-                    {
-                        filtered.add( std::move( data ) );
-                    }
-                }
-            }
-            else
-            {
-                filtered.add( std::move( data ) );
-            }
-        }
+    try
+    {
+        channel->process( filtered );
+    }
+    catch( ... )
+    {
+        filtered.data().clear();
+        throw;
     }
 
-    m_channel->process( filtered );
+    filtered.data().clear();
 }
 
 //
@@ -45,8 +45,13 @@
 
 #include <libstdhl/data/log/Category>
 #include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Epoch>
 #include <libstdhl/data/log/Level>
 #include <libstdhl/data/log/Source>
+#include <libstdhl/data/log/Stream>
+
+#include <mutex>
+#include <unordered_set>
 
 /**
    @brief    TODO
@@ -61,6 +66,8 @@ namespace libstdhl
     */
     namespace Log
     {
+        class Data;
+
         class Filter final : public Channel
         {
           public:
@@ -94,19 +101,48 @@ namespace libstdhl
 
             void setLevel( Level::ID level );
 
+            /**
+               O(1) check if the given data matches at least one configured level, source or
+               category (without taking the inverse setting into account)
+            */
+            u1 match( const Data& data ) const;
+
           private:
-            Channel::Ptr m_channel;
+            /**
+               immutable matching rules, every setter publishes a modified copy so a filter
+               can be reconfigured while streams are processed
+            */
+            struct Rules
+            {
+                Channel::Ptr channel;
+
+                u1 inverse = false;
+
+                std::unordered_set< u32 > sources;
+
+                std::unordered_set< u32 > categories;
 
-            u1 m_inverse;
+                u32 levels = 0;
 
-            Sources m_sources;
+                u1 match( const Data& data ) const;
+            };
 
-            Categories m_categories;
+            Snapshot< Rules > m_rules;
 
-            Levels m_levels;
+            /**
+               reused per batch by the thread holding 'm_scratch', a concurrent batch falls
+               back to local buffers instead of waiting
+            */
+            std::mutex m_scratch;
+            std::vector< std::size_t > m_passed;
+            Stream m_filtered;
 
           public:
-            void process( Stream& stream ) override;
+            /**
+               forwards 'stream' itself if every record passes, otherwise a copy of the
+               passing records
+            */
+            void process( const Stream& stream ) override;
         };
 
         using Filters = List< Filter >;
@@ -0,0 +1,1041 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "FlightRecorder.h"
+#include "Data.h"
+#include "Item.h"
+#include "Stream.h"
+
+#include <cassert>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <thread>
+
+#if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
+#include <io.h>
+#define FILE_WRITE( FILE, DATA, LENGTH ) _write( FILE, DATA, static_cast< unsigned >( LENGTH ) )
+#else
+#include <unistd.h>
+#define FILE_WRITE( FILE, DATA, LENGTH ) ::write( FILE, DATA, LENGTH )
+#endif
+
+using namespace libstdhl;
+using namespace Log;
+
+static const char* levelName( const u8 level )
+{
+    static const char* names[] = { "emergency", "alert", "critical", "error", "warning",
+                                   "notice",    "info",  "debug",    "output" };
+
+    return level < sizeof( names ) / sizeof( names[ 0 ] ) ? names[ level ] : "unknown";
+}
+
+// async-signal-safe helpers, no allocation and no locale dependent formatting
+
+static void writeAll( const int fd, const char* data, std::size_t length )
+{
+    while( length > 0 )
+    {
+        const auto written = FILE_WRITE( fd, data, length );
+        if( written <= 0 )
+        {
+            return;
+        }
+
+        data += written;
+        length -= written;
+    }
+}
+
+static void writeText( const int fd, const char* text )
+{
+    writeAll( fd, text, std::strlen( text ) );
+}
+
+static void writeNumber(
+    const int fd, u64 value, const std::size_t digits = 0, const char* symbols = "0123456789" )
+{
+    const auto base = std::strlen( symbols );
+    char buffer[ 72 ];
+    std::size_t position = sizeof( buffer );
+
+    do
+    {
+        buffer[ --position ] = symbols[ value % base ];
+        value /= base;
+    } while( value > 0 or sizeof( buffer ) - position < digits );
+
+    writeAll( fd, buffer + position, sizeof( buffer ) - position );
+}
+
+static void writeSigned( const int fd, const i64 value )
+{
+    if( value < 0 )
+    {
+        writeText( fd, "-" );
+        writeNumber( fd, 0 - static_cast< u64 >( value ) );
+        return;
+    }
+
+    writeNumber( fd, static_cast< u64 >( value ) );
+}
+
+static void writeFloating( const int fd, double value )
+{
+    if( value != value )
+    {
+        writeText( fd, "nan" );
+        return;
+    }
+
+    if( value < 0 )
+    {
+        writeText( fd, "-" );
+        value = -value;
+    }
+
+    std::size_t exponent = 0;
+    while( value >= 1e18 and exponent < 400 )
+    {
+        value /= 10;
+        exponent++;
+    }
+
+    if( exponent >= 400 )
+    {
+        writeText( fd, "inf" );
+        return;
+    }
+
+    const auto integer = static_cast< u64 >( value );
+    writeNumber( fd, integer );
+    writeText( fd, "." );
+    writeNumber( fd, static_cast< u64 >( ( value - integer ) * 1e6 ), 6 );
+
+    if( exponent > 0 )
+    {
+        writeText( fd, "e+" );
+        writeNumber( fd, exponent );
+    }
+}
+
+/**
+   renders a format item like 'FormatItem::text' but ignores flags, width and precision
+*/
+static void writeFormat(
+    const int fd, const char* format, const u8* arguments, const std::size_t size )
+{
+    auto position = arguments;
+    const auto end = arguments + size;
+    FormatItem::Value value;
+
+    for( auto character = format; *character != '\0'; character++ )
+    {
+        if( *character != '%' )
+        {
+            auto next = character;
+            while( next[ 1 ] != '\0' and next[ 1 ] != '%' )
+            {
+                next++;
+            }
+            writeAll( fd, character, next - character + 1 );
+            character = next;
+            continue;
+        }
+
+        const auto begin = character++;
+
+        if( *character == '%' )
+        {
+            writeText( fd, "%" );
+            continue;
+        }
+
+        while( *character != '\0' and std::strchr( "-+ #0123456789.*", *character ) )
+        {
+            if( *character == '*' )
+            {
+                FormatItem::decode( position, end, value );
+            }
+            character++;
+        }
+
+        while( *character != '\0' and std::strchr( "hljztLq", *character ) )
+        {
+            character++;
+        }
+
+        const auto conversion = *character;
+
+        if( conversion == '\0' or not std::strchr( "diouxXeEfFgGaAcsp", conversion ) or
+            not FormatItem::decode( position, end, value ) )
+        {
+            writeAll( fd, begin, ( conversion == '\0' ? character : character + 1 ) - begin );
+
+            if( conversion == '\0' )
+            {
+                break;
+            }
+            continue;
+        }
+
+        switch( conversion )
+        {
+            case 'd':  // [[fallthrough]]
+            case 'i':
+            {
+                writeSigned( fd, value.integer );
+                break;
+            }
+            case 'o':
+            {
+                writeNumber( fd, static_cast< u64 >( value.integer ), 0, "01234567" );
+                break;
+            }
+            case 'u':
+            {
+                writeNumber( fd, static_cast< u64 >( value.integer ) );
+                break;
+            }
+            case 'x':
+            {
+                writeNumber( fd, static_cast< u64 >( value.integer ), 0, "0123456789abcdef" );
+                break;
+            }
+            case 'X':
+            {
+                writeNumber( fd, static_cast< u64 >( value.integer ), 0, "0123456789ABCDEF" );
+                break;
+            }
+            case 'c':
+            {
+                const auto letter = static_cast< char >( value.integer );
+                writeAll( fd, &letter, 1 );
+                break;
+            }
+            case 's':
+            {
+                if( value.argument == FormatItem::Argument::STRING )
+                {
+                    writeAll( fd, value.text, value.length );
+                }
+                else if( value.argument == FormatItem::Argument::FLOATING )
+                {
+                    writeFloating( fd, value.floating );
+                }
+                else
+                {
+                    writeSigned( fd, value.integer );
+                }
+                break;
+            }
+            case 'p':
+            {
+                writeText( fd, "0x" );
+                writeNumber( fd, static_cast< u64 >( value.integer ), 0, "0123456789abcdef" );
+                break;
+            }
+            default:
+            {
+                writeFloating( fd, value.floating );
+                break;
+            }
+        }
+    }
+}
+
+// slot payload, every item is stored as its id followed by its raw values
+
+namespace
+{
+    struct Writer
+    {
+        u8* position;
+        u8* end;
+
+        std::size_t room( void ) const
+        {
+            return end - position;
+        }
+
+        template < typename T >
+        u1 put( const T value )
+        {
+            if( room() < sizeof( value ) )
+            {
+                return false;
+            }
+
+            std::memcpy( position, &value, sizeof( value ) );
+            position += sizeof( value );
+            return true;
+        }
+
+        /**
+           length prefixed text, truncated to the remaining room
+        */
+        u1 put( const char* text, std::size_t length )
+        {
+            if( room() < sizeof( u32 ) )
+            {
+                return false;
+            }
+
+            length = length < room() - sizeof( u32 ) ? length : room() - sizeof( u32 );
+            put( static_cast< u32 >( length ) );
+            std::memcpy( position, text, length );
+            position += length;
+            return true;
+        }
+
+        /**
+           length prefixed arguments of 'item' with borrowed strings copied, the
+           arguments which do not fit are left out
+        */
+        u1 put( const FormatItem& item )
+        {
+            if( room() < sizeof( u32 ) )
+            {
+                return false;
+            }
+
+            const auto size = position;
+            position += sizeof( u32 );
+
+            auto argument = item.arguments();
+            const auto last = argument + item.size();
+            FormatItem::Value value;
+
+            while( FormatItem::decode( argument, last, value ) )
+            {
+                if( value.argument == FormatItem::Argument::STRING or
+                    value.argument == FormatItem::Argument::BORROWED )
+                {
+                    const auto overhead = 1 + sizeof( u32 ) + 1;
+                    if( room() < overhead )
+                    {
+                        break;
+                    }
+
+                    const auto length =
+                        value.length < room() - overhead ? value.length : room() - overhead;
+                    put( static_cast< u8 >( FormatItem::Argument::STRING ) );
+                    put( static_cast< u32 >( length ) );
+                    std::memcpy( position, value.text, length );
+                    position += length;
+                    put( '\0' );
+                    continue;
+                }
+
+                if( room() < 1 + 8 )
+                {
+                    break;
+                }
+
+                put( static_cast< u8 >( value.argument ) );
+                if( value.argument == FormatItem::Argument::FLOATING )
+                {
+                    put( value.floating );
+                }
+                else
+                {
+                    put( value.integer );
+                }
+            }
+
+            const auto length = static_cast< u32 >( position - size - sizeof( u32 ) );
+            std::memcpy( size, &length, sizeof( length ) );
+            return true;
+        }
+
+        /**
+           stores 'item' or leaves the payload untouched if it does not fit, items
+           without a raw representation are skipped
+        */
+        u1 put( const Item& item )
+        {
+            const auto start = position;
+            u1 fits = put( static_cast< u8 >( item.id() ) );
+
+            switch( item.id() )
+            {
+                case Item::ID::TEXT:
+                {
+                    const auto& text = static_cast< const TextItem& >( item ).text();
+                    fits = fits and put( text.data(), text.size() );
+                    break;
+                }
+                case Item::ID::POSITION:
+                {
+                    const auto& point = static_cast< const PositionItem& >( item );
+                    fits = fits and put( point.line() ) and put( point.column() );
+                    break;
+                }
+                case Item::ID::RANGE:
+                {
+                    const auto& range = static_cast< const RangeItem& >( item );
+                    fits = fits and put( range.begin().line() ) and
+                           put( range.begin().column() ) and put( range.end().line() ) and
+                           put( range.end().column() );
+                    break;
+                }
+                case Item::ID::LOCATION:
+                {
+                    const auto& location = static_cast< const LocationItem& >( item );
+                    const auto range = location.range();
+                    const auto& filename = location.filename().text();
+                    fits = fits and put( range.begin().line() ) and
+                           put( range.begin().column() ) and put( range.end().line() ) and
+                           put( range.end().column() ) and
+                           put( filename.data(), filename.size() );
+                    break;
+                }
+                case Item::ID::FORMAT:
+                {
+                    const auto& format = static_cast< const FormatItem& >( item );
+                    fits = fits and
+                           put( static_cast< u64 >(
+                               reinterpret_cast< std::uintptr_t >( format.format() ) ) ) and
+                           put( format );
+                    break;
+                }
+                default:
+                {
+                    position = start;
+                    return true;
+                }
+            }
+
+            if( not fits )
+            {
+                position = start;
+            }
+
+            return fits;
+        }
+    };
+
+    struct Entry
+    {
+        Item::ID id;
+        u64 values[ 4 ];
+        const char* text;
+        u32 length;
+        const char* format;
+    };
+
+    struct Reader
+    {
+        const u8* position;
+        const u8* end;
+
+        template < typename T >
+        u1 get( T& value )
+        {
+            if( static_cast< std::size_t >( end - position ) < sizeof( value ) )
+            {
+                return false;
+            }
+
+            std::memcpy( &value, position, sizeof( value ) );
+            position += sizeof( value );
+            return true;
+        }
+
+        u1 get( const char*& text, u32& length )
+        {
+            if( not get( length ) or static_cast< std::size_t >( end - position ) < length )
+            {
+                return false;
+            }
+
+            text = reinterpret_cast< const char* >( position );
+            position += length;
+            return true;
+        }
+
+        u1 get( Entry& entry )
+        {
+            u8 id;
+            if( not get( id ) )
+            {
+                return false;
+            }
+
+            entry.id = static_cast< Item::ID >( id );
+
+            switch( entry.id )
+            {
+                case Item::ID::TEXT:
+                {
+                    return get( entry.text, entry.length );
+                }
+                case Item::ID::POSITION:
+                {
+                    return get( entry.values[ 0 ] ) and get( entry.values[ 1 ] );
+                }
+                case Item::ID::RANGE:
+                {
+                    return get( entry.values[ 0 ] ) and get( entry.values[ 1 ] ) and
+                           get( entry.values[ 2 ] ) and get( entry.values[ 3 ] );
+                }
+                case Item::ID::LOCATION:
+                {
+                    return get( entry.values[ 0 ] ) and get( entry.values[ 1 ] ) and
+                           get( entry.values[ 2 ] ) and get( entry.values[ 3 ] ) and
+                           get( entry.text, entry.length );
+                }
+                case Item::ID::FORMAT:
+                {
+                    u64 format;
+                    if( not get( format ) )
+                    {
+                        return false;
+                    }
+                    entry.format =
+                        reinterpret_cast< const char* >( static_cast< std::uintptr_t >( format ) );
+                    return get( entry.text, entry.length );
+                }
+                default:
+                {
+                    return false;
+                }
+            }
+        }
+    };
+}
+
+static std::atomic< FlightRecorder* > recorderInstalled( nullptr );
+static std::atomic< int > recorderDescriptor( 2 );
+static std::atomic< u1 > recorderDumped( false );
+static std::terminate_handler recorderTerminate = nullptr;
+
+static void recorderDump( void )
+{
+    const auto recorder = recorderInstalled.load();
+
+    if( recorder and not recorderDumped.exchange( true ) )
+    {
+        recorder->dump( recorderDescriptor.load() );
+    }
+}
+
+static void recorderSignal( int signal )
+{
+    recorderDump();
+
+    std::signal( signal, SIG_DFL );
+    std::raise( signal );
+}
+
+static void recorderTerminated( void )
+{
+    recorderDump();
+
+    if( recorderTerminate )
+    {
+        recorderTerminate();
+    }
+
+    std::abort();
+}
+
+static const int recorderSignals[] = {
+#if defined( SIGBUS )
+    SIGBUS,
+#endif
+    SIGSEGV, SIGILL, SIGFPE, SIGABRT
+};
+
+//
+// FlightRecorder
+//
+
+template < typename T >
+FlightRecorder::Names< T >::Table::Table( const std::size_t size )
+: size( size )
+, values( new std::atomic< T* >[ size ] )
+{
+    for( std::size_t index = 0; index < size; index++ )
+    {
+        values[ index ].store( nullptr, std::memory_order_relaxed );
+    }
+}
+
+template < typename T >
+FlightRecorder::Names< T >::Names( void )
+: m_mutex()
+, m_table( nullptr )
+, m_tables()
+, m_values()
+{
+    m_tables.emplace_back( new Table( 64 ) );
+    m_table.store( m_tables.back().get(), std::memory_order_relaxed );
+}
+
+template < typename T >
+T* FlightRecorder::Names< T >::find( const u32 handle ) const
+{
+    const auto table = m_table.load( std::memory_order_acquire );
+    if( handle >= table->size )
+    {
+        return nullptr;
+    }
+
+    return table->values[ handle ].load( std::memory_order_acquire );
+}
+
+template < typename T >
+typename T::Ptr FlightRecorder::Names< T >::get( const u32 handle ) const
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    return handle < m_values.size() ? m_values[ handle ] : nullptr;
+}
+
+template < typename T >
+void FlightRecorder::Names< T >::remember( const typename T::Ptr& value )
+{
+    const auto handle = value->handle();
+
+    // equal handles have equal names, the first owner is kept
+    if( find( handle ) )
+    {
+        return;
+    }
+
+    std::lock_guard< std::mutex > guard( m_mutex );
+    auto table = m_table.load( std::memory_order_relaxed );
+
+    if( handle >= table->size )
+    {
+        auto size = table->size;
+        while( size <= handle )
+        {
+            size *= 2;
+        }
+
+        std::unique_ptr< Table > grown( new Table( size ) );
+        for( std::size_t index = 0; index < table->size; index++ )
+        {
+            grown->values[ index ].store(
+                table->values[ index ].load( std::memory_order_relaxed ),
+                std::memory_order_relaxed );
+        }
+
+        table = grown.get();
+        m_tables.emplace_back( std::move( grown ) );
+        m_table.store( table, std::memory_order_release );
+    }
+
+    if( table->values[ handle ].load( std::memory_order_relaxed ) )
+    {
+        return;
+    }
+
+    if( handle >= m_values.size() )
+    {
+        m_values.resize( table->size );
+    }
+
+    m_values[ handle ] = value;
+    table->values[ handle ].store( value.get(), std::memory_order_release );
+}
+
+FlightRecorder::FlightRecorder( const std::size_t records, const std::size_t size )
+: m_records( records )
+, m_size( size )
+, m_stride( ( sizeof( Slot ) + size + alignof( Slot ) - 1 ) / alignof( Slot ) * alignof( Slot ) )
+, m_ring( new u8[ records * m_stride ] )
+, m_head( 0 )
+, m_tail( 0 )
+, m_sources()
+, m_categories()
+, m_copy( new u8[ m_stride ] )
+, m_copying( false )
+{
+    assert( m_records > 0 );
+
+    for( std::size_t index = 0; index < m_records; index++ )
+    {
+        new( &slot( index ) ) Slot();
+        slot( index ).sequence.store( 0, std::memory_order_relaxed );
+    }
+}
+
+std::size_t FlightRecorder::capacity( void ) const
+{
+    return m_records;
+}
+
+u64 FlightRecorder::recorded( void ) const
+{
+    return m_head.load( std::memory_order_acquire ) - m_tail.load( std::memory_order_acquire );
+}
+
+void FlightRecorder::clear( void )
+{
+    m_tail.store( m_head.load( std::memory_order_acquire ), std::memory_order_release );
+}
+
+void FlightRecorder::dump( Stream& stream ) const
+{
+    const auto head = m_head.load( std::memory_order_acquire );
+    std::unique_ptr< u8[] > payload( new u8[ m_size ] );
+    std::string text;
+
+    for( auto index = begin(); index < head; index++ )
+    {
+        auto& current = slot( index );
+        const auto sequence = 2 * index + 2;
+
+        if( current.sequence.load( std::memory_order_acquire ) != sequence )
+        {
+            // not yet published or already overwritten
+            continue;
+        }
+
+        const auto time = current.time;
+        const auto source = current.source;
+        const auto category = current.category;
+        const auto level = current.level;
+        const auto length = current.length < m_size ? current.length : m_size;
+        std::memcpy( payload.get(), this->payload( current ), length );
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( current.sequence.load( std::memory_order_relaxed ) != sequence )
+        {
+            continue;
+        }
+
+        auto sourcePtr = m_sources.get( source );
+        if( not sourcePtr )
+        {
+            sourcePtr = Source::defaultSource();
+        }
+
+        auto categoryPtr = m_categories.get( category );
+        if( not categoryPtr )
+        {
+            categoryPtr = Category::defaultCategory();
+        }
+
+        stream.add( static_cast< Level::ID >( level ), sourcePtr, categoryPtr );
+        auto& data = stream.data().back();
+        data.setTimestamp( Timestamp( std::chrono::system_clock::time_point(
+            std::chrono::duration_cast< std::chrono::system_clock::duration >(
+                std::chrono::nanoseconds( time ) ) ) ) );
+
+        Reader reader{ payload.get(), payload.get() + length };
+        Entry entry;
+
+        while( reader.get( entry ) )
+        {
+            switch( entry.id )
+            {
+                case Item::ID::POSITION:
+                {
+                    data.add< PositionItem >( entry.values[ 0 ], entry.values[ 1 ] );
+                    break;
+                }
+                case Item::ID::RANGE:
+                {
+                    data.add< RangeItem >(
+                        PositionItem( entry.values[ 0 ], entry.values[ 1 ] ),
+                        PositionItem( entry.values[ 2 ], entry.values[ 3 ] ) );
+                    break;
+                }
+                case Item::ID::LOCATION:
+                {
+                    data.add< LocationItem >(
+                        std::string( entry.text, entry.length ),
+                        entry.values[ 0 ],
+                        entry.values[ 1 ],
+                        entry.values[ 2 ],
+                        entry.values[ 3 ] );
+                    break;
+                }
+                case Item::ID::FORMAT:
+                {
+                    text.clear();
+                    FormatItem::text(
+                        entry.format,
+                        reinterpret_cast< const u8* >( entry.text ),
+                        entry.length,
+                        text );
+                    data.add< TextItem >( text );
+                    break;
+                }
+                default:
+                {
+                    data.add< TextItem >( std::string( entry.text, entry.length ) );
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void FlightRecorder::dump( Channel& channel ) const
+{
+    Stream stream;
+    dump( stream );
+    stream.flush( channel );
+}
+
+void FlightRecorder::dump( const int fd ) const
+{
+    if( m_copying.exchange( true, std::memory_order_acquire ) )
+    {
+        writeText( fd, "flight recorder dump already in progress\n" );
+        return;
+    }
+
+    const auto head = m_head.load( std::memory_order_acquire );
+    auto& current = *reinterpret_cast< Slot* >( m_copy.get() );
+
+    for( auto index = begin(); index < head; index++ )
+    {
+        auto& recorded = slot( index );
+        const auto sequence = 2 * index + 2;
+
+        if( recorded.sequence.load( std::memory_order_acquire ) != sequence )
+        {
+            continue;
+        }
+
+        // a writer lapping the ring may change the slot while it is copied
+        current.time = recorded.time;
+        current.source = recorded.source;
+        current.category = recorded.category;
+        current.level = recorded.level;
+        current.length = recorded.length < m_size ? recorded.length : m_size;
+        std::memcpy( payload( current ), payload( recorded ), current.length );
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( recorded.sequence.load( std::memory_order_relaxed ) != sequence )
+        {
+            continue;
+        }
+
+        writeText( fd, "[" );
+        writeNumber( fd, current.time / 1000000000 );
+        writeText( fd, "." );
+        writeNumber( fd, current.time % 1000000000 / 1000, 6 );
+        writeText( fd, "] " );
+
+        const auto source = m_sources.find( current.source );
+        writeText( fd, source ? source->name().c_str() : "?" );
+        writeText( fd, ": " );
+
+        const auto category = m_categories.find( current.category );
+        writeText( fd, category ? category->name().c_str() : "?" );
+        writeText( fd, ": " );
+
+        writeText( fd, levelName( current.level ) );
+        writeText( fd, ": " );
+
+        Reader reader{ payload( current ), payload( current ) + current.length };
+        Entry entry;
+
+        for( u1 first = true; reader.get( entry ); first = false )
+        {
+            if( not first )
+            {
+                writeText( fd, ", " );
+            }
+
+            switch( entry.id )
+            {
+                case Item::ID::POSITION:
+                {
+                    writeNumber( fd, entry.values[ 0 ] );
+                    writeText( fd, ":" );
+                    writeNumber( fd, entry.values[ 1 ] );
+                    break;
+                }
+                case Item::ID::LOCATION:  // [[fallthrough]]
+                case Item::ID::RANGE:
+                {
+                    if( entry.id == Item::ID::LOCATION )
+                    {
+                        writeAll( fd, entry.text, entry.length );
+                        writeText( fd, ":" );
+                    }
+
+                    writeNumber( fd, entry.values[ 0 ] );
+                    writeText( fd, ":" );
+                    writeNumber( fd, entry.values[ 1 ] );
+                    writeText( fd, ".." );
+                    writeNumber( fd, entry.values[ 2 ] );
+                    writeText( fd, ":" );
+                    writeNumber( fd, entry.values[ 3 ] );
+                    break;
+                }
+                case Item::ID::FORMAT:
+                {
+                    writeFormat(
+                        fd,
+                        entry.format,
+                        reinterpret_cast< const u8* >( entry.text ),
+                        entry.length );
+                    break;
+                }
+                default:
+                {
+                    writeAll( fd, entry.text, entry.length );
+                    break;
+                }
+            }
+        }
+
+        writeText( fd, "\n" );
+    }
+
+    m_copying.store( false, std::memory_order_release );
+}
+
+void FlightRecorder::install( const FlightRecorder::Ptr& recorder, const int fd )
+{
+    static std::mutex mutex;
+    static FlightRecorder::Ptr installed;
+
+    std::lock_guard< std::mutex > guard( mutex );
+
+    recorderDescriptor.store( fd );
+    recorderInstalled.store( recorder.get() );
+    recorderDumped.store( false );
+
+    if( recorder and not installed )
+    {
+        for( const auto signal : recorderSignals )
+        {
+            std::signal( signal, recorderSignal );
+        }
+
+        recorderTerminate = std::set_terminate( recorderTerminated );
+    }
+    else if( not recorder and installed )
+    {
+        for( const auto signal : recorderSignals )
+        {
+            std::signal( signal, SIG_DFL );
+        }
+
+        std::set_terminate( recorderTerminate );
+        recorderTerminate = nullptr;
+    }
+
+    installed = recorder;
+}
+
+FlightRecorder::Slot& FlightRecorder::slot( const u64 index ) const
+{
+    return *reinterpret_cast< Slot* >( m_ring.get() + ( index % m_records ) * m_stride );
+}
+
+u8* FlightRecorder::payload( Slot& slot ) const
+{
+    return reinterpret_cast< u8* >( &slot + 1 );
+}
+
+u64 FlightRecorder::begin( void ) const
+{
+    const auto head = m_head.load( std::memory_order_acquire );
+    const auto tail = m_tail.load( std::memory_order_acquire );
+    return head - tail > m_records ? head - m_records : tail;
+}
+
+void FlightRecorder::process( const Stream& stream )
+{
+    for( const auto& data : stream.data() )
+    {
+        m_sources.remember( data.source() );
+        m_categories.remember( data.category() );
+
+        const auto index = m_head.fetch_add( 1, std::memory_order_relaxed );
+        auto& current = slot( index );
+
+        // a writer one lap ahead waits until the previous writer of the slot published
+        const auto previous = index < m_records ? 0 : 2 * ( index - m_records ) + 2;
+        auto expected = previous;
+        while( not current.sequence.compare_exchange_weak(
+            expected, 2 * index + 1, std::memory_order_acquire, std::memory_order_relaxed ) )
+        {
+            expected = previous;
+            std::this_thread::yield();
+        }
+        std::atomic_thread_fence( std::memory_order_release );
+
+        current.time = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                           data.timestamp().timestamp().time_since_epoch() )
+                           .count();
+        current.source = data.source()->handle();
+        current.category = data.category()->handle();
+        current.level = static_cast< u8 >( data.level().id() );
+
+        Writer writer{ payload( current ), payload( current ) + m_size };
+
+        for( const auto& item : data.items() )
+        {
+            if( not writer.put( *item ) )
+            {
+                break;
+            }
+        }
+
+        current.length = static_cast< u32 >( writer.position - payload( current ) );
+        current.sequence.store( 2 * index + 2, std::memory_order_release );
+    }
+}
+
+#undef FILE_WRITE
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
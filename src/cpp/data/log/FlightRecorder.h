@@ -0,0 +1,217 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_FLIGHT_RECORDER_H_
+#define _LIBSTDHL_CPP_LOG_FLIGHT_RECORDER_H_
+
+#include <libstdhl/data/log/Category>
+#include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Source>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        class Data;
+
+        /**
+           Keeps the most recent records in a preallocated ring for post-mortem dumps.
+
+           Every record occupies one fixed-size slot with 'size' bytes of payload, so the
+           ring uses 'records' times 'size' bytes and never allocates after construction.
+           Items are copied raw into the payload (texts, positions and the captured
+           arguments of format items) and only formatted when the ring is dumped, items
+           which do not fit are left out and the last text is truncated. Format strings
+           are kept by pointer and must outlive the recorder (e.g. string literals).
+           Slots are claimed with an atomic increment and published with a sequence
+           number, so any number of threads can record while another thread or a signal
+           handler dumps the ring.
+        */
+        class FlightRecorder final : public Channel
+        {
+          public:
+            using Ptr = std::shared_ptr< FlightRecorder >;
+
+            FlightRecorder( const std::size_t records = 1024, const std::size_t size = 256 );
+
+            std::size_t capacity( void ) const;
+
+            /**
+               amount of records processed since construction or the last clear
+            */
+            u64 recorded( void ) const;
+
+            void clear( void );
+
+            /**
+               adds the recorded records, oldest first, to the stream, e.g. to flush them
+               through any channel and formatter
+            */
+            void dump( Stream& stream ) const;
+
+            void dump( Channel& channel ) const;
+
+            /**
+               writes the recorded records to the file descriptor using only
+               async-signal-safe functions
+            */
+            void dump( const int fd ) const;
+
+            /**
+               dumps 'recorder' to 'fd' on fatal signals (SIGSEGV, SIGBUS, SIGILL, SIGFPE,
+               SIGABRT) and from std::terminate, a null recorder uninstalls it again
+            */
+            static void install( const FlightRecorder::Ptr& recorder, const int fd = 2 );
+
+          private:
+            struct Slot
+            {
+                std::atomic< u64 > sequence;
+                u64 time;
+                u32 source;
+                u32 category;
+                u32 length;
+                u8 level;
+            };
+
+            /**
+               sources or categories by interned handle, grown with the handles seen
+            */
+            template < typename T >
+            class Names
+            {
+              public:
+                Names( void );
+
+                /**
+                   lock-free and async-signal-safe, nullptr for an unknown handle
+                */
+                T* find( const u32 handle ) const;
+
+                /**
+                   owner of the handle or nullptr for an unknown handle
+                */
+                typename T::Ptr get( const u32 handle ) const;
+
+                void remember( const typename T::Ptr& value );
+
+              private:
+                struct Table
+                {
+                    Table( const std::size_t size );
+
+                    const std::size_t size;
+                    std::unique_ptr< std::atomic< T* >[] > values;
+                };
+
+                mutable std::mutex m_mutex;
+
+                std::atomic< Table* > m_table;
+
+                /**
+                   the current and all replaced tables, which lock-free readers may still use
+                */
+                std::vector< std::unique_ptr< Table > > m_tables;
+
+                std::vector< typename T::Ptr > m_values;
+            };
+
+            Slot& slot( const u64 index ) const;
+
+            u8* payload( Slot& slot ) const;
+
+            u64 begin( void ) const;
+
+            const std::size_t m_records;
+
+            const std::size_t m_size;
+
+            const std::size_t m_stride;
+
+            std::unique_ptr< u8[] > m_ring;
+
+            std::atomic< u64 > m_head;
+
+            std::atomic< u64 > m_tail;
+
+            Names< Source > m_sources;
+
+            Names< Category > m_categories;
+
+            /**
+               slot copy of the async-signal-safe dump, which must not allocate
+            */
+            std::unique_ptr< u8[] > m_copy;
+
+            mutable std::atomic< u1 > m_copying;
+
+          public:
+            void process( const Stream& stream ) override;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_FLIGHT_RECORDER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -52,142 +52,186 @@
 using namespace libstdhl;
 using namespace Log;
 
+static inline void appendNumber( std::string& buffer, u64 value )
+{
+    char digits[ 20 ];
+    std::size_t position = sizeof( digits );
+
+    do
+    {
+        digits[ --position ] = static_cast< char >( '0' + ( value % 10 ) );
+        value /= 10;
+    } while( value != 0 );
+
+    buffer.append( &digits[ position ], sizeof( digits ) - position );
+}
+
 //
 // StringFormatter
 //
 
-std::string StringFormatter::visit( Timestamp& item )
+void StringFormatter::append( std::string& buffer, const Timestamp& item )
 {
-    return item.local();
+    item.local( buffer );
 }
 
-std::string StringFormatter::visit( Chronograph& item )
+void StringFormatter::append( std::string& buffer, const Chronograph& item )
 {
-    return std::to_string( item.duration< std::chrono::nanoseconds >().count() ) + "ns";
+    appendNumber( buffer, item.duration< std::chrono::nanoseconds >().count() );
+    buffer += "ns";
 }
 
-std::string StringFormatter::visit( Source& item )
+void StringFormatter::append( std::string& buffer, const Source& item )
 {
-    return item.name();
+    buffer += item.name();
 }
 
-std::string StringFormatter::visit( Category& item )
+void StringFormatter::append( std::string& buffer, const Category& item )
 {
-    return item.name();
+    buffer += item.name();
 }
 
-std::string StringFormatter::visit( Level& item )
+void StringFormatter::append( std::string& buffer, const Level& item )
 {
     switch( item.id() )
     {
         case Level::ID::EMERGENCY:
         {
-            return "emergency";
+            buffer += "emergency";
+            return;
         }
         case Level::ID::ALERT:
         {
-            return "alert";
+            buffer += "alert";
+            return;
         }
         case Level::ID::CRITICAL:
         {
-            return "critical";
+            buffer += "critical";
+            return;
         }
         case Level::ID::ERROR:
         {
-            return "error";
+            buffer += "error";
+            return;
         }
         case Level::ID::WARNING:
         {
-            return "warning";
+            buffer += "warning";
+            return;
         }
         case Level::ID::NOTICE:
         {
-            return "notice";
+            buffer += "notice";
+            return;
         }
         case Level::ID::INFORMATIONAL:
         {
-            return "info";
+            buffer += "info";
+            return;
         }
         case Level::ID::DEBUG:
         {
-            return "debug";
+            buffer += "debug";
+            return;
         }
         case Level::ID::OUTPUT:
         {
-            return "output";
+            buffer += "output";
+            return;
         }
     }
 
     assert( !" internal error" );
-    return "";
 }
 
-std::string StringFormatter::visit( Data& item )
+void StringFormatter::append( std::string& buffer, const Data& item )
 {
-    std::string tmp = "";
-
-    tmp += "[" + item.timestamp().accept( *this ) + "] ";
+    buffer += "[";
+    item.timestamp().accept( *this, buffer );
+    buffer += "] ";
 
-    tmp += item.source()->accept( *this ) + ": ";
+    item.source()->accept( *this, buffer );
+    buffer += ": ";
 
-    tmp += item.category()->accept( *this ) + ": ";
+    item.category()->accept( *this, buffer );
+    buffer += ": ";
 
-    tmp += item.level().accept( *this ) + ": ";
+    item.level().accept( *this, buffer );
+    buffer += ": ";
 
     u1 first = true;
 
-    for( auto i : item.items() )
+    for( const auto& i : item.items() )
     {
-        tmp += ( first ? "" : ", " ) + i->accept( *this );
+        if( not first )
+        {
+            buffer += ", ";
+        }
+
+        i->accept( *this, buffer );
 
         first = false;
     }
+}
 
-    return tmp;
+void StringFormatter::append( std::string& buffer, const TextItem& item )
+{
+    buffer += item.text();
 }
 
-std::string StringFormatter::visit( TextItem& item )
+void StringFormatter::append( std::string& buffer, const PositionItem& item )
 {
-    return item.text();
+    appendNumber( buffer, item.line() );
+    buffer += ":";
+    appendNumber( buffer, item.column() );
 }
 
-std::string StringFormatter::visit( PositionItem& item )
+void StringFormatter::append( std::string& buffer, const RangeItem& item )
 {
-    return std::to_string( item.line() ) + ":" + std::to_string( item.column() );
+    item.begin().accept( *this, buffer );
+    buffer += "..";
+    item.end().accept( *this, buffer );
 }
 
-std::string StringFormatter::visit( RangeItem& item )
+void StringFormatter::append( std::string& buffer, const LocationItem& item )
 {
-    return item.begin().accept( *this ) + ".." + item.end().accept( *this );
+    auto filename = item.filename();
+    filename.accept( *this, buffer );
+    buffer += ":";
+    item.range().accept( *this, buffer );
 }
 
-std::string StringFormatter::visit( LocationItem& item )
+void StringFormatter::append( std::string& buffer, const FormatItem& item )
 {
-    return item.filename().accept( *this ) + ":" + item.range().accept( *this );
+    item.text( buffer );
 }
 
 //
 // ConsoleFormatter
 //
 
-std::string ConsoleFormatter::visit( Data& item )
+void ConsoleFormatter::append( std::string& buffer, const Data& item )
 {
-    std::string tmp = "";
-
-    tmp += item.source()->accept( *this ) + ": ";
+    item.source()->accept( *this, buffer );
+    buffer += ": ";
 
-    tmp += item.level().accept( *this ) + ": ";
+    item.level().accept( *this, buffer );
+    buffer += ": ";
 
     u1 first = true;
 
-    for( auto i : item.items() )
+    for( const auto& i : item.items() )
     {
-        tmp += ( first ? "" : "\n" ) + i->accept( *this );
+        if( not first )
+        {
+            buffer += "\n";
+        }
+
+        i->accept( *this, buffer );
 
         first = false;
     }
-
-    return tmp;
 }
 
 //
@@ -222,75 +266,87 @@ void ApplicationFormatter::setDetailedLocation( const u1 enable )
     m_detailedLocation = enable;
 }
 
-std::string ApplicationFormatter::visit( Level& item )
+void ApplicationFormatter::append( std::string& buffer, const Level& item )
 {
     switch( item.id() )
     {
         case Level::ID::EMERGENCY:
         {
-            return "emergency:";
+            buffer += "emergency:";
+            return;
         }
         case Level::ID::ALERT:
         {
-            return "alert:";
+            buffer += "alert:";
+            return;
         }
         case Level::ID::CRITICAL:
         {
-            return "critical:";
+            buffer += "critical:";
+            return;
         }
         case Level::ID::ERROR:
         {
-            return Ansi::format< Ansi::Color::RED >( "error:" );
+            buffer += Ansi::format< Ansi::Color::RED >( "error:" );
+            return;
         }
         case Level::ID::WARNING:
         {
-            return Ansi::format< Ansi::Color::MAGENTA >( "warning:" );
+            buffer += Ansi::format< Ansi::Color::MAGENTA >( "warning:" );
+            return;
         }
         case Level::ID::NOTICE:
         {
-            return "notice";
+            buffer += "notice";
+            return;
         }
         case Level::ID::INFORMATIONAL:
         {
-            return Ansi::format< Ansi::Color::YELLOW >( "info:" );
+            buffer += Ansi::format< Ansi::Color::YELLOW >( "info:" );
+            return;
         }
         case Level::ID::DEBUG:
         {
-            return Ansi::format< Ansi::Color::CYAN >( "debug:" );
+            buffer += Ansi::format< Ansi::Color::CYAN >( "debug:" );
+            return;
         }
         case Level::ID::OUTPUT:
         {
-            return "output";
+            buffer += "output";
+            return;
         }
     }
 
     assert( !" internal error" );
-    return "";
 }
 
-std::string ApplicationFormatter::visit( Data& item )
+void ApplicationFormatter::append( std::string& buffer, const Data& item )
 {
-    std::string tmp = m_name + ": ";
-
-    tmp = Ansi::format< Ansi::Style::BOLD >( tmp + item.level().accept( *this ) );
-    tmp += Ansi::CSI( Ansi::SGR::RESET );
-    tmp += " ";
-
-    if( item.level() == Level::ID::OUTPUT and m_rawOutput )
+    if( not( item.level() == Level::ID::OUTPUT and m_rawOutput ) )
     {
-        tmp = "";
+        std::string prefix = m_name + ": ";
+        item.level().accept( *this, prefix );
+
+        buffer += Ansi::format< Ansi::Style::BOLD >( prefix );
+        buffer += Ansi::CSI( Ansi::SGR::RESET );
+        buffer += " ";
     }
 
     u1 first = true;
 
-    for( auto i : item.items() )
+    for( const auto& i : item.items() )
     {
         if( i->id() == Item::ID::LOCATION )
         {
             continue;
         }
 
-        tmp += ( first ? "" : ", " ) + i->accept( *this );
+        if( not first )
+        {
+            buffer += ", ";
+        }
+
+        i->accept( *this, buffer );
 
         first = false;
     }
@@ -300,14 +356,15 @@ std::string ApplicationFormatter::visit( Data& item )
     auto src = item.source()->accept( *this );
     auto cat = item.category()->accept( *this );
 
-    tmp += Ansi::format< Ansi::Style::FAINT >( " [" + /*tsp +*/ src + ", " + cat + "]" );
+    buffer += Ansi::format< Ansi::Style::FAINT >( " [" + /*tsp +*/ src + ", " + cat + "]" );
 #endif
 
-    for( auto i : item.items() )
+    for( const auto& i : item.items() )
     {
         if( i->id() == Item::ID::LOCATION )
         {
-            tmp += "\n" + i->accept( *this );
+            buffer += "\n";
+            i->accept( *this, buffer );
 
             if( not m_detailedLocation )
             {
@@ -316,16 +373,17 @@ std::string ApplicationFormatter::visit( Data& item )
 
             const auto& location = static_cast< const LocationItem& >( *i );
 
-            const auto line =
-                File::readLine( location.filename().text(), location.range().begin().line() );
+            const auto line = File::Cache::readLine(
+                location.filename().text(), location.range().begin().line() );
             const auto lineStart = location.range().begin().column();
             auto lineLength = location.range().end().column() - location.range().begin().column();
 
-            tmp += "\n" + Ansi::format< 192, 192, 192 >( line ) + "\n";
-            tmp +=
+            buffer += "\n" + Ansi::format< 192, 192, 192 >( line ) + "\n";
+            buffer +=
                 String::expansion( line, 0, location.range().begin().column() - 1, tabSize(), ' ' );
-            tmp += Ansi::format< Ansi::Color::GREEN >( Ansi::format< Ansi::Style::BOLD >( "^" ) );
-            tmp += Ansi::CSI( Ansi::SGR::RESET );
+            buffer +=
+                Ansi::format< Ansi::Color::GREEN >( Ansi::format< Ansi::Style::BOLD >( "^" ) );
+            buffer += Ansi::CSI( Ansi::SGR::RESET );
 
             if( ( location.range().begin().line() == location.range().end().line() ) and
                 ( location.range().end().column() > location.range().begin().column() ) )
@@ -333,33 +391,34 @@ std::string ApplicationFormatter::visit( Data& item )
                 if( lineLength > 2 )
                 {
                     lineLength -= 2;
-                    tmp += Ansi::format< Ansi::Color::GREEN >(
+                    buffer += Ansi::format< Ansi::Color::GREEN >(
                         String::expansion( line, lineStart, lineLength, tabSize(), '-' ) );
-                    tmp += Ansi::format< Ansi::Color::GREEN >(
+                    buffer += Ansi::format< Ansi::Color::GREEN >(
                         Ansi::format< Ansi::Style::BOLD >( "^" ) );
                 }
                 else if( lineLength == 2 )
                 {
-                    tmp += Ansi::format< Ansi::Color::GREEN >(
+                    buffer += Ansi::format< Ansi::Color::GREEN >(
                         Ansi::format< Ansi::Style::BOLD >( "^" ) );
                 }
             }
             else
             {
-                tmp += Ansi::format< Ansi::Color::GREEN >(
+                buffer += Ansi::format< Ansi::Color::GREEN >(
                     String::expansion( line, lineStart, lineLength, tabSize(), '-' ) + "..." );
             }
-            tmp += Ansi::CSI( Ansi::SGR::RESET );
+            buffer += Ansi::CSI( Ansi::SGR::RESET );
         }
     }
-
-    return tmp;
 }
 
-std::string ApplicationFormatter::visit( LocationItem& item )
+void ApplicationFormatter::append( std::string& buffer, const LocationItem& item )
 {
-    return Ansi::format< Ansi::Style::BOLD >( StringFormatter::visit( item ) ) +
-           Ansi::CSI( Ansi::SGR::RESET );
+    std::string location;
+    StringFormatter::append( location, item );
+
+    buffer += Ansi::format< Ansi::Style::BOLD >( location );
+    buffer += Ansi::CSI( Ansi::SGR::RESET );
 }
 
 //
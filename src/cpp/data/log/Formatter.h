@@ -69,6 +69,7 @@ namespace libstdhl
         class PositionItem;
         class RangeItem;
         class LocationItem;
+        class FormatItem;
 
         /**
            @extends Log
@@ -76,39 +77,55 @@ namespace libstdhl
         class Formatter
         {
           public:
-            virtual std::string visit( Timestamp& item ) = 0;
-            virtual std::string visit( Chronograph& item ) = 0;
-            virtual std::string visit( Source& item ) = 0;
-            virtual std::string visit( Category& item ) = 0;
-            virtual std::string visit( Level& item ) = 0;
-            virtual std::string visit( Data& item ) = 0;
-
-            virtual std::string visit( TextItem& item ) = 0;
-            virtual std::string visit( PositionItem& item ) = 0;
-            virtual std::string visit( RangeItem& item ) = 0;
-            virtual std::string visit( LocationItem& item ) = 0;
+            virtual ~Formatter( void ) = default;
+
+            virtual void append( std::string& buffer, const Timestamp& item ) = 0;
+            virtual void append( std::string& buffer, const Chronograph& item ) = 0;
+            virtual void append( std::string& buffer, const Source& item ) = 0;
+            virtual void append( std::string& buffer, const Category& item ) = 0;
+            virtual void append( std::string& buffer, const Level& item ) = 0;
+            virtual void append( std::string& buffer, const Data& item ) = 0;
+
+            virtual void append( std::string& buffer, const TextItem& item ) = 0;
+            virtual void append( std::string& buffer, const PositionItem& item ) = 0;
+            virtual void append( std::string& buffer, const RangeItem& item ) = 0;
+            virtual void append( std::string& buffer, const LocationItem& item ) = 0;
+            virtual void append( std::string& buffer, const FormatItem& item ) = 0;
+
+            /**
+               convenience wrapper which formats the given item into a fresh string,
+               prefer 'append' with a reused buffer on hot paths
+            */
+            template < typename T >
+            std::string visit( const T& item )
+            {
+                std::string buffer;
+                append( buffer, item );
+                return buffer;
+            }
         };
 
         class StringFormatter : public Formatter
         {
           public:
-            std::string visit( Timestamp& item ) override;
-            std::string visit( Chronograph& item ) override;
-            std::string visit( Source& item ) override;
-            std::string visit( Category& item ) override;
-            std::string visit( Level& item ) override;
-            std::string visit( Data& item ) override;
-
-            std::string visit( TextItem& item ) override;
-            std::string visit( PositionItem& item ) override;
-            std::string visit( RangeItem& item ) override;
-            std::string visit( LocationItem& item ) override;
+            void append( std::string& buffer, const Timestamp& item ) override;
+            void append( std::string& buffer, const Chronograph& item ) override;
+            void append( std::string& buffer, const Source& item ) override;
+            void append( std::string& buffer, const Category& item ) override;
+            void append( std::string& buffer, const Level& item ) override;
+            void append( std::string& buffer, const Data& item ) override;
+
+            void append( std::string& buffer, const TextItem& item ) override;
+            void append( std::string& buffer, const PositionItem& item ) override;
+            void append( std::string& buffer, const RangeItem& item ) override;
+            void append( std::string& buffer, const LocationItem& item ) override;
+            void append( std::string& buffer, const FormatItem& item ) override;
         };
 
         class ConsoleFormatter : public StringFormatter
         {
           public:
-            std::string visit( Data& item ) override;
+            void append( std::string& buffer, const Data& item ) override;
         };
 
         class ApplicationFormatter : public StringFormatter
@@ -124,9 +141,9 @@ namespace libstdhl
 
             void setDetailedLocation( const u1 enable );
 
-            std::string visit( Level& item ) override;
-            std::string visit( Data& item ) override;
-            std::string visit( LocationItem& item ) override;
+            void append( std::string& buffer, const Level& item ) override;
+            void append( std::string& buffer, const Data& item ) override;
+            void append( std::string& buffer, const LocationItem& item ) override;
 
           private:
             std::string m_name;
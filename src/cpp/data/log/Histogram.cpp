@@ -0,0 +1,240 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Histogram.h"
+
+#include <limits>
+
+using namespace libstdhl;
+using namespace Log;
+
+// Histogram
+
+constexpr std::size_t Histogram::SubBuckets;
+constexpr std::size_t Histogram::MaxExponent;
+constexpr std::size_t Histogram::Buckets;
+
+Histogram::Histogram( void )
+{
+    reset();
+}
+
+Histogram::Histogram( const Histogram& other )
+{
+    reset();
+    merge( other );
+}
+
+void Histogram::record( const u64 value )
+{
+    m_buckets[ index( value ) ].fetch_add( 1, std::memory_order_relaxed );
+    m_count.fetch_add( 1, std::memory_order_relaxed );
+    m_sum.fetch_add( value, std::memory_order_relaxed );
+
+    auto minimum = m_min.load( std::memory_order_relaxed );
+    while( value < minimum and
+           not m_min.compare_exchange_weak( minimum, value, std::memory_order_relaxed ) )
+    {
+    }
+
+    auto maximum = m_max.load( std::memory_order_relaxed );
+    while( value > maximum and
+           not m_max.compare_exchange_weak( maximum, value, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+void Histogram::recordExclusive( const u64 value )
+{
+    auto& bucket = m_buckets[ index( value ) ];
+    bucket.store( bucket.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    m_count.store( m_count.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    m_sum.store( m_sum.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+
+    if( value < m_min.load( std::memory_order_relaxed ) )
+    {
+        m_min.store( value, std::memory_order_relaxed );
+    }
+
+    if( value > m_max.load( std::memory_order_relaxed ) )
+    {
+        m_max.store( value, std::memory_order_relaxed );
+    }
+}
+
+void Histogram::merge( const Histogram& other )
+{
+    for( std::size_t bucket = 0; bucket < Buckets; bucket++ )
+    {
+        const auto count = other.m_buckets[ bucket ].load( std::memory_order_relaxed );
+        if( count > 0 )
+        {
+            m_buckets[ bucket ].fetch_add( count, std::memory_order_relaxed );
+        }
+    }
+
+    m_count.fetch_add( other.m_count.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+    m_sum.fetch_add( other.m_sum.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+
+    const auto smallest = other.m_min.load( std::memory_order_relaxed );
+    auto minimum = m_min.load( std::memory_order_relaxed );
+    while( smallest < minimum and
+           not m_min.compare_exchange_weak( minimum, smallest, std::memory_order_relaxed ) )
+    {
+    }
+
+    const auto largest = other.m_max.load( std::memory_order_relaxed );
+    auto maximum = m_max.load( std::memory_order_relaxed );
+    while( largest > maximum and
+           not m_max.compare_exchange_weak( maximum, largest, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+u64 Histogram::count( void ) const
+{
+    return m_count.load( std::memory_order_relaxed );
+}
+
+u64 Histogram::sum( void ) const
+{
+    return m_sum.load( std::memory_order_relaxed );
+}
+
+u64 Histogram::min( void ) const
+{
+    return count() == 0 ? 0 : m_min.load( std::memory_order_relaxed );
+}
+
+u64 Histogram::max( void ) const
+{
+    return m_max.load( std::memory_order_relaxed );
+}
+
+u64 Histogram::percentile( const double percentile ) const
+{
+    u64 total = 0;
+    std::array< u64, Buckets > counts;
+
+    for( std::size_t bucket = 0; bucket < Buckets; bucket++ )
+    {
+        counts[ bucket ] = m_buckets[ bucket ].load( std::memory_order_relaxed );
+        total += counts[ bucket ];
+    }
+
+    if( total == 0 )
+    {
+        return 0;
+    }
+
+    const auto clamped = percentile < 0.0 ? 0.0 : ( percentile > 100.0 ? 100.0 : percentile );
+    auto rank = static_cast< u64 >( ( clamped / 100.0 ) * total + 0.5 );
+    rank = rank == 0 ? 1 : rank;
+
+    u64 seen = 0;
+    for( std::size_t bucket = 0; bucket < Buckets; bucket++ )
+    {
+        seen += counts[ bucket ];
+
+        if( seen >= rank )
+        {
+            const auto result = value( bucket );
+            return result > max() ? max() : result;
+        }
+    }
+
+    return max();
+}
+
+void Histogram::reset( void )
+{
+    for( auto& bucket : m_buckets )
+    {
+        bucket.store( 0, std::memory_order_relaxed );
+    }
+
+    m_count.store( 0, std::memory_order_relaxed );
+    m_sum.store( 0, std::memory_order_relaxed );
+    m_min.store( std::numeric_limits< u64 >::max(), std::memory_order_relaxed );
+    m_max.store( 0, std::memory_order_relaxed );
+}
+
+std::size_t Histogram::index( const u64 value )
+{
+    if( value < SubBuckets )
+    {
+        return value;
+    }
+
+    const std::size_t exponent = 63 - __builtin_clzll( value );
+
+    if( exponent >= MaxExponent )
+    {
+        return Buckets - 1;
+    }
+
+    // 'SubBuckets' is 2^5, so the 5 bits below the leading one select the sub-bucket
+    const std::size_t shift = exponent - 5;
+    return ( shift + 1 ) * SubBuckets + ( ( value >> shift ) - SubBuckets );
+}
+
+u64 Histogram::value( const std::size_t index )
+{
+    if( index < SubBuckets )
+    {
+        return index;
+    }
+
+    // midpoint of the bucket range
+    const std::size_t shift = index / SubBuckets - 1;
+    const u64 lower = static_cast< u64 >( index % SubBuckets + SubBuckets ) << shift;
+    return lower + ( ( static_cast< u64 >( 1 ) << shift ) >> 1 );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,144 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_HISTOGRAM_H_
+#define _LIBSTDHL_CPP_LOG_HISTOGRAM_H_
+
+#include <libstdhl/Type>
+
+#include <array>
+#include <atomic>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        /**
+           Lock-free log-linear (HDR-style) histogram of durations in nanoseconds.
+
+           Values are counted in 32 linear sub-buckets per power of two, which bounds the
+           relative error of reported percentiles to about 3%. Values above 2^40 ns
+           (about 18 minutes) are clamped into the last bucket.
+        */
+        class Histogram final
+        {
+          public:
+            static constexpr std::size_t SubBuckets = 32;
+
+            static constexpr std::size_t MaxExponent = 40;
+
+            static constexpr std::size_t Buckets = ( MaxExponent - 4 ) * SubBuckets;
+
+            Histogram( void );
+
+            /**
+               snapshot of 'other', e.g. to read it while it is recorded into
+            */
+            Histogram( const Histogram& other );
+
+            void record( const u64 value );
+
+            /**
+               like 'record' but without atomic read-modify-write operations, only valid
+               while a single thread records (e.g. into a per-thread histogram), readers
+               still see consistent values
+            */
+            void recordExclusive( const u64 value );
+
+            /**
+               adds all records of 'other'
+            */
+            void merge( const Histogram& other );
+
+            u64 count( void ) const;
+
+            u64 sum( void ) const;
+
+            u64 min( void ) const;
+
+            u64 max( void ) const;
+
+            /**
+               value below which 'percentile' (0 to 100) percent of the records fall
+            */
+            u64 percentile( const double percentile ) const;
+
+            void reset( void );
+
+            static std::size_t index( const u64 value );
+
+            static u64 value( const std::size_t index );
+
+          private:
+            std::array< std::atomic< u64 >, Buckets > m_buckets;
+
+            std::atomic< u64 > m_count;
+
+            std::atomic< u64 > m_sum;
+
+            std::atomic< u64 > m_min;
+
+            std::atomic< u64 > m_max;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_HISTOGRAM_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -42,6 +42,10 @@
 #include "Item.h"
 #include "Formatter.h"
 
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
 using namespace libstdhl;
 using namespace Log;
 
@@ -55,6 +59,24 @@ Item::ID Item::id( void ) const
     return m_id;
 }
 
+std::string Item::accept( Formatter& formatter ) const
+{
+    std::string buffer;
+    accept( formatter, buffer );
+    return buffer;
+}
+
+u32 Item::intern( ID id, const std::string& name, const std::string& description )
+{
+    static std::mutex mutex;
+    static std::unordered_map< u32, std::unordered_map< std::string, u32 > > kinds;
+
+    std::lock_guard< std::mutex > lock( mutex );
+    auto& handles = kinds[ static_cast< u32 >( id ) ];
+    const auto result = handles.emplace( name + '\0' + description, handles.size() );
+    return result.first->second;
+}
+
 //
 // TextItem
 //
@@ -65,14 +87,14 @@ TextItem::TextItem( const std::string& text )
 {
 }
 
-std::string TextItem::text( void ) const
+const std::string& TextItem::text( void ) const
 {
     return m_text;
 }
 
-std::string TextItem::accept( Formatter& formatter )
+void TextItem::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
@@ -96,9 +118,9 @@ u64 PositionItem::column( void ) const
     return m_column;
 }
 
-std::string PositionItem::accept( Formatter& formatter )
+void PositionItem::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
@@ -122,9 +144,9 @@ PositionItem RangeItem::end( void ) const
     return m_end;
 }
 
-std::string RangeItem::accept( Formatter& formatter )
+void RangeItem::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
@@ -150,7 +172,7 @@ LocationItem::LocationItem(
 {
 }
 
-TextItem LocationItem::filename( void ) const
+const TextItem& LocationItem::filename( void ) const
 {
     return m_filename;
 }
@@ -160,9 +182,300 @@ RangeItem LocationItem::range( void ) const
     return m_range;
 }
 
-std::string LocationItem::accept( Formatter& formatter )
+void LocationItem::accept( Formatter& formatter, std::string& buffer ) const
+{
+    formatter.append( buffer, *this );
+}
+
+//
+// FormatItem
+//
+
+constexpr std::size_t FormatItem::Inline;
+
+template < typename T >
+static u1 load( const u8*& position, const u8* end, T& value )
+{
+    if( static_cast< std::size_t >( end - position ) < sizeof( value ) )
+    {
+        return false;
+    }
+
+    std::memcpy( &value, position, sizeof( value ) );
+    position += sizeof( value );
+    return true;
+}
+
+template < typename T >
+static void appendFormatted( std::string& buffer, const std::string& specification, const T value )
+{
+    char local[ 128 ];
+    const auto size = std::snprintf( local, sizeof( local ), specification.c_str(), value );
+
+    if( size < 0 )
+    {
+        return;
+    }
+
+    if( static_cast< std::size_t >( size ) < sizeof( local ) )
+    {
+        buffer.append( local, size );
+        return;
+    }
+
+    const auto offset = buffer.size();
+    buffer.resize( offset + size + 1 );
+    std::snprintf( &buffer[ offset ], size + 1, specification.c_str(), value );
+    buffer.resize( offset + size );
+}
+
+u8* FormatItem::reserve( const std::size_t size )
+{
+    m_size = size;
+
+    if( size <= Inline )
+    {
+        return m_inline;
+    }
+
+    m_heap.reset( new u8[ size ] );
+    return m_heap.get();
+}
+
+const u8* FormatItem::arguments( void ) const
+{
+    return m_heap ? m_heap.get() : m_inline;
+}
+
+std::size_t FormatItem::size( void ) const
+{
+    return m_size;
+}
+
+const char* FormatItem::format( void ) const
+{
+    return m_format;
+}
+
+void FormatItem::text( std::string& buffer ) const
+{
+    text( m_format, arguments(), m_size, buffer );
+}
+
+u1 FormatItem::decode( const u8*& position, const u8* end, Value& value )
+{
+    if( position >= end )
+    {
+        return false;
+    }
+
+    value.argument = static_cast< Argument >( *position++ );
+    value.integer = 0;
+    value.floating = 0.0;
+    value.text = nullptr;
+    value.length = 0;
+
+    u1 valid = false;
+    switch( value.argument )
+    {
+        case Argument::SIGNED:
+        {
+            valid = load( position, end, value.integer );
+            value.floating = static_cast< double >( value.integer );
+            break;
+        }
+        case Argument::UNSIGNED:
+        {
+            u64 number = 0;
+            valid = load( position, end, number );
+            value.integer = static_cast< i64 >( number );
+            value.floating = static_cast< double >( number );
+            break;
+        }
+        case Argument::FLOATING:
+        {
+            valid = load( position, end, value.floating );
+            value.integer = static_cast< i64 >( value.floating );
+            break;
+        }
+        case Argument::POINTER:  // [[fallthrough]]
+        case Argument::BORROWED:
+        {
+            u64 address = 0;
+            valid = load( position, end, address );
+            value.integer = static_cast< i64 >( address );
+            value.text =
+                reinterpret_cast< const char* >( static_cast< std::uintptr_t >( address ) );
+
+            if( value.argument == Argument::BORROWED )
+            {
+                value.length = value.text ? static_cast< u32 >( std::strlen( value.text ) ) : 0;
+            }
+            break;
+        }
+        case Argument::STRING:
+        {
+            // the text is stored with its terminator, which has to be inside the buffer
+            valid = load( position, end, value.length ) and
+                    static_cast< std::size_t >( end - position ) > value.length and
+                    position[ value.length ] == '\0';
+
+            if( valid )
+            {
+                value.text = reinterpret_cast< const char* >( position );
+                position += value.length + 1;
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    if( not valid )
+    {
+        value.text = nullptr;
+        value.length = 0;
+        position = end;
+        return false;
+    }
+
+    return true;
+}
+
+void FormatItem::text(
+    const char* format, const u8* arguments, const std::size_t size, std::string& buffer )
+{
+    auto position = arguments;
+    const auto end = arguments + size;
+
+    std::string specification;
+    Value value;
+
+    for( auto character = format; *character != '\0'; character++ )
+    {
+        if( *character != '%' )
+        {
+            buffer += *character;
+            continue;
+        }
+
+        const auto begin = character++;
+
+        if( *character == '%' )
+        {
+            buffer += '%';
+            continue;
+        }
+
+        specification.assign( "%" );
+
+        // flags, width and precision, '*' consumes an argument
+        while( *character != '\0' and std::strchr( "-+ #0123456789.*", *character ) )
+        {
+            if( *character == '*' )
+            {
+                specification +=
+                    decode( position, end, value ) ? std::to_string( value.integer ) : "0";
+            }
+            else
+            {
+                specification += *character;
+            }
+            character++;
+        }
+
+        // length modifiers are replaced by the captured argument types
+        while( *character != '\0' and std::strchr( "hljztLq", *character ) )
+        {
+            character++;
+        }
+
+        const auto conversion = *character;
+
+        if( conversion == '\0' or not std::strchr( "diouxXeEfFgGaAcsp", conversion ) or
+            not decode( position, end, value ) )
+        {
+            // malformed specification or missing argument, keep it verbatim
+            buffer.append( begin, ( conversion == '\0' ? character : character + 1 ) - begin );
+
+            if( conversion == '\0' )
+            {
+                break;
+            }
+            continue;
+        }
+
+        switch( conversion )
+        {
+            case 'd':  // [[fallthrough]]
+            case 'i':
+            {
+                appendFormatted( buffer, specification + "ll" + conversion, value.integer );
+                break;
+            }
+            case 'o':  // [[fallthrough]]
+            case 'u':  // [[fallthrough]]
+            case 'x':  // [[fallthrough]]
+            case 'X':
+            {
+                appendFormatted(
+                    buffer,
+                    specification + "ll" + conversion,
+                    static_cast< unsigned long long >( value.integer ) );
+                break;
+            }
+            case 'c':
+            {
+                appendFormatted(
+                    buffer, specification + conversion, static_cast< int >( value.integer ) );
+                break;
+            }
+            case 's':
+            {
+                if( value.argument == Argument::STRING or value.argument == Argument::BORROWED )
+                {
+                    appendFormatted(
+                        buffer, specification + conversion, value.text ? value.text : "(null)" );
+                }
+                else if( value.argument == Argument::FLOATING )
+                {
+                    appendFormatted( buffer, specification + 'g', value.floating );
+                }
+                else
+                {
+                    appendFormatted( buffer, specification + "lld", value.integer );
+                }
+                break;
+            }
+            case 'p':
+            {
+                appendFormatted(
+                    buffer,
+                    specification + conversion,
+                    reinterpret_cast< const void* >( value.text ) );
+                break;
+            }
+            default:
+            {
+                appendFormatted( buffer, specification + conversion, value.floating );
+                break;
+            }
+        }
+    }
+}
+
+std::string FormatItem::text( void ) const
+{
+    std::string buffer;
+    text( buffer );
+    return buffer;
+}
+
+void FormatItem::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
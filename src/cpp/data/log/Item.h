@@ -46,6 +46,13 @@
 #include <libstdhl/List>
 #include <libstdhl/Type>
 
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <type_traits>
+
 /**
    @brief    TODO
 
@@ -75,6 +82,7 @@ namespace libstdhl
                 POSITION,
                 RANGE,
                 LOCATION,
+                FORMAT,
 
                 DATA,
                 LEVEL,
@@ -88,7 +96,16 @@ namespace libstdhl
 
             ID id( void ) const;
 
-            virtual std::string accept( Formatter& formatter ) = 0;
+            virtual void accept( Formatter& formatter, std::string& buffer ) const = 0;
+
+            std::string accept( Formatter& formatter ) const;
+
+          protected:
+            /**
+               process-wide handle for 'name' and 'description', handles are dense and
+               counted separately per item kind
+            */
+            static u32 intern( ID id, const std::string& name, const std::string& description );
 
           private:
             ID m_id;
@@ -101,13 +118,15 @@ namespace libstdhl
           public:
             TextItem( const std::string& text );
 
-            std::string text( void ) const;
+            const std::string& text( void ) const;
 
           private:
             std::string m_text;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
 
         class PositionItem : public Item
@@ -124,7 +143,9 @@ namespace libstdhl
             u64 m_column;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
 
         class RangeItem : public Item
@@ -141,7 +162,9 @@ namespace libstdhl
             PositionItem m_end;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
 
         class LocationItem : public Item
@@ -156,7 +179,7 @@ namespace libstdhl
                 const u64 endLine,
                 const u64 endColumn );
 
-            TextItem filename( void ) const;
+            const TextItem& filename( void ) const;
 
             RangeItem range( void ) const;
 
@@ -165,7 +188,214 @@ namespace libstdhl
             RangeItem m_range;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
+        };
+
+        /**
+           wraps a C string argument of a FormatItem which outlives the record and
+           therefore is not copied
+        */
+        struct Borrowed
+        {
+            const char* text;
+        };
+
+        inline Borrowed borrow( const char* text )
+        {
+            return Borrowed{ text };
+        }
+
+        /**
+           printf-style text whose arguments are captured raw and only formatted when
+           a formatter visits the item, e.g. on the sink thread or never if the record is
+           filtered out. The format string is borrowed and must outlive the record (e.g.
+           a string literal), C string arguments are copied unless passed as 'borrow'.
+        */
+        class FormatItem : public Item
+        {
+          public:
+            enum class Argument : u8
+            {
+                SIGNED,
+                UNSIGNED,
+                FLOATING,
+                POINTER,
+                STRING,
+                BORROWED,
+            };
+
+            static constexpr std::size_t Inline = 64;
+
+            template < typename... Args >
+            FormatItem( const char* format, const Args&... args )
+            : Item( Item::ID::FORMAT )
+            , m_format( format )
+            , m_size( 0 )
+            , m_heap()
+            {
+                std::size_t size = 0;
+                ( void )std::initializer_list< int >{ ( size += length( args ), 0 )... };
+
+                auto position = reserve( size );
+                ( void )std::initializer_list< int >{ ( encode( position, args ), 0 )... };
+            }
+
+            FormatItem( const FormatItem& ) = delete;
+
+            FormatItem& operator=( const FormatItem& ) = delete;
+
+            /**
+               a decoded argument, 'text' and 'length' are only set for strings
+            */
+            struct Value
+            {
+                Argument argument;
+                i64 integer;
+                double floating;
+                const char* text;
+                u32 length;
+            };
+
+            const char* format( void ) const;
+
+            /**
+               captured arguments in their raw encoding, see 'decode'
+            */
+            const u8* arguments( void ) const;
+
+            std::size_t size( void ) const;
+
+            void text( std::string& buffer ) const;
+
+            std::string text( void ) const;
+
+            /**
+               decodes the argument at 'position' and advances it, returns false and moves
+               'position' to 'end' if the argument is truncated or has an unknown tag
+            */
+            static u1 decode( const u8*& position, const u8* end, Value& value );
+
+            /**
+               formats 'format' with raw encoded arguments, e.g. a copy of 'arguments'
+               which outlived its item
+            */
+            static void text(
+                const char* format,
+                const u8* arguments,
+                const std::size_t size,
+                std::string& buffer );
+
+          private:
+            u8* reserve( const std::size_t size );
+
+            template < typename T >
+            static void store( u8*& position, const Argument argument, const T value )
+            {
+                *position++ = static_cast< u8 >( argument );
+                std::memcpy( position, &value, sizeof( value ) );
+                position += sizeof( value );
+            }
+
+            static std::size_t length( const char* value )
+            {
+                return 1 + sizeof( u32 ) + std::strlen( value ) + 1;
+            }
+
+            static std::size_t length( char* value )
+            {
+                return length( static_cast< const char* >( value ) );
+            }
+
+            static std::size_t length( const std::string& value )
+            {
+                return 1 + sizeof( u32 ) + value.size() + 1;
+            }
+
+            template < typename T >
+            static std::size_t length( const T& )
+            {
+                return 1 + 8;
+            }
+
+            static void encode( u8*& position, const char* value )
+            {
+                const auto size = static_cast< u32 >( std::strlen( value ) );
+                store( position, Argument::STRING, size );
+                std::memcpy( position, value, size + 1 );
+                position += size + 1;
+            }
+
+            static void encode( u8*& position, char* value )
+            {
+                encode( position, static_cast< const char* >( value ) );
+            }
+
+            static void encode( u8*& position, const std::string& value )
+            {
+                const auto size = static_cast< u32 >( value.size() );
+                store( position, Argument::STRING, size );
+                std::memcpy( position, value.c_str(), size + 1 );
+                position += size + 1;
+            }
+
+            static void encode( u8*& position, const Borrowed& value )
+            {
+                store( position, Argument::BORROWED, static_cast< u64 >(
+                    reinterpret_cast< std::uintptr_t >( value.text ) ) );
+            }
+
+            template < typename T >
+            static void encode( u8*& position, T* value )
+            {
+                store( position, Argument::POINTER, static_cast< u64 >(
+                    reinterpret_cast< std::uintptr_t >( value ) ) );
+            }
+
+            template < typename T >
+            static typename std::enable_if< std::is_floating_point< T >::value >::type encode(
+                u8*& position, const T value )
+            {
+                store( position, Argument::FLOATING, static_cast< double >( value ) );
+            }
+
+            template < typename T >
+            static typename std::enable_if<
+                std::is_integral< T >::value and std::is_signed< T >::value >::type
+            encode( u8*& position, const T value )
+            {
+                store( position, Argument::SIGNED, static_cast< i64 >( value ) );
+            }
+
+            template < typename T >
+            static typename std::enable_if<
+                std::is_integral< T >::value and not std::is_signed< T >::value >::type
+            encode( u8*& position, const T value )
+            {
+                store( position, Argument::UNSIGNED, static_cast< u64 >( value ) );
+            }
+
+            template < typename T >
+            static typename std::enable_if< std::is_enum< T >::value >::type encode(
+                u8*& position, const T value )
+            {
+                using Underlying = typename std::underlying_type< T >::type;
+                encode( position, static_cast< Underlying >( value ) );
+            }
+
+            const char* m_format;
+
+            std::size_t m_size;
+
+            u8 m_inline[ Inline ];
+
+            std::unique_ptr< u8[] > m_heap;
+
+          public:
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
     }
 }
@@ -60,9 +60,9 @@ Level::ID Level::id( void ) const
     return m_id;
 }
 
-std::string Level::accept( Formatter& formatter )
+void Level::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
@@ -112,7 +112,9 @@ namespace libstdhl
             ID m_id;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
 
         using Levels = std::vector< Level >;
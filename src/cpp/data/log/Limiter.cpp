@@ -0,0 +1,475 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Limiter.h"
+#include "Data.h"
+#include "Stream.h"
+
+#include <cassert>
+#include <stdexcept>
+
+using namespace libstdhl;
+using namespace Log;
+
+static u64 nanoseconds( const std::chrono::steady_clock::duration& duration )
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >( duration ).count();
+}
+
+static u64 now( void )
+{
+    return nanoseconds( std::chrono::steady_clock::now().time_since_epoch() );
+}
+
+//
+// Limiter::Rule
+//
+
+Limiter::Rule::Rule( void )
+: period( 0 )
+, tolerance( 0 )
+, arrival( 0 )
+, every( 0 )
+, counter( 0 )
+, suppressed( 0 )
+{
+}
+
+//
+// Limiter::Rules
+//
+
+Limiter::Rules::Table::Table( const std::size_t size )
+: size( size )
+, rules( new std::atomic< Rule* >[ size ] )
+{
+    for( std::size_t index = 0; index < size; index++ )
+    {
+        rules[ index ].store( nullptr, std::memory_order_relaxed );
+    }
+}
+
+Limiter::Rules::Rules( void )
+: m_table( nullptr )
+, m_tables()
+, m_rules()
+{
+    m_tables.emplace_back( new Table( 64 ) );
+    m_table.store( m_tables.back().get(), std::memory_order_relaxed );
+}
+
+Limiter::Rule* Limiter::Rules::find( const u32 handle ) const
+{
+    const auto table = m_table.load( std::memory_order_acquire );
+    if( handle >= table->size )
+    {
+        return nullptr;
+    }
+
+    return table->rules[ handle ].load( std::memory_order_acquire );
+}
+
+Limiter::Rule& Limiter::Rules::emplace( const u32 handle, u1& created )
+{
+    auto table = m_table.load( std::memory_order_relaxed );
+
+    if( handle >= table->size )
+    {
+        auto size = table->size;
+        while( size <= handle )
+        {
+            size *= 2;
+        }
+
+        std::unique_ptr< Table > grown( new Table( size ) );
+        for( std::size_t index = 0; index < table->size; index++ )
+        {
+            grown->rules[ index ].store(
+                table->rules[ index ].load( std::memory_order_relaxed ),
+                std::memory_order_relaxed );
+        }
+
+        table = grown.get();
+        m_tables.emplace_back( std::move( grown ) );
+        m_table.store( table, std::memory_order_release );
+    }
+
+    auto rule = table->rules[ handle ].load( std::memory_order_relaxed );
+    created = not rule;
+
+    if( created )
+    {
+        m_rules.emplace_back( new Rule() );
+        rule = m_rules.back().get();
+        table->rules[ handle ].store( rule, std::memory_order_release );
+    }
+
+    return *rule;
+}
+
+//
+// Limiter
+//
+
+Limiter::Limiter( void )
+: m_channel( nullptr )
+, m_sources()
+, m_categories()
+, m_mutex()
+, m_limitedSources()
+, m_limitedCategories()
+, m_interval( nanoseconds( std::chrono::seconds( 10 ) ) )
+, m_summary( now() )
+, m_pending( 0 )
+, m_suppressed( 0 )
+{
+}
+
+Channel::Ptr Limiter::channel( void ) const
+{
+    return m_channel;
+}
+
+void Limiter::setChannel( const Channel::Ptr& channel )
+{
+    assert( channel );
+    m_channel = channel;
+}
+
+static void setRate(
+    std::atomic< u64 >& period,
+    std::atomic< u64 >& tolerance,
+    const double rate,
+    const u32 burst )
+{
+    if( rate < 0.0 )
+    {
+        throw std::invalid_argument( "log limiter rate must not be negative" );
+    }
+
+    const u64 value = rate > 0.0 ? static_cast< u64 >( 1e9 / rate ) : 0;
+    tolerance.store( value * ( burst > 0 ? burst - 1 : 0 ), std::memory_order_relaxed );
+    period.store( value, std::memory_order_relaxed );
+}
+
+void Limiter::setRate( const Source::Ptr& source, const double rate, const u32 burst )
+{
+    assert( source );
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    u1 created = false;
+    auto& rule = m_sources.emplace( source->handle(), created );
+    ::setRate( rule.period, rule.tolerance, rate, burst );
+    rule.arrival.store( 0, std::memory_order_relaxed );
+
+    if( created )
+    {
+        m_limitedSources.emplace_back( source, &rule );
+    }
+}
+
+void Limiter::setRate( const Category::Ptr& category, const double rate, const u32 burst )
+{
+    assert( category );
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    u1 created = false;
+    auto& rule = m_categories.emplace( category->handle(), created );
+    ::setRate( rule.period, rule.tolerance, rate, burst );
+    rule.arrival.store( 0, std::memory_order_relaxed );
+
+    if( created )
+    {
+        m_limitedCategories.emplace_back( category, &rule );
+    }
+}
+
+void Limiter::setSampling( const Source::Ptr& source, const u32 every )
+{
+    assert( source );
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    u1 created = false;
+    auto& rule = m_sources.emplace( source->handle(), created );
+    rule.every.store( every, std::memory_order_relaxed );
+
+    if( created )
+    {
+        m_limitedSources.emplace_back( source, &rule );
+    }
+}
+
+void Limiter::setSampling( const Category::Ptr& category, const u32 every )
+{
+    assert( category );
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    u1 created = false;
+    auto& rule = m_categories.emplace( category->handle(), created );
+    rule.every.store( every, std::memory_order_relaxed );
+
+    if( created )
+    {
+        m_limitedCategories.emplace_back( category, &rule );
+    }
+}
+
+void Limiter::setInterval( const std::chrono::milliseconds interval )
+{
+    m_interval.store( nanoseconds( interval ), std::memory_order_relaxed );
+}
+
+std::chrono::milliseconds Limiter::interval( void ) const
+{
+    return std::chrono::duration_cast< std::chrono::milliseconds >(
+        std::chrono::nanoseconds( m_interval.load( std::memory_order_relaxed ) ) );
+}
+
+u64 Limiter::suppressed( void ) const
+{
+    return m_suppressed.load( std::memory_order_relaxed );
+}
+
+u1 Limiter::sample( Rule& rule )
+{
+    const auto every = rule.every.load( std::memory_order_relaxed );
+    return every <= 1 or rule.counter.fetch_add( 1, std::memory_order_relaxed ) % every == 0;
+}
+
+u1 Limiter::acquire( Rule& rule, const u64 now, u64& period )
+{
+    period = rule.period.load( std::memory_order_relaxed );
+    if( period == 0 )
+    {
+        return true;
+    }
+
+    // generic cell rate algorithm, a token bucket with a single atomic state
+    const auto tolerance = rule.tolerance.load( std::memory_order_relaxed );
+    auto arrival = rule.arrival.load( std::memory_order_relaxed );
+
+    while( true )
+    {
+        if( arrival > now + tolerance )
+        {
+            return false;
+        }
+
+        const auto next = ( arrival > now ? arrival : now ) + period;
+        if( rule.arrival.compare_exchange_weak( arrival, next, std::memory_order_relaxed ) )
+        {
+            return true;
+        }
+    }
+}
+
+void Limiter::release( Rule& rule, const u64 period )
+{
+    auto arrival = rule.arrival.load( std::memory_order_relaxed );
+
+    // the rate may have been reset in the meantime, never move before the epoch
+    while( arrival >= period and
+           not rule.arrival.compare_exchange_weak(
+               arrival, arrival - period, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+void Limiter::suppress( Rule& rule )
+{
+    rule.suppressed.fetch_add( 1, std::memory_order_relaxed );
+    m_pending.fetch_add( 1, std::memory_order_relaxed );
+    m_suppressed.fetch_add( 1, std::memory_order_relaxed );
+}
+
+u1 Limiter::admit( const Data& data )
+{
+    const auto source = m_sources.find( data.source()->handle() );
+    const auto category = m_categories.find( data.category()->handle() );
+
+    if( not source and not category )
+    {
+        return true;
+    }
+
+    for( auto rule : { source, category } )
+    {
+        if( rule and not sample( *rule ) )
+        {
+            suppress( *rule );
+            return false;
+        }
+    }
+
+    const auto time = now();
+    u64 period = 0;
+
+    if( source and not acquire( *source, time, period ) )
+    {
+        suppress( *source );
+        return false;
+    }
+
+    u64 unused = 0;
+    if( category and not acquire( *category, time, unused ) )
+    {
+        // the record is suppressed, the source token was not used
+        if( source and period > 0 )
+        {
+            release( *source, period );
+        }
+
+        suppress( *category );
+        return false;
+    }
+
+    return true;
+}
+
+void Limiter::summarize( Stream& stream )
+{
+    if( m_pending.exchange( 0, std::memory_order_relaxed ) == 0 )
+    {
+        return;
+    }
+
+    const auto message = []( const u64 count, const std::string& kind, const std::string& name ) {
+        return std::to_string( count ) + " messages suppressed for " + kind + " '" + name + "'";
+    };
+
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    for( const auto& limited : m_limitedSources )
+    {
+        const auto count = limited.second->suppressed.exchange( 0, std::memory_order_relaxed );
+
+        if( count > 0 )
+        {
+            stream.add(
+                Level::ID::WARNING,
+                limited.first,
+                Category::defaultCategory(),
+                message( count, "source", limited.first->name() ) );
+        }
+    }
+
+    for( const auto& limited : m_limitedCategories )
+    {
+        const auto count = limited.second->suppressed.exchange( 0, std::memory_order_relaxed );
+
+        if( count > 0 )
+        {
+            stream.add(
+                Level::ID::WARNING,
+                Source::defaultSource(),
+                limited.first,
+                message( count, "category", limited.first->name() ) );
+        }
+    }
+}
+
+void Limiter::process( const Stream& stream )
+{
+    if( not m_channel )
+    {
+        return;
+    }
+
+    const auto& data = stream.data();
+
+    Stream limited;
+    u1 copied = false;
+
+    for( std::size_t index = 0; index < data.size(); index++ )
+    {
+        if( admit( data[ index ] ) )
+        {
+            if( copied )
+            {
+                limited.data().emplace_back( data[ index ] );
+            }
+        }
+        else if( not copied )
+        {
+            limited.data().reserve( data.size() );
+            limited.data().insert( limited.data().end(), data.begin(), data.begin() + index );
+            copied = true;
+        }
+    }
+
+    if( m_pending.load( std::memory_order_relaxed ) > 0 )
+    {
+        const auto time = now();
+        auto summary = m_summary.load( std::memory_order_relaxed );
+
+        if( time - summary >= m_interval.load( std::memory_order_relaxed ) and
+            m_summary.compare_exchange_strong( summary, time, std::memory_order_relaxed ) )
+        {
+            if( not copied )
+            {
+                limited.data() = data;
+                copied = true;
+            }
+
+            summarize( limited );
+        }
+    }
+
+    if( not copied )
+    {
+        // every record passes, forward the stream itself without copying
+        m_channel->process( stream );
+    }
+    else if( not limited.data().empty() )
+    {
+        m_channel->process( limited );
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
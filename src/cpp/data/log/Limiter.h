@@ -0,0 +1,230 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_LIMITER_H_
+#define _LIBSTDHL_CPP_LOG_LIMITER_H_
+
+#include <libstdhl/data/log/Category>
+#include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Source>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        class Data;
+
+        /**
+           Rate limiting and sampling stage in front of another channel.
+
+           Every source and category can be limited to 'rate' records per second with a
+           burst of 'burst' records (token bucket) and sampled to every 'every'-th record.
+           A record passes if both its source and its category admit it. Admission is
+           lock-free and limits can be changed at runtime while records are processed.
+           Suppressed records are counted and reported as one warning record per limited
+           source or category with the first stream processed after 'interval' elapsed.
+        */
+        class Limiter final : public Channel
+        {
+          public:
+            using Ptr = std::shared_ptr< Limiter >;
+
+            Limiter( void );
+
+            Channel::Ptr channel( void ) const;
+
+            void setChannel( const Channel::Ptr& channel );
+
+            template < typename T, typename... Args >
+            typename T::Ptr set( Args&&... args )
+            {
+                const auto obj = std::make_shared< T >( std::forward< Args >( args )... );
+                setChannel( obj );
+                return obj;
+            }
+
+            /**
+               limits the source to 'rate' records per second, a rate of zero removes it
+            */
+            void setRate( const Source::Ptr& source, const double rate, const u32 burst = 1 );
+
+            void setRate( const Category::Ptr& category, const double rate, const u32 burst = 1 );
+
+            /**
+               passes only every 'every'-th record of the source, one or zero removes it
+            */
+            void setSampling( const Source::Ptr& source, const u32 every );
+
+            void setSampling( const Category::Ptr& category, const u32 every );
+
+            void setInterval( const std::chrono::milliseconds interval );
+
+            std::chrono::milliseconds interval( void ) const;
+
+            /**
+               total amount of suppressed records since construction
+            */
+            u64 suppressed( void ) const;
+
+            u1 admit( const Data& data );
+
+            /**
+               adds the pending suppression summary records to the stream
+            */
+            void summarize( Stream& stream );
+
+          private:
+            struct Rule
+            {
+                Rule( void );
+
+                std::atomic< u64 > period;
+                std::atomic< u64 > tolerance;
+                std::atomic< u64 > arrival;
+                std::atomic< u32 > every;
+                std::atomic< u64 > counter;
+                std::atomic< u64 > suppressed;
+            };
+
+            /**
+               grow-only table from interned handles to rules, lookups are lock-free and
+               modifications require the limiter mutex
+            */
+            class Rules
+            {
+              public:
+                Rules( void );
+
+                /**
+                   rule of the handle or nullptr if the handle is not limited
+                */
+                Rule* find( const u32 handle ) const;
+
+                /**
+                   rule of the handle, created if the handle is not limited yet
+                */
+                Rule& emplace( const u32 handle, u1& created );
+
+              private:
+                struct Table
+                {
+                    Table( const std::size_t size );
+
+                    const std::size_t size;
+                    std::unique_ptr< std::atomic< Rule* >[] > rules;
+                };
+
+                std::atomic< Table* > m_table;
+
+                /**
+                   the current and all replaced tables, which lock-free readers may still use
+                */
+                std::vector< std::unique_ptr< Table > > m_tables;
+
+                std::vector< std::unique_ptr< Rule > > m_rules;
+            };
+
+            u1 sample( Rule& rule );
+
+            /**
+               takes a token of the rule, 'period' is set to the amount to give back
+            */
+            u1 acquire( Rule& rule, const u64 now, u64& period );
+
+            void release( Rule& rule, const u64 period );
+
+            void suppress( Rule& rule );
+
+            Channel::Ptr m_channel;
+
+            Rules m_sources;
+
+            Rules m_categories;
+
+            std::mutex m_mutex;
+
+            std::vector< std::pair< Source::Ptr, Rule* > > m_limitedSources;
+
+            std::vector< std::pair< Category::Ptr, Rule* > > m_limitedCategories;
+
+            std::atomic< u64 > m_interval;
+
+            std::atomic< u64 > m_summary;
+
+            /**
+               records suppressed since the last summary
+            */
+            std::atomic< u64 > m_pending;
+
+            std::atomic< u64 > m_suppressed;
+
+          public:
+            void process( const Stream& stream ) override;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_LIMITER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -114,13 +114,19 @@ void libstdhl::Log::info( const char* format, ... )
 
 Logger::Logger( libstdhl::Log::Stream& stream )
 : m_stream( stream )
+, m_streamMutex()
 , m_source( Source::defaultSource() )
 , m_category( Category::defaultCategory() )
-, m_errors( 0 )
-, m_warnings( 0 )
+, m_threshold( Level::ID::DEBUG )
+, m_metrics( new Log::Metrics::Ptr( std::make_shared< Log::Metrics >() ) )
 {
 }
 
+Logger::~Logger( void )
+{
+    delete m_metrics.load( std::memory_order_relaxed );
+}
+
 void Logger::output( const std::string& text )
 {
     log( Log::Level::ID::OUTPUT, m_source, m_category, text );
@@ -136,11 +142,21 @@ void Logger::output( const char* format, ... )
 
 void Logger::error( const std::string& text )
 {
+    if( not enabled< Log::Level::ID::ERROR >() )
+    {
+        return;
+    }
+
     log( Log::Level::ID::ERROR, m_source, m_category, text );
 }
 
 void Logger::error( const char* format, ... )
 {
+    if( not enabled< Log::Level::ID::ERROR >() )
+    {
+        return;
+    }
+
     va_list args;
     va_start( args, format );
     c_log( Log::Level::ID::ERROR, format, args );
@@ -149,16 +165,27 @@ void Logger::error( const char* format, ... )
 
 u64 Logger::errors( void ) const
 {
-    return m_errors;
+    Epoch::Guard guard;
+    return ( *m_metrics.load( std::memory_order_acquire ) )->count( Log::Level::ID::ERROR );
 }
 
 void Logger::warning( const std::string& text )
 {
+    if( not enabled< Log::Level::ID::WARNING >() )
+    {
+        return;
+    }
+
     log( Log::Level::ID::WARNING, m_source, m_category, text );
 }
 
 void Logger::warning( const char* format, ... )
 {
+    if( not enabled< Log::Level::ID::WARNING >() )
+    {
+        return;
+    }
+
     va_list args;
     va_start( args, format );
     c_log( Log::Level::ID::WARNING, format, args );
@@ -167,16 +194,27 @@ void Logger::warning( const char* format, ... )
 
 u64 Logger::warnings( void ) const
 {
-    return m_warnings;
+    Epoch::Guard guard;
+    return ( *m_metrics.load( std::memory_order_acquire ) )->count( Log::Level::ID::WARNING );
 }
 
 void Logger::info( const std::string& text )
 {
+    if( not enabled< Log::Level::ID::INFORMATIONAL >() )
+    {
+        return;
+    }
+
     log( Log::Level::ID::INFORMATIONAL, m_source, m_category, text );
 }
 
 void Logger::info( const char* format, ... )
 {
+    if( not enabled< Log::Level::ID::INFORMATIONAL >() )
+    {
+        return;
+    }
+
     va_list args;
     va_start( args, format );
     c_log( Log::Level::ID::INFORMATIONAL, format, args );
@@ -185,31 +223,49 @@ void Logger::info( const char* format, ... )
 
 void Logger::hint( const std::string& text )
 {
+    if( not enabled< Log::Level::ID::NOTICE >() )
+    {
+        return;
+    }
+
     log( Log::Level::ID::NOTICE, m_source, m_category, text );
 }
 
 void Logger::hint( const char* format, ... )
 {
+    if( not enabled< Log::Level::ID::NOTICE >() )
+    {
+        return;
+    }
+
     va_list args;
     va_start( args, format );
     c_log( Log::Level::ID::NOTICE, format, args );
     va_end( args );
 }
 
-#ifndef NDEBUG
 void Logger::debug( const std::string& text )
 {
+    if( not enabled< Log::Level::ID::DEBUG >() )
+    {
+        return;
+    }
+
     log( Log::Level::ID::DEBUG, m_source, m_category, text );
 }
 
 void Logger::debug( const char* format, ... )
 {
+    if( not enabled< Log::Level::ID::DEBUG >() )
+    {
+        return;
+    }
+
     va_list args;
     va_start( args, format );
     c_log( Log::Level::ID::DEBUG, format, args );
     va_end( args );
 }
-#endif
 
 void Logger::c_log( Log::Level::ID level, const char* format, va_list args )
 {
@@ -223,6 +279,17 @@ Log::Stream& Logger::stream( void )
     return m_stream;
 }
 
+void Logger::flush( Log::Channel& channel )
+{
+    Log::Stream batch;
+    {
+        std::lock_guard< std::mutex > guard( m_streamMutex );
+        std::swap( batch.data(), m_stream.data() );
+    }
+
+    batch.flush( channel );
+}
+
 void Logger::setSource( const Log::Source::Ptr& source )
 {
     assert( source );
@@ -236,6 +303,7 @@ Source::Ptr Logger::source( void ) const
 
 void Logger::setCategory( const Log::Category::Ptr& category )
 {
+    assert( category );
     m_category = category;
 }
 
@@ -244,16 +312,37 @@ Category::Ptr Logger::category( void ) const
     return m_category;
 }
 
+void Logger::setThreshold( const Log::Level::ID level )
+{
+    m_threshold.store( level, std::memory_order_relaxed );
+}
+
+Log::Level::ID Logger::threshold( void ) const
+{
+    return m_threshold.load( std::memory_order_relaxed );
+}
+
+void Logger::setMetrics( const Log::Metrics::Ptr& metrics )
+{
+    assert( metrics );
+
+    // appending threads count under the stream lock, readers hold an epoch guard
+    std::lock_guard< std::mutex > guard( m_streamMutex );
+    const auto previous = m_metrics.exchange(
+        new Log::Metrics::Ptr( metrics ), std::memory_order_acq_rel );
+    Epoch::retire( previous );
+}
+
+Log::Metrics::Ptr Logger::metrics( void ) const
+{
+    Epoch::Guard guard;
+    return *m_metrics.load( std::memory_order_acquire );
+}
+
 void Logger::diagnostic( const Log::Data& data )
 {
-    if( data.level().id() == Log::Level::ID::ERROR )
-    {
-        m_errors++;
-    }
-    else if( data.level().id() == Log::Level::ID::WARNING )
-    {
-        m_warnings++;
-    }
+    ( *m_metrics.load( std::memory_order_relaxed ) )
+        ->increment( data.level().id(), data.category() );
 }
 
 //
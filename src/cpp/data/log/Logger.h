@@ -47,10 +47,12 @@
 #include <libstdhl/data/log/Category>
 #include <libstdhl/data/log/Channel>
 #include <libstdhl/data/log/Data>
+#include <libstdhl/data/log/Epoch>
 #include <libstdhl/data/log/Filter>
 #include <libstdhl/data/log/Formatter>
 #include <libstdhl/data/log/Item>
 #include <libstdhl/data/log/Level>
+#include <libstdhl/data/log/Metrics>
 #include <libstdhl/data/log/Router>
 #include <libstdhl/data/log/Sink>
 #include <libstdhl/data/log/Source>
@@ -58,23 +60,73 @@
 #include <libstdhl/data/log/Switch>
 #include <libstdhl/data/log/Timestamp>
 
+#include <atomic>
+#include <mutex>
+#include <string>
+
 /**
    @brief    TODO
 
    TODO
 */
 
+/**
+   compile-time level floor, calls of less severe levels are removed from the build,
+   e.g. '-DLIBSTDHL_LOG_FLOOR=WARNING' (output is never removed)
+*/
+#ifndef LIBSTDHL_LOG_FLOOR
+#ifndef NDEBUG
+#define LIBSTDHL_LOG_FLOOR DEBUG
+#else
+#define LIBSTDHL_LOG_FLOOR INFORMATIONAL
+#endif
+#endif
+
+/**
+   lazy logging, the arguments are only evaluated if the level is enabled, e.g.
+   'LIBSTDHL_LOG_INFO( log, "took %s", expensive().c_str() )'
+*/
+#define LIBSTDHL_LOG_IF( LOGGER, LEVEL, CALL )                         \
+    do                                                                \
+    {                                                                 \
+        if( ( LOGGER ).enabled< libstdhl::Log::Level::ID::LEVEL >() ) \
+        {                                                             \
+            ( LOGGER ).CALL;                                          \
+        }                                                             \
+    } while( false )
+
+#define LIBSTDHL_LOG_ERROR( LOGGER, ... ) LIBSTDHL_LOG_IF( LOGGER, ERROR, error( __VA_ARGS__ ) )
+#define LIBSTDHL_LOG_WARNING( LOGGER, ... ) \
+    LIBSTDHL_LOG_IF( LOGGER, WARNING, warning( __VA_ARGS__ ) )
+#define LIBSTDHL_LOG_HINT( LOGGER, ... ) LIBSTDHL_LOG_IF( LOGGER, NOTICE, hint( __VA_ARGS__ ) )
+#define LIBSTDHL_LOG_INFO( LOGGER, ... ) \
+    LIBSTDHL_LOG_IF( LOGGER, INFORMATIONAL, info( __VA_ARGS__ ) )
+#define LIBSTDHL_LOG_DEBUG( LOGGER, ... ) LIBSTDHL_LOG_IF( LOGGER, DEBUG, debug( __VA_ARGS__ ) )
+
 namespace libstdhl
 {
     /**
        @extends Stdhl
     */
 
+    /**
+       Appends records to a stream, any number of threads may log through one logger.
+
+       Appending is serialized per logger, therefore the stream itself must only be
+       accessed directly while no thread logs, 'flush' can be called at any time.
+       The source, category and metrics are configured before the logger is shared.
+    */
     class Logger
     {
       public:
         Logger( Log::Stream& stream );
 
+        ~Logger( void );
+
+        Logger( const Logger& ) = delete;
+
+        Logger& operator=( const Logger& ) = delete;
+
         void output( const std::string& text );
         void output( const char* format, ... );
 
@@ -92,23 +144,15 @@ namespace libstdhl
         void hint( const std::string& text );
         void hint( const char* format, ... );
 
-#ifndef NDEBUG
         void debug( const std::string& text );
         void debug( const char* format, ... );
-#else
-        inline void debug( const std::string& text )
-        {
-        }
-        inline void debug( const char* format, ... )
-        {
-        }
-#endif
 
         void c_log( Log::Level::ID level, const char* format, va_list args );
 
         template < typename... Args >
         void log( Args&&... args )
         {
+            std::lock_guard< std::mutex > guard( m_streamMutex );
             m_stream.add( std::forward< Args >( args )... );
             diagnostic( m_stream.data().back() );
         }
@@ -116,13 +160,88 @@ namespace libstdhl
         template < const Log::Level::ID LEVEL, typename... Args >
         void log( Args&&... args )
         {
-            m_stream.add(
-                LEVEL, source(), category(), Log::Items( { std::forward< Args >( args )... } ) );
+            if( not enabled< LEVEL >() )
+            {
+                return;
+            }
+
+            Log::Items items( { std::forward< Args >( args )... } );
+
+            std::lock_guard< std::mutex > guard( m_streamMutex );
+            m_stream.add( LEVEL, m_source, m_category, items );
+            diagnostic( m_stream.data().back() );
+        }
+
+        /**
+           deferred text logging, 'function' is only called if the level is enabled
+        */
+        template < const Log::Level::ID LEVEL, typename Function >
+        void lazy( Function&& function )
+        {
+            if( not enabled< LEVEL >() )
+            {
+                return;
+            }
+
+            const std::string text = function();
+
+            std::lock_guard< std::mutex > guard( m_streamMutex );
+            m_stream.add( LEVEL, m_source, m_category, text );
+            diagnostic( m_stream.data().back() );
+        }
+
+        /**
+           deferred printf-style logging, only the arguments are captured here and the
+           text is formatted when (and if) a formatter visits the record
+        */
+        template < const Log::Level::ID LEVEL, typename... Args >
+        void deferred( const char* format, const Args&... args )
+        {
+            if( not enabled< LEVEL >() )
+            {
+                return;
+            }
+
+            std::lock_guard< std::mutex > guard( m_streamMutex );
+            m_stream.add( LEVEL, m_source, m_category );
+            m_stream.data().back().add< Log::FormatItem >( format, args... );
             diagnostic( m_stream.data().back() );
         }
 
+        static constexpr Log::Level::ID Floor = Log::Level::ID::LIBSTDHL_LOG_FLOOR;
+
+        template < const Log::Level::ID LEVEL >
+        inline u1 enabled( void ) const
+        {
+            return LEVEL == Log::Level::ID::OUTPUT or ( LEVEL <= Floor and enabled( LEVEL ) );
+        }
+
+        inline u1 enabled( const Log::Level::ID level ) const
+        {
+            if( level == Log::Level::ID::OUTPUT )
+            {
+                return true;
+            }
+
+            return level <= m_threshold.load( std::memory_order_relaxed ) and
+                   level <= m_category->threshold();
+        }
+
+        /**
+           least severe level this logger emits, can be changed at runtime
+        */
+        void setThreshold( const Log::Level::ID level );
+
+        Log::Level::ID threshold( void ) const;
+
         Log::Stream& stream( void );
 
+        /**
+           flushes the records logged so far to 'channel' while other threads keep
+           logging into the stream
+        */
+        void flush( Log::Channel& channel );
+
         void setSource( const Log::Source::Ptr& source );
 
         Log::Source::Ptr source( void ) const;
@@ -131,14 +250,24 @@ namespace libstdhl
 
         Log::Category::Ptr category( void ) const;
 
+        /**
+           per level and category record counters, may be shared between loggers in
+           which case 'errors' and 'warnings' report the shared totals, replaced metrics
+           are released through Log::Epoch once no reader uses them anymore
+        */
+        void setMetrics( const Log::Metrics::Ptr& metrics );
+
+        Log::Metrics::Ptr metrics( void ) const;
+
       private:
         void diagnostic( const Log::Data& data );
 
         Log::Stream& m_stream;
+        std::mutex m_streamMutex;
         Log::Source::Ptr m_source;
         Log::Category::Ptr m_category;
-        u64 m_errors;
-        u64 m_warnings;
+        std::atomic< Log::Level::ID > m_threshold;
+        std::atomic< const Log::Metrics::Ptr* > m_metrics;
     };
 }
 
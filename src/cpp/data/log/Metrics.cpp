@@ -0,0 +1,304 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Metrics.h"
+
+#include <memory>
+
+using namespace libstdhl;
+using namespace Log;
+
+static constexpr std::size_t CacheLine = 64;
+
+static std::size_t stripe( void )
+{
+    static std::atomic< std::size_t > next( 0 );
+    static thread_local const std::size_t index =
+        next.fetch_add( 1, std::memory_order_relaxed ) % Metrics::Stripes;
+    return index;
+}
+
+//
+// Metrics::Block
+//
+
+Metrics::Block::Block( const std::size_t stride )
+: storage()
+, cells( nullptr )
+, known()
+, categories()
+{
+    std::size_t size = Stripes * stride * sizeof( std::atomic< u64 > ) + CacheLine;
+    storage.reset( new u8[ size ] );
+
+    void* memory = storage.get();
+    std::align( CacheLine, size - CacheLine, memory, size );
+    cells = static_cast< std::atomic< u64 >* >( memory );
+
+    for( std::size_t cell = 0; cell < Stripes * stride; cell++ )
+    {
+        new( &cells[ cell ] ) std::atomic< u64 >( 0 );
+    }
+
+    for( std::size_t row = 0; row < Rows; row++ )
+    {
+        known[ row ].store( false, std::memory_order_relaxed );
+    }
+}
+
+//
+// Metrics::Table
+//
+
+Metrics::Table::Table( const std::size_t size )
+: size( size )
+, blocks( new std::atomic< Block* >[ size ] )
+{
+    for( std::size_t index = 0; index < size; index++ )
+    {
+        blocks[ index ].store( nullptr, std::memory_order_relaxed );
+    }
+}
+
+//
+// Metrics
+//
+
+constexpr std::size_t Metrics::Stripes;
+constexpr std::size_t Metrics::Levels;
+constexpr std::size_t Metrics::Rows;
+
+Metrics::Metrics( const std::size_t categories )
+: m_stride( 0 )
+, m_table( nullptr )
+, m_tables()
+, m_blocks()
+, m_mutex()
+{
+    // round every stripe up to whole cache lines so no two stripes share one
+    const auto perLine = CacheLine / sizeof( std::atomic< u64 > );
+    m_stride = ( ( Levels * Rows + perLine - 1 ) / perLine ) * perLine;
+
+    m_tables.emplace_back( new Table( ( categories + Rows - 1 ) / Rows + 1 ) );
+    m_table.store( m_tables.back().get(), std::memory_order_relaxed );
+}
+
+void Metrics::increment( const Level::ID level, const Category::Ptr& category )
+{
+    const auto handle = category->handle();
+    const auto row = handle % Rows;
+
+    auto block = find( handle );
+    if( not block or not block->known[ row ].load( std::memory_order_acquire ) )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        block = &emplace( handle );
+        if( not block->categories[ row ] )
+        {
+            block->categories[ row ] = category;
+            block->known[ row ].store( true, std::memory_order_release );
+        }
+    }
+
+    const auto cell = stripe() * m_stride + static_cast< std::size_t >( level ) * Rows + row;
+    block->cells[ cell ].fetch_add( 1, std::memory_order_relaxed );
+}
+
+u64 Metrics::count( const Level::ID level ) const
+{
+    const auto table = m_table.load( std::memory_order_acquire );
+
+    u64 result = 0;
+    for( std::size_t index = 0; index < table->size; index++ )
+    {
+        const auto block = table->blocks[ index ].load( std::memory_order_acquire );
+        if( not block )
+        {
+            continue;
+        }
+
+        for( std::size_t row = 0; row < Rows; row++ )
+        {
+            result += sum( *block, static_cast< std::size_t >( level ) * Rows + row );
+        }
+    }
+    return result;
+}
+
+u64 Metrics::count( const Level::ID level, const Category& category ) const
+{
+    const auto block = find( category.handle() );
+    if( not block )
+    {
+        return 0;
+    }
+
+    return sum( *block, static_cast< std::size_t >( level ) * Rows + category.handle() % Rows );
+}
+
+Metrics::Samples Metrics::snapshot( void ) const
+{
+    Samples samples;
+
+    std::vector< Block* > blocks;
+    std::vector< Category::Ptr > categories;
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        const auto table = m_table.load( std::memory_order_relaxed );
+        for( std::size_t index = 0; index < table->size; index++ )
+        {
+            const auto block = table->blocks[ index ].load( std::memory_order_relaxed );
+            if( block )
+            {
+                blocks.emplace_back( block );
+                categories.insert(
+                    categories.end(), std::begin( block->categories ),
+                    std::end( block->categories ) );
+            }
+        }
+    }
+
+    for( std::size_t level = 0; level < Levels; level++ )
+    {
+        for( std::size_t index = 0; index < blocks.size(); index++ )
+        {
+            for( std::size_t row = 0; row < Rows; row++ )
+            {
+                const auto& category = categories[ index * Rows + row ];
+                const auto count = sum( *blocks[ index ], level * Rows + row );
+                if( category and count > 0 )
+                {
+                    samples.push_back(
+                        Sample{ static_cast< Level::ID >( level ), category, count } );
+                }
+            }
+        }
+    }
+
+    return samples;
+}
+
+void Metrics::reset( void )
+{
+    const auto table = m_table.load( std::memory_order_acquire );
+    for( std::size_t index = 0; index < table->size; index++ )
+    {
+        const auto block = table->blocks[ index ].load( std::memory_order_acquire );
+        if( not block )
+        {
+            continue;
+        }
+
+        for( std::size_t cell = 0; cell < Stripes * m_stride; cell++ )
+        {
+            block->cells[ cell ].store( 0, std::memory_order_relaxed );
+        }
+    }
+}
+
+Metrics::Block* Metrics::find( const u32 handle ) const
+{
+    const auto table = m_table.load( std::memory_order_acquire );
+    const auto index = handle / Rows;
+    if( index >= table->size )
+    {
+        return nullptr;
+    }
+
+    return table->blocks[ index ].load( std::memory_order_acquire );
+}
+
+Metrics::Block& Metrics::emplace( const u32 handle )
+{
+    const auto index = handle / Rows;
+    auto table = m_table.load( std::memory_order_relaxed );
+
+    if( index >= table->size )
+    {
+        auto size = table->size;
+        while( size <= index )
+        {
+            size *= 2;
+        }
+
+        std::unique_ptr< Table > grown( new Table( size ) );
+        for( std::size_t block = 0; block < table->size; block++ )
+        {
+            grown->blocks[ block ].store(
+                table->blocks[ block ].load( std::memory_order_relaxed ),
+                std::memory_order_relaxed );
+        }
+
+        table = grown.get();
+        m_tables.emplace_back( std::move( grown ) );
+        m_table.store( table, std::memory_order_release );
+    }
+
+    auto block = table->blocks[ index ].load( std::memory_order_relaxed );
+    if( not block )
+    {
+        m_blocks.emplace_back( new Block( m_stride ) );
+        block = m_blocks.back().get();
+        table->blocks[ index ].store( block, std::memory_order_release );
+    }
+
+    return *block;
+}
+
+u64 Metrics::sum( const Block& block, const std::size_t cell ) const
+{
+    u64 result = 0;
+    for( std::size_t stripe = 0; stripe < Stripes; stripe++ )
+    {
+        result += block.cells[ stripe * m_stride + cell ].load( std::memory_order_relaxed );
+    }
+    return result;
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,170 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_METRICS_H_
+#define _LIBSTDHL_CPP_LOG_METRICS_H_
+
+#include <libstdhl/Type>
+#include <libstdhl/data/log/Category>
+#include <libstdhl/data/log/Level>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        /**
+           Lock-free record counters broken down by level and category.
+
+           Every thread increments its own cache-line aligned stripe of counters, so the
+           hot path is a single uncontended relaxed add; reads aggregate all stripes.
+           Categories are indexed by their interned handle in blocks of 'Rows' categories,
+           which are allocated on first use, so every category gets its own counters.
+        */
+        class Metrics final
+        {
+          public:
+            using Ptr = std::shared_ptr< Metrics >;
+
+            static constexpr std::size_t Stripes = 8;
+
+            static constexpr std::size_t Levels =
+                static_cast< std::size_t >( Level::ID::OUTPUT ) + 1;
+
+            static constexpr std::size_t Rows = 8;
+
+            struct Sample
+            {
+                Level::ID level;
+                Category::Ptr category;
+
+                u64 count;
+            };
+
+            using Samples = std::vector< Sample >;
+
+            /**
+               'categories' is the initial capacity, the counters grow beyond it
+            */
+            Metrics( const std::size_t categories = 64 );
+
+            void increment( const Level::ID level, const Category::Ptr& category );
+
+            u64 count( const Level::ID level ) const;
+
+            u64 count( const Level::ID level, const Category& category ) const;
+
+            /**
+               all non-zero counters, ordered by level and category handle
+            */
+            Samples snapshot( void ) const;
+
+            void reset( void );
+
+          private:
+            struct Block
+            {
+                Block( const std::size_t stride );
+
+                std::unique_ptr< u8[] > storage;
+                std::atomic< u64 >* cells;
+                std::atomic< u1 > known[ Rows ];
+                Category::Ptr categories[ Rows ];
+            };
+
+            struct Table
+            {
+                Table( const std::size_t size );
+
+                const std::size_t size;
+                std::unique_ptr< std::atomic< Block* >[] > blocks;
+            };
+
+            /**
+               block of the handle or nullptr if it was never counted, lock-free
+            */
+            Block* find( const u32 handle ) const;
+
+            Block& emplace( const u32 handle );
+
+            u64 sum( const Block& block, const std::size_t cell ) const;
+
+            std::size_t m_stride;
+
+            std::atomic< Table* > m_table;
+
+            /**
+               the current and all replaced tables, which lock-free readers may still use
+            */
+            std::vector< std::unique_ptr< Table > > m_tables;
+
+            std::vector< std::unique_ptr< Block > > m_blocks;
+
+            mutable std::mutex m_mutex;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_METRICS_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
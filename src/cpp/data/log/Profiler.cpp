@@ -0,0 +1,410 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Profiler.h"
+#include "Data.h"
+#include "Source.h"
+
+#include <cassert>
+#include <unordered_map>
+
+using namespace libstdhl;
+using namespace Log;
+
+static thread_local Profiler::Node* profilerCurrent = nullptr;
+
+namespace
+{
+    /**
+       shards claimed by a thread, handed back when the thread exits
+    */
+    struct ProfilerShards
+    {
+        std::unordered_map< const Profiler::Node*, Profiler::Node::Shard* > shards;
+
+        ~ProfilerShards( void )
+        {
+            for( const auto& shard : shards )
+            {
+                shard.second->owned.store( false, std::memory_order_release );
+            }
+        }
+    };
+}
+
+static thread_local ProfilerShards profilerShards;
+
+static void report( Stream& stream, const Profiler::Node& node )
+{
+    const auto histogram = node.histogram();
+
+    if( histogram.count() > 0 )
+    {
+        std::string text( ( node.depth() - 1 ) * 2, ' ' );
+        text += node.name();
+        text += ": count=" + std::to_string( histogram.count() );
+        text += ", p50=" + std::to_string( histogram.percentile( 50.0 ) ) + "ns";
+        text += ", p99=" + std::to_string( histogram.percentile( 99.0 ) ) + "ns";
+        text += ", p999=" + std::to_string( histogram.percentile( 99.9 ) ) + "ns";
+        text += ", max=" + std::to_string( histogram.max() ) + "ns";
+
+        stream.add(
+            Level::ID::INFORMATIONAL,
+            Source::defaultSource(),
+            Profiler::defaultCategory(),
+            text );
+    }
+
+    for( const auto child : node.children() )
+    {
+        report( stream, *child );
+    }
+}
+
+static void reset( Profiler::Node& node )
+{
+    node.reset();
+
+    for( const auto child : node.children() )
+    {
+        reset( *child );
+    }
+}
+
+// Profiler::Node
+
+Profiler::Node::Node( const std::string& name, Node* parent )
+: m_name( name )
+, m_parent( parent )
+, m_generation( 0 )
+, m_mutex()
+, m_shards()
+, m_children()
+{
+}
+
+const std::string& Profiler::Node::name( void ) const
+{
+    return m_name;
+}
+
+Profiler::Node* Profiler::Node::parent( void ) const
+{
+    return m_parent;
+}
+
+std::size_t Profiler::Node::depth( void ) const
+{
+    return m_parent ? m_parent->depth() + 1 : 0;
+}
+
+Histogram Profiler::Node::histogram( void ) const
+{
+    Histogram merged;
+
+    std::lock_guard< std::mutex > guard( m_mutex );
+    const auto generation = m_generation.load( std::memory_order_acquire );
+
+    for( const auto& shard : m_shards )
+    {
+        // shards of an older generation are cleared by their owner on the next record
+        if( shard->generation.load( std::memory_order_acquire ) == generation )
+        {
+            merged.merge( shard->histogram );
+        }
+    }
+
+    return merged;
+}
+
+void Profiler::Node::reset( void )
+{
+    m_generation.fetch_add( 1, std::memory_order_acq_rel );
+}
+
+Profiler::Node::Shard& Profiler::Node::shard( void )
+{
+    auto& shards = profilerShards.shards;
+
+    const auto found = shards.find( this );
+    if( found != shards.end() )
+    {
+        return *found->second;
+    }
+
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    Shard* result = nullptr;
+    for( const auto& shard : m_shards )
+    {
+        u1 owned = false;
+        if( shard->owned.compare_exchange_strong( owned, true, std::memory_order_acquire ) )
+        {
+            result = shard.get();
+            break;
+        }
+    }
+
+    if( not result )
+    {
+        m_shards.emplace_back( new Shard() );
+        result = m_shards.back().get();
+        result->generation.store(
+            m_generation.load( std::memory_order_acquire ), std::memory_order_relaxed );
+        result->owned.store( true, std::memory_order_relaxed );
+    }
+
+    shards.emplace( this, result );
+    return *result;
+}
+
+void Profiler::Node::record( Shard& shard, const u64 duration )
+{
+    const auto generation = m_generation.load( std::memory_order_acquire );
+
+    if( shard.generation.load( std::memory_order_relaxed ) != generation )
+    {
+        shard.histogram.reset();
+        shard.generation.store( generation, std::memory_order_release );
+    }
+
+    shard.histogram.recordExclusive( duration );
+}
+
+Profiler::Node* Profiler::Node::child( const std::string& name )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    for( const auto& child : m_children )
+    {
+        if( child->name() == name )
+        {
+            return child.get();
+        }
+    }
+
+    m_children.emplace_back( new Node( name, this ) );
+    return m_children.back().get();
+}
+
+std::vector< Profiler::Node* > Profiler::Node::children( void ) const
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    std::vector< Node* > children;
+    children.reserve( m_children.size() );
+    for( const auto& child : m_children )
+    {
+        children.emplace_back( child.get() );
+    }
+    return children;
+}
+
+// Profiler::Site
+
+Profiler::Site::Site( const char* name )
+: m_name( name )
+, m_parent( nullptr )
+, m_node( nullptr )
+, m_shard( nullptr )
+{
+}
+
+Profiler::Node* Profiler::Site::resolve( Node* parent )
+{
+    if( parent != m_parent )
+    {
+        m_node = parent->child( m_name );
+        m_shard = &m_node->shard();
+        m_parent = parent;
+    }
+
+    return m_node;
+}
+
+Profiler::Node::Shard& Profiler::Site::shard( void ) const
+{
+    return *m_shard;
+}
+
+// Profiler::Scope
+
+Profiler::Scope::Scope( Site& site )
+: m_node( nullptr )
+, m_parent( &Profiler::current() )
+, m_shard( nullptr )
+, m_traced( false )
+, m_chronograph()
+{
+    m_node = site.resolve( m_parent );
+    m_shard = &site.shard();
+    profilerCurrent = m_node;
+    m_traced = Trace::enabled() and Trace::begin( m_node->name().c_str() );
+    m_chronograph.start();
+}
+
+Profiler::Scope::Scope( const std::string& name )
+: m_node( nullptr )
+, m_parent( &Profiler::current() )
+, m_shard( nullptr )
+, m_traced( false )
+, m_chronograph()
+{
+    m_node = m_parent->child( name );
+    m_shard = &m_node->shard();
+    profilerCurrent = m_node;
+    m_traced = Trace::enabled() and Trace::begin( m_node->name().c_str() );
+    m_chronograph.start();
+}
+
+Profiler::Scope::~Scope( void )
+{
+    m_chronograph.stop();
+    m_node->record( *m_shard, m_chronograph.duration().count() );
+
+    if( m_traced )
+    {
+        Trace::end( m_node->name().c_str() );
+    }
+
+    profilerCurrent = m_parent;
+}
+
+Profiler::Node& Profiler::Scope::node( void ) const
+{
+    return *m_node;
+}
+
+// Profiler::Reporter
+
+Profiler::Reporter::Reporter(
+    const Channel::Ptr& channel, const std::chrono::milliseconds interval, const u1 reset )
+: m_channel( channel )
+, m_interval( interval )
+, m_reset( reset )
+, m_mutex()
+, m_condition()
+, m_stop( false )
+, m_thread()
+{
+    assert( m_channel );
+    assert( m_interval.count() > 0 );
+
+    m_thread = std::thread( &Reporter::run, this );
+}
+
+Profiler::Reporter::~Reporter( void )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_stop = true;
+    }
+
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void Profiler::Reporter::run( void )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    while( not m_stop )
+    {
+        if( m_condition.wait_for( lock, m_interval, [this] { return m_stop; } ) )
+        {
+            return;
+        }
+
+        // the channel may block, the destructor must still be able to request a stop
+        lock.unlock();
+
+        Stream stream;
+        Profiler::report( stream );
+
+        if( m_reset )
+        {
+            Profiler::reset();
+        }
+
+        if( not stream.data().empty() )
+        {
+            stream.flush( *m_channel );
+        }
+
+        lock.lock();
+    }
+}
+
+// Profiler
+
+Profiler::Node& Profiler::root( void )
+{
+    static Node cache( "", nullptr );
+    return cache;
+}
+
+Profiler::Node& Profiler::current( void )
+{
+    return profilerCurrent ? *profilerCurrent : root();
+}
+
+void Profiler::report( Stream& stream )
+{
+    for( const auto child : root().children() )
+    {
+        ::report( stream, *child );
+    }
+}
+
+void Profiler::reset( void )
+{
+    ::reset( root() );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,275 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_PROFILER_H_
+#define _LIBSTDHL_CPP_LOG_PROFILER_H_
+
+#include <libstdhl/data/log/Category>
+#include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Chronograph>
+#include <libstdhl/data/log/Histogram>
+#include <libstdhl/data/log/Stream>
+#include <libstdhl/data/log/Trace>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+#define LIBSTDHL_PROFILE_CONCAT_( A, B ) A##B
+#define LIBSTDHL_PROFILE_CONCAT( A, B ) LIBSTDHL_PROFILE_CONCAT_( A, B )
+
+/**
+   times the enclosing block as a scope named 'NAME' (a string literal)
+*/
+#define LIBSTDHL_PROFILE( NAME )                                                               \
+    static thread_local libstdhl::Log::Profiler::Site LIBSTDHL_PROFILE_CONCAT(                 \
+        libstdhl_profile_site_, __LINE__ )( NAME );                                            \
+    libstdhl::Log::Profiler::Scope LIBSTDHL_PROFILE_CONCAT( libstdhl_profile_scope_, __LINE__ ) \
+    {                                                                                          \
+        LIBSTDHL_PROFILE_CONCAT( libstdhl_profile_site_, __LINE__ )                            \
+    }
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        /**
+           Process-wide call tree of named scopes with a latency histogram per node.
+
+           Every thread nests its scopes below the scope it currently executes, equally
+           named paths of different threads are merged into the same node. Nodes are
+           never released, therefore call sites can cache them per thread and an already
+           seen scope is entered without taking any lock. Every thread records into its
+           own histogram per node, which are only merged when a node is read. While a
+           Log::Trace is enabled, every scope is recorded into the trace timeline as well.
+        */
+        class Profiler final
+        {
+          public:
+            class Node final
+            {
+              public:
+                /**
+                   histogram of a single thread, handed over to another thread once its
+                   owner exited
+                */
+                struct Shard
+                {
+                    Histogram histogram;
+
+                    std::atomic< u64 > generation{ 0 };
+
+                    std::atomic< u1 > owned{ false };
+                };
+
+                Node( const std::string& name, Node* parent );
+
+                const std::string& name( void ) const;
+
+                Node* parent( void ) const;
+
+                std::size_t depth( void ) const;
+
+                /**
+                   snapshot of the records of all threads since the last reset
+                */
+                Histogram histogram( void ) const;
+
+                void reset( void );
+
+                /**
+                   histogram of the calling thread
+                */
+                Shard& shard( void );
+
+                void record( Shard& shard, const u64 duration );
+
+                Node* child( const std::string& name );
+
+                std::vector< Node* > children( void ) const;
+
+              private:
+                const std::string m_name;
+
+                Node* const m_parent;
+
+                std::atomic< u64 > m_generation;
+
+                mutable std::mutex m_mutex;
+
+                std::vector< std::unique_ptr< Shard > > m_shards;
+
+                std::vector< std::unique_ptr< Node > > m_children;
+            };
+
+            /**
+               per-thread call site cache of the last resolved parent and node
+            */
+            class Site final
+            {
+              public:
+                Site( const char* name );
+
+                Node* resolve( Node* parent );
+
+                Node::Shard& shard( void ) const;
+
+              private:
+                const char* m_name;
+
+                Node* m_parent;
+
+                Node* m_node;
+
+                Node::Shard* m_shard;
+            };
+
+            class Scope final
+            {
+              public:
+                Scope( Site& site );
+
+                Scope( const std::string& name );
+
+                ~Scope( void );
+
+                Scope( const Scope& ) = delete;
+
+                Scope& operator=( const Scope& ) = delete;
+
+                Node& node( void ) const;
+
+              private:
+                Node* m_node;
+
+                Node* m_parent;
+
+                Node::Shard* m_shard;
+
+                u1 m_traced;
+
+                Chronograph m_chronograph;
+            };
+
+            /**
+               reports all recorded scopes of the profiler periodically to a channel
+            */
+            class Reporter final
+            {
+              public:
+                Reporter(
+                    const Channel::Ptr& channel,
+                    const std::chrono::milliseconds interval,
+                    const u1 reset = false );
+
+                ~Reporter( void );
+
+              private:
+                void run( void );
+
+                const Channel::Ptr m_channel;
+
+                const std::chrono::milliseconds m_interval;
+
+                const u1 m_reset;
+
+                std::mutex m_mutex;
+
+                std::condition_variable m_condition;
+
+                u1 m_stop;
+
+                std::thread m_thread;
+            };
+
+            static Node& root( void );
+
+            /**
+               node of the innermost scope the calling thread is executing
+            */
+            static Node& current( void );
+
+            /**
+               adds one informational record per recorded node in depth-first order
+            */
+            static void report( Stream& stream );
+
+            /**
+               clears all histograms, the call tree itself is kept, every thread clears its
+               own histogram when it records the next time
+            */
+            static void reset( void );
+
+            static Category::Ptr defaultCategory( void )
+            {
+                static auto cache =
+                    std::make_shared< Category >( "Profiler", "Scope latency report of libstdhl" );
+                return cache;
+            }
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_PROFILER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -40,6 +40,7 @@
 //
 
 #include "Router.h"
+#include "Stream.h"
 
 #include <cassert>
 
@@ -51,26 +52,49 @@ using namespace Log;
 //
 
 Router::Router( void )
+: m_fanout()
 {
 }
 
 Filters Router::filters( void ) const
 {
-    return m_filters;
+    Filters filters;
+    for( const auto& channel : m_fanout.channels() )
+    {
+        filters.add( std::static_pointer_cast< Filter >( channel ) );
+    }
+    return filters;
 }
 
 void Router::addFilter( const Filter::Ptr& filter )
 {
     assert( filter );
-    m_filters.add( filter );
+    m_fanout.add( filter );
 }
 
-void Router::process( Stream& stream )
+void Router::removeFilter( const Filter::Ptr& filter )
 {
-    for( auto filter : m_filters )
-    {
-        filter->process( stream );
-    }
+    m_fanout.remove( filter );
+}
+
+void Router::setParallel( const u1 enable, const std::size_t capacity )
+{
+    m_fanout.setParallel( enable, capacity );
+}
+
+u1 Router::parallel( void ) const
+{
+    return m_fanout.parallel();
+}
+
+void Router::wait( void )
+{
+    m_fanout.wait();
+}
+
+void Router::process( const Stream& stream )
+{
+    m_fanout.process( stream );
 }
 
 //
@@ -44,6 +44,7 @@
 #define _LIBSTDHL_CPP_LOG_ROUTER_H_
 
 #include <libstdhl/data/log/Filter>
+#include <libstdhl/data/log/Worker>
 
 /**
    @brief    TODO
@@ -69,6 +70,11 @@ namespace libstdhl
 
             void addFilter( const Filter::Ptr& filter );
 
+            /**
+               returns once the worker of the filter processed its pending batches
+            */
+            void removeFilter( const Filter::Ptr& filter );
+
             template < typename T, typename... Args >
             typename T::Ptr add( Args&&... args )
             {
@@ -77,11 +83,27 @@ namespace libstdhl
                 return obj;
             }
 
+            /**
+               enables the parallel fan-out mode, where every filter consumes an immutable
+               snapshot of the processed stream on its own worker with a queue of 'capacity'
+               batches, a slow filter no longer delays the others, replaced workers are
+               drained before the call returns
+            */
+            void setParallel( const u1 enable, const std::size_t capacity = 64 );
+
+            u1 parallel( void ) const;
+
+            /**
+               blocks until all filters processed the batches submitted so far and
+               rethrows the first exception one of them raised
+            */
+            void wait( void );
+
           private:
-            Filters m_filters;
+            Fanout m_fanout;
 
           public:
-            void process( Stream& stream ) override;
+            void process( const Stream& stream ) override;
         };
     }
 }
@@ -40,9 +40,39 @@
 //
 
 #include "Sink.h"
+#include "Formatter.h"
 #include "Stream.h"
 
-#include <iostream>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+#if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
+#include <io.h>
+#include <sys/stat.h>
+#define FILE_OPEN_APPEND( NAME ) \
+    _open( NAME, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE )
+#define FILE_OPEN_MAPPED( NAME ) -1
+#define FILE_WRITE( FILE, DATA, LENGTH ) _write( FILE, DATA, static_cast< unsigned >( LENGTH ) )
+#define FILE_SYNC( FILE ) _commit( FILE )
+#define FILE_CLOSE( FILE ) _close( FILE )
+using FileStatus = struct _stat;
+#define FILE_STATUS( FILE, STATUS ) _fstat( FILE, STATUS )
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FILE_OPEN_APPEND( NAME ) ::open( NAME, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 )
+#define FILE_OPEN_MAPPED( NAME ) ::open( NAME, O_RDWR | O_CREAT | O_CLOEXEC, 0644 )
+#define FILE_WRITE( FILE, DATA, LENGTH ) ::write( FILE, DATA, LENGTH )
+#define FILE_SYNC( FILE ) ::fsync( FILE )
+#define FILE_CLOSE( FILE ) ::close( FILE )
+using FileStatus = struct stat;
+#define FILE_STATUS( FILE, STATUS ) ::fstat( FILE, STATUS )
+#endif
 
 using namespace libstdhl;
 using namespace Log;
@@ -57,14 +87,402 @@ OutputStreamSink::OutputStreamSink( std::ostream& stream, Formatter& formatter )
 {
 }
 
-void OutputStreamSink::process( Stream& stream )
+void OutputStreamSink::process( const Stream& stream )
+{
+    m_buffer.clear();
+
+    for( auto& data : stream.data() )
+    {
+        data.accept( m_formatter, m_buffer );
+        m_buffer += "\n";
+    }
+
+    m_stream.write( m_buffer.data(), m_buffer.size() );
+}
+
+// FileSink
+
+FileSink::FileSink( const std::string& filename, Formatter& formatter )
+: m_filename( filename )
+, m_formatter( formatter )
+, m_buffer()
+, m_records()
+, m_maxSize( 0 )
+, m_maxAge( 0 )
+, m_maxFiles( 1 )
+, m_sync( Sync::ROTATE )
+, m_segment( 0 )
+, m_file( -1 )
+, m_size( 0 )
+, m_opened()
+, m_mapping( nullptr )
+, m_mappingOffset( 0 )
+{
+    open();
+}
+
+FileSink::~FileSink( void )
+{
+    try
+    {
+        close();
+    }
+    catch( const std::domain_error& )
+    {
+        // the file is closed nevertheless and a destructor must not throw
+    }
+}
+
+std::string FileSink::filename( void ) const
+{
+    return m_filename;
+}
+
+void FileSink::setMaxSize( const u64 bytes )
+{
+    m_maxSize = bytes;
+}
+
+void FileSink::setMaxAge( const std::chrono::seconds age )
+{
+    m_maxAge = age;
+}
+
+void FileSink::setMaxFiles( const std::size_t files )
+{
+    m_maxFiles = files;
+}
+
+void FileSink::setSync( const Sync sync )
+{
+    m_sync = sync;
+}
+
+void FileSink::setMemoryMapped( const u1 enable, const std::size_t segment )
+{
+#if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
+    if( enable )
+    {
+        throw std::domain_error( "memory-mapped log files are not supported on this platform" );
+    }
+#else
+    const auto page = static_cast< std::size_t >( sysconf( _SC_PAGESIZE ) );
+    if( enable and ( segment == 0 or segment % page != 0 ) )
+    {
+        throw std::invalid_argument(
+            "memory-mapped log segment size '" + std::to_string( segment ) +
+            "' is not a multiple of the page size" );
+    }
+#endif
+
+    std::exception_ptr error;
+    try
+    {
+        close();
+    }
+    catch( const std::domain_error& )
+    {
+        error = std::current_exception();
+    }
+
+    m_segment = enable ? segment : 0;
+    open();
+
+    if( error )
+    {
+        std::rethrow_exception( error );
+    }
+}
+
+u64 FileSink::size( void ) const
+{
+    return m_size;
+}
+
+void FileSink::rotate( void )
+{
+    // a failed close is reported after the sink is usable again
+    std::exception_ptr error;
+    try
+    {
+        close();
+    }
+    catch( const std::domain_error& )
+    {
+        error = std::current_exception();
+    }
+
+    // missing older files are expected, every other failure keeps the live file growing
+    u1 rotated = true;
+
+    if( m_maxFiles == 0 )
+    {
+        rotated = std::remove( m_filename.c_str() ) == 0 or errno == ENOENT;
+    }
+    else
+    {
+        for( auto index = m_maxFiles; index > 1; index-- )
+        {
+            const auto older = m_filename + "." + std::to_string( index - 1 );
+            const auto newer = m_filename + "." + std::to_string( index );
+            if( std::rename( older.c_str(), newer.c_str() ) != 0 and errno != ENOENT )
+            {
+                rotated = false;
+            }
+        }
+
+        const auto target = m_filename + ".1";
+        if( std::rename( m_filename.c_str(), target.c_str() ) != 0 )
+        {
+            rotated = false;
+        }
+    }
+
+    open();
+
+    if( error )
+    {
+        std::rethrow_exception( error );
+    }
+
+    if( not rotated )
+    {
+        throw std::domain_error( "unable to rotate log file '" + m_filename + "'" );
+    }
+}
+
+void FileSink::open( void )
+{
+    assert( m_file < 0 );
+
+    m_file = m_segment > 0 ? FILE_OPEN_MAPPED( m_filename.c_str() )
+                           : FILE_OPEN_APPEND( m_filename.c_str() );
+
+    if( m_file < 0 )
+    {
+        throw std::domain_error( "unable to open log file '" + m_filename + "'" );
+    }
+
+    FileStatus status;
+    if( FILE_STATUS( m_file, &status ) != 0 )
+    {
+        FILE_CLOSE( m_file );
+        m_file = -1;
+        throw std::domain_error( "unable to query log file '" + m_filename + "'" );
+    }
+
+    m_size = status.st_size;
+    m_opened = std::chrono::steady_clock::now();
+
+    if( m_segment > 0 )
+    {
+        map();
+    }
+}
+
+void FileSink::close( void )
+{
+    if( m_file < 0 )
+    {
+        return;
+    }
+
+    u1 truncated = true;
+
+#if not( defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 ) )
+    if( m_segment > 0 )
+    {
+        unmap();
+
+        // drop the unused tail of the last segment
+        truncated = ::ftruncate( m_file, m_size ) == 0;
+    }
+#endif
+
+    if( m_sync != Sync::NONE )
+    {
+        FILE_SYNC( m_file );
+    }
+
+    FILE_CLOSE( m_file );
+    m_file = -1;
+
+    if( not truncated )
+    {
+        throw std::domain_error( "unable to truncate log file '" + m_filename + "'" );
+    }
+}
+
+void FileSink::map( void )
+{
+#if not( defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 ) )
+    assert( not m_mapping and m_segment > 0 );
+
+    m_mappingOffset = m_size - ( m_size % m_segment );
+
+    if( ::ftruncate( m_file, m_mappingOffset + m_segment ) != 0 )
+    {
+        throw std::domain_error( "unable to extend log file '" + m_filename + "'" );
+    }
+
+    auto mapping =
+        ::mmap( nullptr, m_segment, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, m_mappingOffset );
+
+    if( mapping == MAP_FAILED )
+    {
+        throw std::domain_error( "unable to map log file '" + m_filename + "'" );
+    }
+
+    m_mapping = static_cast< char* >( mapping );
+#endif
+}
+
+void FileSink::unmap( void )
+{
+#if not( defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 ) )
+    if( m_mapping )
+    {
+        if( m_sync != Sync::NONE )
+        {
+            ::msync( m_mapping, m_segment, MS_SYNC );
+        }
+
+        ::munmap( m_mapping, m_segment );
+        m_mapping = nullptr;
+    }
+#endif
+}
+
+void FileSink::write( const char* data, std::size_t length )
+{
+    if( m_segment > 0 )
+    {
+        while( length > 0 )
+        {
+            auto position = m_size - m_mappingOffset;
+
+            // a failed 'map' leaves no mapping behind, it is retried by the next write
+            if( not m_mapping or position == m_segment )
+            {
+                unmap();
+                map();
+                position = m_size - m_mappingOffset;
+            }
+
+            const auto chunk = std::min< std::size_t >( length, m_segment - position );
+            std::memcpy( m_mapping + position, data, chunk );
+
+            data += chunk;
+            length -= chunk;
+            m_size += chunk;
+        }
+
+        return;
+    }
+
+    while( length > 0 )
+    {
+        const auto written = FILE_WRITE( m_file, data, length );
+
+        if( written < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            throw std::domain_error( "unable to write to log file '" + m_filename + "'" );
+        }
+
+        data += written;
+        length -= written;
+        m_size += written;
+    }
+}
+
+void FileSink::process( const Stream& stream )
 {
-    for( auto data : stream.data() )
+    // a failed rotation keeps the batch in the live file and is reported afterwards
+    std::exception_ptr error;
+    const auto rotateOnce = [this, &error]() {
+        if( error )
+        {
+            return;
+        }
+
+        try
+        {
+            rotate();
+        }
+        catch( const std::domain_error& )
+        {
+            error = std::current_exception();
+        }
+    };
+
+    if( m_maxAge.count() > 0 and m_size > 0 and
+        std::chrono::steady_clock::now() - m_opened >= m_maxAge )
+    {
+        rotateOnce();
+    }
+
+    m_buffer.clear();
+    m_records.clear();
+
+    for( auto& data : stream.data() )
+    {
+        data.accept( m_formatter, m_buffer );
+        m_buffer += "\n";
+        m_records.emplace_back( m_buffer.size() );
+    }
+
+    std::size_t start = 0;
+
+    if( m_maxSize > 0 )
+    {
+        std::size_t begin = 0;
+
+        for( const auto end : m_records )
+        {
+            const auto pending = end - start;
+
+            if( m_size + pending > m_maxSize and ( begin > start or m_size > 0 ) )
+            {
+                write( m_buffer.data() + start, begin - start );
+                rotateOnce();
+                start = begin;
+            }
+
+            begin = end;
+        }
+    }
+
+    write( m_buffer.data() + start, m_buffer.size() - start );
+
+    if( m_sync == Sync::BATCH )
     {
-        m_stream << data.accept( m_formatter ) << "\n";
+#if not( defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 ) )
+        if( m_mapping )
+        {
+            ::msync( m_mapping, m_segment, MS_SYNC );
+        }
+#endif
+        FILE_SYNC( m_file );
+    }
+
+    if( error )
+    {
+        std::rethrow_exception( error );
     }
 }
 
+#undef FILE_OPEN_APPEND
+#undef FILE_OPEN_MAPPED
+#undef FILE_WRITE
+#undef FILE_SYNC
+#undef FILE_CLOSE
+#undef FILE_STATUS
+
 //
 //  Local variables:
 //  mode: c++
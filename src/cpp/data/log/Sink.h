@@ -45,6 +45,8 @@
 
 #include <libstdhl/data/log/Channel>
 
+#include <chrono>
+
 /**
    @brief    TODO
 
@@ -70,8 +72,112 @@ namespace libstdhl
 
             Formatter& m_formatter;
 
+            std::string m_buffer;
+
+          public:
+            void process( const Stream& stream ) override;
+        };
+
+        /**
+           Appends formatted records to a file with rename-based size and time rotation.
+
+           Every batch is formatted into one reused buffer and written with a single
+           system call per file segment. Rotation renames 'file' to 'file.1' (and shifts
+           older files up to 'file.<files>'), so no line is lost or copied. If a rename
+           fails, the batch is appended to the live file and std::domain_error is thrown
+           afterwards.
+
+           In the memory-mapped mode the file grows in fixed-size segments which are
+           mapped and filled by memcpy, the file is truncated to its real size on
+           rotation and destruction. A failed truncation is thrown as std::domain_error
+           once the next file is open, it is ignored on destruction.
+        */
+        class FileSink final : public Channel
+        {
+          public:
+            using Ptr = std::shared_ptr< FileSink >;
+
+            enum class Sync
+            {
+                NONE,    // leave flushing to the operating system
+                ROTATE,  // sync when a file is rotated or closed
+                BATCH,   // sync after every processed batch
+            };
+
+            FileSink( const std::string& filename, Formatter& formatter );
+
+            ~FileSink( void );
+
+            std::string filename( void ) const;
+
+            /**
+               rotate before a file exceeds 'bytes' (0 disables size rotation)
+            */
+            void setMaxSize( const u64 bytes );
+
+            /**
+               rotate a file after it was open for 'age' (0 disables time rotation)
+            */
+            void setMaxAge( const std::chrono::seconds age );
+
+            /**
+               number of rotated files to keep
+            */
+            void setMaxFiles( const std::size_t files );
+
+            void setSync( const Sync sync );
+
+            /**
+               enables the memory-mapped mode with segments of 'segment' bytes, which has
+               to be a multiple of the page size
+            */
+            void setMemoryMapped( const u1 enable, const std::size_t segment = 1 << 20 );
+
+            u64 size( void ) const;
+
+            void rotate( void );
+
+          private:
+            void open( void );
+
+            void close( void );
+
+            void write( const char* data, std::size_t length );
+
+            void map( void );
+
+            void unmap( void );
+
+            const std::string m_filename;
+
+            Formatter& m_formatter;
+
+            std::string m_buffer;
+
+            std::vector< std::size_t > m_records;
+
+            u64 m_maxSize;
+
+            std::chrono::seconds m_maxAge;
+
+            std::size_t m_maxFiles;
+
+            Sync m_sync;
+
+            std::size_t m_segment;
+
+            i32 m_file;
+
+            u64 m_size;
+
+            std::chrono::steady_clock::time_point m_opened;
+
+            char* m_mapping;
+
+            u64 m_mappingOffset;
+
           public:
-            void process( Stream& stream ) override;
+            void process( const Stream& stream ) override;
         };
     }
 }
@@ -53,22 +53,28 @@ Source::Source( const std::string& name, const std::string& description )
 : Item( Item::ID::SOURCE )
 , m_name( name )
 , m_description( description )
+, m_handle( intern( Item::ID::SOURCE, name, description ) )
 {
 }
 
-std::string Source::name( void ) const
+const std::string& Source::name( void ) const
 {
     return m_name;
 }
 
-std::string Source::description( void ) const
+const std::string& Source::description( void ) const
 {
     return m_description;
 }
 
-std::string Source::accept( Formatter& formatter )
+u32 Source::handle( void ) const
 {
-    return formatter.visit( *this );
+    return m_handle;
+}
+
+void Source::accept( Formatter& formatter, std::string& buffer ) const
+{
+    formatter.append( buffer, *this );
 }
 
 //
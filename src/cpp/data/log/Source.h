@@ -67,21 +67,19 @@ namespace libstdhl
 
             Source( const std::string& name, const std::string& description );
 
-            std::string name( void ) const;
+            const std::string& name( void ) const;
 
-            std::string description( void ) const;
+            const std::string& description( void ) const;
+
+            /**
+               process-wide interned handle, equal for all sources with the same name and
+               description, used for allocation-free matching and lookups
+            */
+            u32 handle( void ) const;
 
             inline u1 operator==( const Source& rhs ) const
             {
-                if( this != &rhs )
-                {
-                    if( ( this->name().compare( rhs.name() ) != 0 ) or
-                        ( this->description().compare( rhs.description() ) != 0 ) )
-                    {
-                        return false;
-                    }
-                }
-                return true;
+                return this->handle() == rhs.handle();
             }
 
             inline u1 operator!=( const Source& rhs ) const
@@ -94,8 +92,12 @@ namespace libstdhl
 
             std::string m_description;
 
+            u32 m_handle;
+
           public:
-            std::string accept( Formatter& formatter ) override;
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
 
             static Source::Ptr defaultSource( void )
             {
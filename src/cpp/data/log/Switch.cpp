@@ -40,6 +40,7 @@
 //
 
 #include "Switch.h"
+#include "Stream.h"
 
 #include <cassert>
 
@@ -51,26 +52,44 @@ using namespace Log;
 //
 
 Switch::Switch( void )
+: m_fanout()
 {
 }
 
 Channels Switch::channels( void ) const
 {
-    return m_channels;
+    return m_fanout.channels();
 }
 
 void Switch::addChannel( const Channel::Ptr& channel )
 {
     assert( channel );
-    m_channels.add( channel );
+    m_fanout.add( channel );
 }
 
-void Switch::process( Stream& stream )
+void Switch::removeChannel( const Channel::Ptr& channel )
 {
-    for( auto channel : m_channels )
-    {
-        channel->process( stream );
-    }
+    m_fanout.remove( channel );
+}
+
+void Switch::setParallel( const u1 enable, const std::size_t capacity )
+{
+    m_fanout.setParallel( enable, capacity );
+}
+
+u1 Switch::parallel( void ) const
+{
+    return m_fanout.parallel();
+}
+
+void Switch::wait( void )
+{
+    m_fanout.wait();
+}
+
+void Switch::process( const Stream& stream )
+{
+    m_fanout.process( stream );
 }
 
 //
@@ -44,6 +44,7 @@
 #define _LIBSTDHL_CPP_LOG_SWITCH_H_
 
 #include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Worker>
 
 /**
    @brief    TODO
@@ -69,6 +70,11 @@ namespace libstdhl
 
             void addChannel( const Channel::Ptr& channel );
 
+            /**
+               returns once the worker of the channel processed its pending batches
+            */
+            void removeChannel( const Channel::Ptr& channel );
+
             template < typename T, typename... Args >
             typename T::Ptr add( Args&&... args )
             {
@@ -77,11 +83,27 @@ namespace libstdhl
                 return obj;
             }
 
+            /**
+               enables the parallel fan-out mode, where every channel consumes an immutable
+               snapshot of the processed stream on its own worker with a queue of 'capacity'
+               batches, a slow channel no longer delays the others, replaced workers are
+               drained before the call returns
+            */
+            void setParallel( const u1 enable, const std::size_t capacity = 64 );
+
+            u1 parallel( void ) const;
+
+            /**
+               blocks until all channels processed the batches submitted so far and
+               rethrows the first exception one of them raised
+            */
+            void wait( void );
+
           private:
-            Channels m_channels;
+            Fanout m_fanout;
 
           public:
-            void process( Stream& stream ) override;
+            void process( const Stream& stream ) override;
         };
     }
 }
@@ -43,6 +43,8 @@
 
 #include "Formatter.h"
 
+#include <atomic>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 
@@ -51,6 +53,11 @@ using namespace Log;
 
 static inline std::string time2str( const std::tm* datetime, const char* format )
 {
+    if( format[ 0 ] == '\0' )
+    {
+        return "";
+    }
+
 #if not __clang__ and __GNUC__ < 5
     char buffer[ 512 ];
     if( not strftime( buffer, sizeof( buffer ), format, datetime ) )
@@ -65,13 +72,111 @@ static inline std::string time2str( const std::tm* datetime, const char* format
 #endif
 }
 
+static inline std::tm time2tm( const std::time_t time, const u1 utc )
+{
+    std::tm datetime;
+#if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
+    utc ? gmtime_s( &datetime, &time ) : localtime_s( &datetime, &time );
+#else
+    utc ? gmtime_r( &time, &datetime ) : localtime_r( &time, &datetime );
+#endif
+    return datetime;
+}
+
+namespace
+{
+    /**
+       per-thread cache of the formatted date/time parts around '%f' of the last second
+    */
+    struct TimeCache
+    {
+        std::string format = "";
+        std::time_t second = 0;
+        u1 valid = false;
+        u1 fraction = false;
+        std::string prefix = "";
+        std::string suffix = "";
+    };
+}
+
+static void time2buffer(
+    std::string& buffer,
+    const std::chrono::system_clock::time_point& timestamp,
+    const std::string& format,
+    const u1 utc )
+{
+    static thread_local TimeCache caches[ 2 ];
+    auto& cache = caches[ utc ? 1 : 0 ];
+
+    const auto nanoseconds =
+        std::chrono::duration_cast< std::chrono::nanoseconds >( timestamp.time_since_epoch() )
+            .count();
+    auto second = nanoseconds / 1000000000;
+    auto fraction = nanoseconds % 1000000000;
+    if( fraction < 0 )
+    {
+        second -= 1;
+        fraction += 1000000000;
+    }
+
+    if( not cache.valid or cache.second != second or cache.format != format )
+    {
+        std::size_t split = format.size();
+        for( std::size_t position = 0; position + 1 < format.size(); position++ )
+        {
+            if( format[ position ] == '%' )
+            {
+                if( format[ position + 1 ] == 'f' )
+                {
+                    split = position;
+                    break;
+                }
+                position++;
+            }
+        }
+
+        const auto datetime = time2tm( static_cast< std::time_t >( second ), utc );
+
+        cache.format = format;
+        cache.second = second;
+        cache.valid = true;
+        cache.fraction = split != format.size();
+        cache.prefix = time2str( &datetime, format.substr( 0, split ).c_str() );
+        cache.suffix =
+            cache.fraction ? time2str( &datetime, format.substr( split + 2 ).c_str() ) : "";
+    }
+
+    buffer += cache.prefix;
+
+    if( cache.fraction )
+    {
+        char digits[ 6 ];
+        auto microseconds = fraction / 1000;
+        for( std::size_t position = sizeof( digits ); position > 0; position-- )
+        {
+            digits[ position - 1 ] = static_cast< char >( '0' + ( microseconds % 10 ) );
+            microseconds /= 10;
+        }
+        buffer.append( digits, sizeof( digits ) );
+        buffer += cache.suffix;
+    }
+}
+
+static std::atomic< Timestamp::Clock > timestampClock( Timestamp::Clock::SYSTEM );
+
 //
 // Timestamp
 //
 
 Timestamp::Timestamp( void )
 : Item( Item::ID::TIMESTAMP )
-, m_timestamp( std::chrono::system_clock::now() )
+, m_timestamp( now() )
+{
+}
+
+Timestamp::Timestamp( const std::chrono::system_clock::time_point& timestamp )
+: Item( Item::ID::TIMESTAMP )
+, m_timestamp( timestamp )
 {
 }
 
@@ -87,19 +192,60 @@ std::time_t Timestamp::c_timestamp( void ) const
 
 std::string Timestamp::local( const std::string& format ) const
 {
-    const auto t = c_timestamp();
-    return time2str( std::localtime( &t ), format.c_str() );
+    std::string buffer;
+    local( buffer, format );
+    return buffer;
 }
 
 std::string Timestamp::utc( const std::string& format ) const
 {
-    const auto t = c_timestamp();
-    return time2str( std::gmtime( &t ), format.c_str() );
+    std::string buffer;
+    utc( buffer, format );
+    return buffer;
+}
+
+void Timestamp::local( std::string& buffer, const std::string& format ) const
+{
+    time2buffer( buffer, m_timestamp, format, false );
+}
+
+void Timestamp::utc( std::string& buffer, const std::string& format ) const
+{
+    time2buffer( buffer, m_timestamp, format, true );
+}
+
+void Timestamp::setClock( const Clock clock )
+{
+    timestampClock.store( clock, std::memory_order_relaxed );
+}
+
+Timestamp::Clock Timestamp::clock( void )
+{
+    return timestampClock.load( std::memory_order_relaxed );
+}
+
+std::chrono::system_clock::time_point Timestamp::now( void )
+{
+#if defined( CLOCK_REALTIME_COARSE )
+    if( clock() == Clock::COARSE )
+    {
+        struct timespec time;
+        if( clock_gettime( CLOCK_REALTIME_COARSE, &time ) == 0 )
+        {
+            return std::chrono::system_clock::time_point(
+                std::chrono::duration_cast< std::chrono::system_clock::duration >(
+                    std::chrono::seconds( time.tv_sec ) +
+                    std::chrono::nanoseconds( time.tv_nsec ) ) );
+        }
+    }
+#endif
+
+    return std::chrono::system_clock::now();
 }
 
-std::string Timestamp::accept( Formatter& formatter )
+void Timestamp::accept( Formatter& formatter, std::string& buffer ) const
 {
-    return formatter.visit( *this );
+    formatter.append( buffer, *this );
 }
 
 //
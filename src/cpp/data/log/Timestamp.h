@@ -65,18 +65,39 @@ namespace libstdhl
           public:
             using Ptr = std::shared_ptr< Timestamp >;
 
+            /**
+               clock source used to sample new timestamps, the coarse clock trades
+               resolution (typically a few milliseconds) for a much cheaper sampling
+            */
+            enum class Clock
+            {
+                SYSTEM,
+                COARSE,
+            };
+
             Timestamp( void );
 
+            Timestamp( const std::chrono::system_clock::time_point& timestamp );
+
             std::chrono::system_clock::time_point timestamp( void ) const;
 
             std::time_t c_timestamp( void ) const;
 
             // format parameter
             // http://en.cppreference.com/w/cpp/io/manip/put_time
+            // additionally '%f' is replaced by the microseconds of the timestamp
             std::string local( const std::string& format = "%c %Z" ) const;
 
             std::string utc( const std::string& format = "%c %Z" ) const;
 
+            /**
+               appends the formatted timestamp to 'buffer', the date/time part is formatted
+               once per second (and thread) and reused, only the '%f' part is patched in
+            */
+            void local( std::string& buffer, const std::string& format = "%c %Z" ) const;
+
+            void utc( std::string& buffer, const std::string& format = "%c %Z" ) const;
+
             inline u1 operator==( const Timestamp& rhs ) const
             {
                 if( this != &rhs )
@@ -118,7 +139,15 @@ namespace libstdhl
             std::chrono::system_clock::time_point m_timestamp;
 
           public:
-            std::string accept( Formatter& formatter ) override;
+            static void setClock( const Clock clock );
+
+            static Clock clock( void );
+
+            static std::chrono::system_clock::time_point now( void );
+
+            using Item::accept;
+
+            void accept( Formatter& formatter, std::string& buffer ) const override;
         };
     }
 }
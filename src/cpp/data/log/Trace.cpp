@@ -0,0 +1,396 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Trace.h"
+
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined( __WIN32__ ) or defined( __WIN32 ) or defined( _WIN32 )
+#include <process.h>
+#define PROCESS_ID() _getpid()
+#else
+#include <unistd.h>
+#define PROCESS_ID() ::getpid()
+#endif
+
+using namespace libstdhl;
+using namespace Log;
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char* name;
+        u64 time;
+        u1 begin;
+    };
+
+    /**
+       single producer buffer, events below 'size' are immutable and readable by any thread
+    */
+    struct TraceBuffer
+    {
+        TraceBuffer( const std::size_t capacity, const u64 thread )
+        : events( capacity )
+        , size( 0 )
+        , open( 0 )
+        , dropped( 0 )
+        , thread( thread )
+        , name()
+        {
+        }
+
+        std::vector< TraceEvent > events;
+        std::atomic< std::size_t > size;
+        std::size_t open;
+        std::atomic< std::size_t > dropped;
+        const u64 thread;
+        std::string name;
+    };
+
+    struct TraceSession
+    {
+        std::mutex mutex;
+        std::vector< std::shared_ptr< TraceBuffer > > buffers;
+        std::size_t capacity = 0;
+        u64 generation = 0;
+        std::string name = "libstdhl";
+        Timestamp timestamp;
+
+        /**
+           steady clock nanoseconds at the start of the session, atomic since recording
+           threads read it while a restart replaces it
+        */
+        std::atomic< u64 > origin{ 0 };
+    };
+
+    struct TraceThread
+    {
+        std::shared_ptr< TraceBuffer > buffer;
+        u64 generation = 0;
+        std::string name;
+    };
+}
+
+static TraceSession& traceSession( void )
+{
+    static TraceSession cache;
+    return cache;
+}
+
+static u64 traceClock( void )
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+               std::chrono::steady_clock::now().time_since_epoch() )
+        .count();
+}
+
+/**
+   nanoseconds since the start of the session
+*/
+static u64 traceTime( void )
+{
+    const auto origin = traceSession().origin.load( std::memory_order_acquire );
+    const auto now = traceClock();
+    return now > origin ? now - origin : 0;
+}
+
+static std::atomic< u64 > traceGeneration( 0 );
+
+static thread_local TraceThread traceThread;
+
+static TraceBuffer& traceBuffer( void )
+{
+    const auto generation = traceGeneration.load( std::memory_order_acquire );
+
+    if( traceThread.generation != generation or not traceThread.buffer )
+    {
+        auto& session = traceSession();
+        std::lock_guard< std::mutex > guard( session.mutex );
+
+        traceThread.buffer =
+            std::make_shared< TraceBuffer >( session.capacity, session.buffers.size() + 1 );
+        traceThread.buffer->name = traceThread.name;
+        traceThread.generation = session.generation;
+        session.buffers.emplace_back( traceThread.buffer );
+    }
+
+    return *traceThread.buffer;
+}
+
+static void escape( std::ostream& stream, const std::string& text )
+{
+    for( const auto character : text )
+    {
+        switch( character )
+        {
+            case '"':
+            {
+                stream << "\\\"";
+                break;
+            }
+            case '\\':
+            {
+                stream << "\\\\";
+                break;
+            }
+            case '\n':
+            {
+                stream << "\\n";
+                break;
+            }
+            case '\t':
+            {
+                stream << "\\t";
+                break;
+            }
+            default:
+            {
+                if( static_cast< u8 >( character ) < 0x20 )
+                {
+                    stream << ' ';
+                }
+                else
+                {
+                    stream << character;
+                }
+                break;
+            }
+        }
+    }
+}
+
+// Trace::Scope
+
+Trace::Scope::Scope( const char* name )
+: m_name( name )
+, m_recorded( Trace::enabled() and Trace::begin( name ) )
+{
+}
+
+Trace::Scope::~Scope( void )
+{
+    if( m_recorded )
+    {
+        Trace::end( m_name );
+    }
+}
+
+// Trace
+
+std::atomic< u1 > Trace::s_enabled( false );
+
+void Trace::start( const std::size_t capacity )
+{
+    assert( capacity > 1 );
+
+    auto& session = traceSession();
+
+    {
+        std::lock_guard< std::mutex > guard( session.mutex );
+        session.buffers.clear();
+        session.capacity = capacity;
+        session.generation++;
+        session.timestamp = Timestamp();
+        session.origin.store( traceClock(), std::memory_order_release );
+        traceGeneration.store( session.generation, std::memory_order_release );
+    }
+
+    s_enabled.store( true, std::memory_order_relaxed );
+}
+
+void Trace::stop( void )
+{
+    s_enabled.store( false, std::memory_order_relaxed );
+}
+
+u1 Trace::begin( const char* name )
+{
+    auto& buffer = traceBuffer();
+    const auto size = buffer.size.load( std::memory_order_relaxed );
+
+    // keep room for the end events of this and all still open scopes
+    if( size + buffer.open + 2 > buffer.events.size() )
+    {
+        buffer.dropped.fetch_add( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    buffer.events[ size ] = { name, traceTime(), true };
+    buffer.open++;
+    buffer.size.store( size + 1, std::memory_order_release );
+    return true;
+}
+
+void Trace::end( const char* name )
+{
+    if( not traceThread.buffer or traceThread.buffer->open == 0 )
+    {
+        // scope began before the trace was restarted
+        return;
+    }
+
+    auto& buffer = *traceThread.buffer;
+    const auto size = buffer.size.load( std::memory_order_relaxed );
+
+    buffer.events[ size ] = { name, traceTime(), false };
+    buffer.open--;
+    buffer.size.store( size + 1, std::memory_order_release );
+}
+
+void Trace::setProcessName( const std::string& name )
+{
+    auto& session = traceSession();
+    std::lock_guard< std::mutex > guard( session.mutex );
+    session.name = name;
+}
+
+void Trace::setThreadName( const std::string& name )
+{
+    traceThread.name = name;
+
+    if( traceThread.buffer )
+    {
+        std::lock_guard< std::mutex > guard( traceSession().mutex );
+        traceThread.buffer->name = name;
+    }
+}
+
+std::size_t Trace::dropped( void )
+{
+    auto& session = traceSession();
+    std::lock_guard< std::mutex > guard( session.mutex );
+
+    std::size_t dropped = 0;
+    for( const auto& buffer : session.buffers )
+    {
+        dropped += buffer->dropped.load( std::memory_order_relaxed );
+    }
+    return dropped;
+}
+
+void Trace::write( std::ostream& stream )
+{
+    auto& session = traceSession();
+    std::lock_guard< std::mutex > guard( session.mutex );
+
+    const auto process = PROCESS_ID();
+    u1 first = true;
+
+    const auto separate = [&]( void ) {
+        stream << ( first ? "\n" : ",\n" );
+        first = false;
+    };
+
+    stream << "{\"traceEvents\":[";
+
+    separate();
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << process
+           << ",\"tid\":0,\"args\":{\"name\":\"";
+    escape( stream, session.name );
+    stream << "\"}}";
+
+    for( const auto& buffer : session.buffers )
+    {
+        if( not buffer->name.empty() )
+        {
+            separate();
+            stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << process
+                   << ",\"tid\":" << buffer->thread << ",\"args\":{\"name\":\"";
+            escape( stream, buffer->name );
+            stream << "\"}}";
+        }
+
+        const auto size = buffer->size.load( std::memory_order_acquire );
+        for( std::size_t index = 0; index < size; index++ )
+        {
+            const auto& event = buffer->events[ index ];
+
+            separate();
+            stream << "{\"name\":\"";
+            escape( stream, event.name );
+            stream << "\",\"ph\":\"" << ( event.begin ? 'B' : 'E' ) << "\",\"ts\":";
+
+            // microseconds with nanosecond fraction
+            stream << ( event.time / 1000 ) << "."
+                   << std::to_string( 1000 + event.time % 1000 ).substr( 1 );
+
+            stream << ",\"pid\":" << process << ",\"tid\":" << buffer->thread << "}";
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"start\":\"";
+    escape( stream, session.timestamp.utc( "%Y-%m-%dT%H:%M:%S.%fZ" ) );
+    stream << "\"}}\n";
+}
+
+void Trace::write( const std::string& filename )
+{
+    std::ofstream stream( filename, std::ios::out | std::ios::trunc );
+    if( not stream )
+    {
+        throw std::domain_error( "unable to open trace file '" + filename + "'" );
+    }
+
+    write( stream );
+
+    if( not stream )
+    {
+        throw std::domain_error( "unable to write to trace file '" + filename + "'" );
+    }
+}
+
+#undef PROCESS_ID
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,138 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_TRACE_H_
+#define _LIBSTDHL_CPP_LOG_TRACE_H_
+
+#include <libstdhl/data/log/Chronograph>
+#include <libstdhl/data/log/Timestamp>
+
+#include <atomic>
+#include <iosfwd>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        /**
+           Timeline recorder of begin/end events in Chrome trace-event JSON format.
+
+           Every thread records into its own preallocated buffer of 'capacity' events
+           without any lock or allocation, a full buffer drops further scopes (but never
+           the end of an already recorded one). Event names must outlive the trace, e.g.
+           string literals. The written file opens in 'chrome://tracing' and Perfetto.
+        */
+        class Trace final
+        {
+          public:
+            class Scope final
+            {
+              public:
+                Scope( const char* name );
+
+                ~Scope( void );
+
+                Scope( const Scope& ) = delete;
+
+                Scope& operator=( const Scope& ) = delete;
+
+              private:
+                const char* m_name;
+
+                u1 m_recorded;
+            };
+
+            /**
+               discards previous events and starts recording 'capacity' events per thread
+            */
+            static void start( const std::size_t capacity = 1 << 16 );
+
+            static void stop( void );
+
+            static inline u1 enabled( void )
+            {
+                return s_enabled.load( std::memory_order_relaxed );
+            }
+
+            /**
+               returns false if the event was not recorded and 'end' must not be called
+            */
+            static u1 begin( const char* name );
+
+            static void end( const char* name );
+
+            static void setProcessName( const std::string& name );
+
+            static void setThreadName( const std::string& name );
+
+            static std::size_t dropped( void );
+
+            static void write( std::ostream& stream );
+
+            static void write( const std::string& filename );
+
+          private:
+            static std::atomic< u1 > s_enabled;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_TRACE_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,354 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Worker.h"
+#include "Stream.h"
+
+#include <cassert>
+
+using namespace libstdhl;
+using namespace Log;
+
+// Worker
+
+Worker::Worker( const Channel::Ptr& channel, const std::size_t capacity )
+: m_channel( channel )
+, m_capacity( capacity )
+, m_queue()
+, m_mutex()
+, m_produced()
+, m_consumed()
+, m_busy( false )
+, m_error()
+, m_stop( false )
+, m_thread()
+{
+    assert( m_channel );
+    assert( m_capacity > 0 );
+
+    m_thread = std::thread( &Worker::run, this );
+}
+
+Worker::~Worker( void )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_stop = true;
+    }
+
+    m_produced.notify_one();
+    m_thread.join();
+}
+
+Channel::Ptr Worker::channel( void ) const
+{
+    return m_channel;
+}
+
+std::size_t Worker::capacity( void ) const
+{
+    return m_capacity;
+}
+
+void Worker::submit( const Batch& batch )
+{
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        m_consumed.wait( lock, [this] { return m_queue.size() < m_capacity; } );
+        m_queue.emplace_back( batch );
+    }
+
+    m_produced.notify_one();
+}
+
+void Worker::wait( void )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    m_consumed.wait( lock, [this] { return m_queue.empty() and not m_busy; } );
+
+    if( m_error )
+    {
+        const auto error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception( error );
+    }
+}
+
+void Worker::run( void )
+{
+    while( true )
+    {
+        Batch batch;
+
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            m_produced.wait( lock, [this] { return m_stop or not m_queue.empty(); } );
+
+            if( m_queue.empty() )
+            {
+                // stop requested and all pending batches are processed
+                return;
+            }
+
+            batch = std::move( m_queue.front() );
+            m_queue.pop_front();
+            m_busy = true;
+        }
+
+        m_consumed.notify_all();
+
+        // channels only read the batch, therefore all workers share it without a copy
+        std::exception_ptr error;
+        try
+        {
+            m_channel->process( *batch );
+        }
+        catch( ... )
+        {
+            error = std::current_exception();
+        }
+
+        batch.reset();
+
+        {
+            std::lock_guard< std::mutex > guard( m_mutex );
+            m_busy = false;
+
+            if( error and not m_error )
+            {
+                m_error = error;
+            }
+        }
+
+        m_consumed.notify_all();
+    }
+}
+
+/**
+   waits until the replaced workers processed all batches which were submitted to them,
+   a 'process' call which pinned an older graph may still submit to them until it returns
+*/
+static void drain( Workers& workers )
+{
+    Epoch::synchronize();
+    Epoch::collect();
+
+    std::exception_ptr error;
+    for( const auto& worker : workers )
+    {
+        try
+        {
+            worker->wait();
+        }
+        catch( ... )
+        {
+            error = error ? error : std::current_exception();
+        }
+    }
+
+    workers.clear();
+
+    if( error )
+    {
+        std::rethrow_exception( error );
+    }
+}
+
+// Fanout
+
+Fanout::Fanout( void )
+: m_graph()
+{
+    m_graph.update( []( Pin& graph ) { graph = std::make_shared< Graph >(); } );
+}
+
+Fanout::Pin Fanout::pin( void ) const
+{
+    Epoch::Guard guard;
+    return m_graph.load();
+}
+
+Channels Fanout::channels( void ) const
+{
+    return pin()->channels;
+}
+
+void Fanout::add( const Channel::Ptr& channel )
+{
+    assert( channel );
+
+    m_graph.update( [&]( Pin& current ) {
+        auto graph = std::make_shared< Graph >( *current );
+        graph->channels.add( channel );
+
+        if( graph->capacity > 0 )
+        {
+            graph->workers.emplace_back( std::make_shared< Worker >( channel, graph->capacity ) );
+        }
+
+        current = graph;
+    } );
+}
+
+void Fanout::remove( const Channel::Ptr& channel )
+{
+    Workers removed;
+    m_graph.update( [&]( Pin& current ) {
+        auto graph = std::make_shared< Graph >();
+        graph->capacity = current->capacity;
+
+        for( const auto& element : current->channels )
+        {
+            if( element != channel )
+            {
+                graph->channels.add( element );
+            }
+        }
+
+        for( const auto& worker : current->workers )
+        {
+            if( worker->channel() != channel )
+            {
+                graph->workers.emplace_back( worker );
+            }
+            else
+            {
+                removed.emplace_back( worker );
+            }
+        }
+
+        current = graph;
+    } );
+
+    drain( removed );
+}
+
+void Fanout::setParallel( const u1 enable, const std::size_t capacity )
+{
+    assert( not enable or capacity > 0 );
+
+    Workers replaced;
+    m_graph.update( [&]( Pin& current ) {
+        auto graph = std::make_shared< Graph >();
+        graph->channels = current->channels;
+        graph->capacity = enable ? capacity : 0;
+        replaced = current->workers;
+
+        if( enable )
+        {
+            for( const auto& channel : graph->channels )
+            {
+                graph->workers.emplace_back(
+                    std::make_shared< Worker >( channel, graph->capacity ) );
+            }
+        }
+
+        current = graph;
+    } );
+
+    drain( replaced );
+}
+
+u1 Fanout::parallel( void ) const
+{
+    return pin()->capacity > 0;
+}
+
+void Fanout::wait( void )
+{
+    const auto graph = pin();
+
+    std::exception_ptr error;
+    for( const auto& worker : graph->workers )
+    {
+        try
+        {
+            worker->wait();
+        }
+        catch( ... )
+        {
+            error = error ? error : std::current_exception();
+        }
+    }
+
+    if( error )
+    {
+        std::rethrow_exception( error );
+    }
+}
+
+void Fanout::process( const Stream& stream )
+{
+    const auto graph = pin();
+
+    if( graph->capacity > 0 )
+    {
+        if( stream.data().empty() )
+        {
+            return;
+        }
+
+        // freeze the batch once, all workers share the same snapshot
+        const auto batch = std::make_shared< const Stream >( stream );
+
+        for( const auto& worker : graph->workers )
+        {
+            worker->submit( batch );
+        }
+
+        return;
+    }
+
+    for( const auto& channel : graph->channels )
+    {
+        channel->process( stream );
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
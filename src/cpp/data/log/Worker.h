@@ -0,0 +1,193 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_LOG_WORKER_H_
+#define _LIBSTDHL_CPP_LOG_WORKER_H_
+
+#include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Epoch>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+   @brief    TODO
+
+   TODO
+*/
+
+namespace libstdhl
+{
+    /**
+       @extends Stdhl
+    */
+    namespace Log
+    {
+        /**
+           Processes shared stream snapshots on a dedicated thread for a single channel.
+
+           The queue is bounded by 'capacity', a full queue blocks 'submit' until the
+           channel caught up (backpressure). Submitted streams are shared between workers
+           and stay immutable, every channel reads the same batch. An exception of the
+           channel is kept and rethrown by the next 'wait'.
+        */
+        class Worker final
+        {
+          public:
+            using Ptr = std::shared_ptr< Worker >;
+
+            using Batch = std::shared_ptr< const Stream >;
+
+            Worker( const Channel::Ptr& channel, const std::size_t capacity );
+
+            ~Worker( void );
+
+            Channel::Ptr channel( void ) const;
+
+            std::size_t capacity( void ) const;
+
+            void submit( const Batch& batch );
+
+            /**
+               blocks until all submitted batches are processed and rethrows the first
+               exception the channel raised since the last call
+            */
+            void wait( void );
+
+          private:
+            void run( void );
+
+            const Channel::Ptr m_channel;
+
+            const std::size_t m_capacity;
+
+            std::deque< Batch > m_queue;
+
+            std::mutex m_mutex;
+
+            std::condition_variable m_produced;
+
+            std::condition_variable m_consumed;
+
+            u1 m_busy;
+
+            std::exception_ptr m_error;
+
+            u1 m_stop;
+
+            std::thread m_thread;
+        };
+
+        using Workers = std::vector< Worker::Ptr >;
+
+        /**
+           Fans a stream out to a set of channels, sequentially or in parallel with one
+           worker per channel, shared by Router and Switch.
+
+           The channels and workers form an immutable graph, reconfiguration publishes a
+           modified copy while concurrent 'process' calls keep using the graph they
+           started with. A call pins its graph and holds no epoch guard while it blocks
+           on a channel or on backpressure, therefore a channel may reconfigure the
+           fan-out it is called from, except removing itself in the parallel mode.
+        */
+        class Fanout final
+        {
+          public:
+            Fanout( void );
+
+            Channels channels( void ) const;
+
+            void add( const Channel::Ptr& channel );
+
+            /**
+               returns once the worker of the channel processed its pending batches
+            */
+            void remove( const Channel::Ptr& channel );
+
+            /**
+               replaced workers are drained before the call returns
+            */
+            void setParallel( const u1 enable, const std::size_t capacity );
+
+            u1 parallel( void ) const;
+
+            /**
+               blocks until all channels processed the batches submitted so far and
+               rethrows the first exception one of them raised
+            */
+            void wait( void );
+
+            void process( const Stream& stream );
+
+          private:
+            struct Graph
+            {
+                Channels channels;
+
+                std::size_t capacity = 0;
+
+                Workers workers;
+            };
+
+            using Pin = std::shared_ptr< const Graph >;
+
+            Pin pin( void ) const;
+
+            Snapshot< Pin > m_graph;
+        };
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_LOG_WORKER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
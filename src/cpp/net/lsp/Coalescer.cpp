@@ -0,0 +1,221 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Coalescer.h"
+
+#include "Identifier.h"
+
+#include <algorithm>
+
+using namespace libstdhl;
+using namespace Network;
+using namespace LSP;
+
+//
+//
+// Coalescer
+//
+
+Coalescer::Coalescer( const Clock::duration quiet, const Deliver& deliver )
+: m_quiet( quiet )
+, m_deliver( deliver )
+, m_batches()
+, m_delivered()
+, m_stop( false )
+, m_mutex()
+, m_changed()
+, m_thread()
+{
+    m_thread = std::thread( &Coalescer::run, this );
+}
+
+Coalescer::~Coalescer( void )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_stop = true;
+    }
+
+    m_changed.notify_one();
+    m_thread.join();
+}
+
+Coalescer::Clock::duration Coalescer::quiet( void ) const
+{
+    return m_quiet;
+}
+
+void Coalescer::add( const DidChangeTextDocumentParams& params )
+{
+    const auto& textDocument = params.at( Identifier::textDocument );
+    const auto& uri = textDocument.at( Identifier::uri ).get_ref< const std::string& >();
+    const auto& changes = params.at( Identifier::contentChanges );
+
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+
+        const auto delivered = m_delivered.find( uri );
+        if( delivered != m_delivered.end() )
+        {
+            // the delivered batch is outdated by this change
+            delivered->second->cancel();
+            m_delivered.erase( delivered );
+        }
+
+        const auto deadline = Clock::now() + m_quiet;
+        auto batch = m_batches.find( uri );
+        if( batch == m_batches.end() )
+        {
+            m_batches.emplace( uri, Batch{ static_cast< const Data& >( params ), deadline } );
+        }
+        else
+        {
+            auto& pending = batch->second;
+            pending.deadline = deadline;
+            pending.params[ Identifier::textDocument ] = textDocument;
+
+            auto& merged = pending.params[ Identifier::contentChanges ];
+            for( const auto& change : changes )
+            {
+                if( change.find( Identifier::range ) == change.end() )
+                {
+                    // full text change, all previous changes are superseded
+                    merged = Data::array();
+                }
+                merged.push_back( change );
+            }
+        }
+    }
+
+    m_changed.notify_one();
+}
+
+u1 Coalescer::flush( const std::string& uri )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    const auto batch = m_batches.find( uri );
+    if( batch == m_batches.end() )
+    {
+        return false;
+    }
+
+    deliver( uri, batch->second );
+    m_batches.erase( batch );
+    return true;
+}
+
+void Coalescer::flush( void )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+
+    for( const auto& batch : m_batches )
+    {
+        deliver( batch.first, batch.second );
+    }
+    m_batches.clear();
+}
+
+std::size_t Coalescer::pending( void )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    return m_batches.size();
+}
+
+void Coalescer::run( void )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    while( not m_stop )
+    {
+        if( m_batches.empty() )
+        {
+            m_changed.wait( lock );
+            continue;
+        }
+
+        const auto now = Clock::now();
+        auto next = Clock::time_point::max();
+
+        for( auto batch = m_batches.begin(); batch != m_batches.end(); )
+        {
+            if( batch->second.deadline <= now )
+            {
+                deliver( batch->first, batch->second );
+                batch = m_batches.erase( batch );
+            }
+            else
+            {
+                next = std::min( next, batch->second.deadline );
+                ++batch;
+            }
+        }
+
+        if( next != Clock::time_point::max() )
+        {
+            m_changed.wait_until( lock, next );
+        }
+    }
+
+    for( const auto& batch : m_batches )
+    {
+        deliver( batch.first, batch.second );
+    }
+    m_batches.clear();
+}
+
+void Coalescer::deliver( const std::string& uri, const Batch& batch )
+{
+    // called with the lock held, so batches of a document are delivered in order
+    const auto token = std::make_shared< Cancellation >();
+    m_delivered[ uri ] = token;
+    m_deliver( uri, batch.params, token );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
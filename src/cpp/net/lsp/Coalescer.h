@@ -0,0 +1,155 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_NETWORK_LSP_COALESCER_H_
+#define _LIBSTDHL_CPP_NETWORK_LSP_COALESCER_H_
+
+#include <libstdhl/net/lsp/Content>
+#include <libstdhl/net/lsp/Executor>
+
+#include <chrono>
+
+/**
+   @brief    TBD
+
+   TBD
+*/
+
+namespace libstdhl
+{
+    namespace Network
+    {
+        namespace LSP
+        {
+            /**
+               Merges the 'textDocument/didChange' notifications of every document into
+               one pending edit batch, which is delivered after no further change arrived
+               for the quiet period.
+
+               A full text change supersedes all pending changes of its document. A new
+               change cancels the token of the batch delivered last for the document, so a
+               stale analysis can stop early.
+            */
+            class Coalescer final
+            {
+              public:
+                using Ptr = std::shared_ptr< Coalescer >;
+
+                using Clock = std::chrono::steady_clock;
+
+                using Deliver = std::function< void(
+                    const std::string& uri, const Data& params, const Cancellation::Ptr& token ) >;
+
+                /**
+                   'deliver' is called from the timer thread or the flushing thread and has
+                   to return quickly, e.g. by submitting the batch to an 'Executor'
+                */
+                Coalescer( const Clock::duration quiet, const Deliver& deliver );
+
+                /**
+                   delivers all pending batches before the timer thread is joined
+                */
+                ~Coalescer( void );
+
+                Clock::duration quiet( void ) const;
+
+                /**
+                   merges 'params' into the pending batch of its document and restarts the
+                   quiet period of the document
+                */
+                void add( const DidChangeTextDocumentParams& params );
+
+                /**
+                   delivers the pending batch of 'uri' right away, false if none is pending
+                */
+                u1 flush( const std::string& uri );
+
+                void flush( void );
+
+                /**
+                   amount of documents with a pending batch
+                */
+                std::size_t pending( void );
+
+              private:
+                struct Batch
+                {
+                    Data params;
+
+                    Clock::time_point deadline;
+                };
+
+                void run( void );
+
+                void deliver( const std::string& uri, const Batch& batch );
+
+                const Clock::duration m_quiet;
+
+                const Deliver m_deliver;
+
+                std::unordered_map< std::string, Batch > m_batches;
+
+                std::unordered_map< std::string, Cancellation::Ptr > m_delivered;
+
+                u1 m_stop;
+
+                std::mutex m_mutex;
+
+                std::condition_variable m_changed;
+
+                std::thread m_thread;
+            };
+        }
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_NETWORK_LSP_COALESCER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -95,7 +95,12 @@ Data ResponseError::data( void ) const
 
 void ResponseError::setData( const Data& data )
 {
-    operator[]( Identifier::data ) = Data::from_cbor( Data::to_cbor( data ) );
+    operator[]( Identifier::data ) = data;
+}
+
+void ResponseError::setData( Data&& data )
+{
+    operator[]( Identifier::data ) = std::move( data );
 }
 
 void ResponseError::validate( const Data& data )
@@ -157,8 +162,8 @@ Range::Range( const Data& data )
 Range::Range( const Position& start, const Position& end )
 : Data( Data::object() )
 {
-    operator[]( Identifier::start ) = Data::from_cbor( Data::to_cbor( start ) );
-    operator[]( Identifier::end ) = Data::from_cbor( Data::to_cbor( end ) );
+    operator[]( Identifier::start ) = static_cast< const Data& >( start );
+    operator[]( Identifier::end ) = static_cast< const Data& >( end );
 }
 
 Position Range::start( void ) const
@@ -194,7 +199,7 @@ Location::Location( const DocumentUri& uri, const Range& range )
 : Data( Data::object() )
 {
     operator[]( Identifier::uri ) = uri.toString();
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 DocumentUri Location::uri( void ) const
@@ -230,7 +235,7 @@ DiagnosticRelatedInformation::DiagnosticRelatedInformation(
     const Location& location, const std::string& message )
 : Data( Data::object() )
 {
-    operator[]( Identifier::location ) = Data::from_cbor( Data::to_cbor( location ) );
+    operator[]( Identifier::location ) = static_cast< const Data& >( location );
     operator[]( Identifier::message ) = message;
 }
 
@@ -266,7 +271,7 @@ Diagnostic::Diagnostic( const Data& data )
 Diagnostic::Diagnostic( const Range& range, const std::string& message )
 : Data( Data::object() )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
     operator[]( Identifier::message ) = message;
 }
 
@@ -408,7 +413,7 @@ TextEdit::TextEdit( const Data& data )
 TextEdit::TextEdit( const Range& range, const std::string& newText )
 : Data( Data::object() )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
     operator[]( Identifier::newText ) = newText;
 }
 
@@ -504,10 +509,10 @@ TextDocumentEdit::TextDocumentEdit(
     const VersionedTextDocumentIdentifier& textDocument, const std::vector< TextEdit >& edits )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
     operator[]( Identifier::edits ) = Data::array();
 
-    for( auto edit : edits )
+    for( const auto& edit : edits )
     {
         operator[]( Identifier::edits ).push_back( edit );
     }
@@ -661,7 +666,7 @@ u1 CreateFile::hasOptions( void ) const
 
 void CreateFile::setOptions( const CreateFileOptions& options )
 {
-    operator[]( Identifier::options ) = Data::from_cbor( Data::to_cbor( options ) );
+    operator[]( Identifier::options ) = static_cast< const Data& >( options );
 }
 
 CreateFileOptions CreateFile::options( void ) const
@@ -719,7 +724,7 @@ u1 RenameFile::hasOptions( void ) const
 
 void RenameFile::setOptions( const RenameFileOptions& options )
 {
-    operator[]( Identifier::options ) = Data::from_cbor( Data::to_cbor( options ) );
+    operator[]( Identifier::options ) = static_cast< const Data& >( options );
 }
 
 RenameFileOptions RenameFile::options( void ) const
@@ -821,7 +826,7 @@ u1 DeleteFile::hasOptions( void ) const
 
 void DeleteFile::setOptions( const DeleteFileOptions& options )
 {
-    operator[]( Identifier::options ) = Data::from_cbor( Data::to_cbor( options ) );
+    operator[]( Identifier::options ) = static_cast< const Data& >( options );
 }
 
 DeleteFileOptions DeleteFile::options( void ) const
@@ -877,9 +882,9 @@ std::size_t TextDocumentItem::version( void ) const
     return at( Identifier::version ).get< std::size_t >();
 }
 
-std::string TextDocumentItem::text( void ) const
+const std::string& TextDocumentItem::text( void ) const
 {
-    return at( Identifier::text ).get< std::string >();
+    return at( Identifier::text ).get_ref< const std::string& >();
 }
 
 void TextDocumentItem::validate( const Data& data )
@@ -907,8 +912,8 @@ TextDocumentPositionParams::TextDocumentPositionParams(
     const TextDocumentIdentifier& textDocument, const Position& position )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
-    operator[]( Identifier::position ) = Data::from_cbor( Data::to_cbor( position ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
+    operator[]( Identifier::position ) = static_cast< const Data& >( position );
 }
 
 TextDocumentIdentifier TextDocumentPositionParams::textDocument( void ) const
@@ -1014,7 +1019,7 @@ DocumentSelector::DocumentSelector( const Data& data )
 DocumentSelector::DocumentSelector( const std::vector< DocumentFilter >& documentFilters )
 : Data( Data::array() )
 {
-    for( auto documentFilter : documentFilters )
+    for( const auto& documentFilter : documentFilters )
     {
         this->push_back( documentFilter );
     }
@@ -1107,7 +1112,7 @@ WorkspaceEdit WorkspaceClientCapabilities::workspaceEdit( void ) const
 
 void WorkspaceClientCapabilities::setWorkspaceEdit( const WorkspaceEdit& workspaceEdit )
 {
-    operator[]( Identifier::workspaceEdit ) = Data::from_cbor( Data::to_cbor( workspaceEdit ) );
+    operator[]( Identifier::workspaceEdit ) = static_cast< const Data& >( workspaceEdit );
 }
 
 u1 WorkspaceClientCapabilities::hasDidChangeConfiguration( void ) const
@@ -1124,7 +1129,7 @@ void WorkspaceClientCapabilities::setDidChangeConfiguration(
     const DynamicRegistration& didChangeConfiguration )
 {
     operator[]( Identifier::didChangeConfiguration ) =
-        Data::from_cbor( Data::to_cbor( didChangeConfiguration ) );
+        static_cast< const Data& >( didChangeConfiguration );
 }
 
 u1 WorkspaceClientCapabilities::hasDidChangeWatchedFiles( void ) const
@@ -1141,7 +1146,7 @@ void WorkspaceClientCapabilities::didChangeWatchedFiles(
     const DynamicRegistration& didChangeWatchedFiles )
 {
     operator[]( Identifier::didChangeWatchedFiles ) =
-        Data::from_cbor( Data::to_cbor( didChangeWatchedFiles ) );
+        static_cast< const Data& >( didChangeWatchedFiles );
 }
 
 u1 WorkspaceClientCapabilities::hasSymbol( void ) const
@@ -1156,7 +1161,7 @@ DynamicRegistration WorkspaceClientCapabilities::symbol( void ) const
 
 void WorkspaceClientCapabilities::setSymbol( const DynamicRegistration& symbol )
 {
-    operator[]( Identifier::symbol ) = Data::from_cbor( Data::to_cbor( symbol ) );
+    operator[]( Identifier::symbol ) = static_cast< const Data& >( symbol );
 }
 
 u1 WorkspaceClientCapabilities::hasExecuteCommand( void ) const
@@ -1171,7 +1176,7 @@ DynamicRegistration WorkspaceClientCapabilities::executeCommand( void ) const
 
 void WorkspaceClientCapabilities::executeCommand( const DynamicRegistration& executeCommand )
 {
-    operator[]( Identifier::executeCommand ) = Data::from_cbor( Data::to_cbor( executeCommand ) );
+    operator[]( Identifier::executeCommand ) = static_cast< const Data& >( executeCommand );
 }
 u1 WorkspaceClientCapabilities::hasWorkspaceFolders( void ) const
 {
@@ -1391,7 +1396,7 @@ TextDocumentClientCapabilities::Completion::completionItem( void ) const
 void TextDocumentClientCapabilities::Completion::completionItem(
     const TextDocumentClientCapabilities::CompletionItem& completionItem )
 {
-    operator[]( Identifier::completionItem ) = Data::from_cbor( Data::to_cbor( completionItem ) );
+    operator[]( Identifier::completionItem ) = static_cast< const Data& >( completionItem );
 }
 
 void TextDocumentClientCapabilities::Completion::validate( const Data& data )
@@ -1431,7 +1436,7 @@ Synchronization TextDocumentClientCapabilities::synchronization( void ) const
 
 void TextDocumentClientCapabilities::setSynchronization( const Synchronization& synchronization )
 {
-    operator[]( Identifier::synchronization ) = Data::from_cbor( Data::to_cbor( synchronization ) );
+    operator[]( Identifier::synchronization ) = static_cast< const Data& >( synchronization );
 }
 
 u1 TextDocumentClientCapabilities::hasCompletion( void ) const
@@ -1446,7 +1451,7 @@ TextDocumentClientCapabilities::Completion TextDocumentClientCapabilities::compl
 
 void TextDocumentClientCapabilities::setCompletion( const Completion& completion )
 {
-    operator[]( Identifier::completion ) = Data::from_cbor( Data::to_cbor( completion ) );
+    operator[]( Identifier::completion ) = static_cast< const Data& >( completion );
 }
 
 u1 TextDocumentClientCapabilities::hasHover( void ) const
@@ -1461,7 +1466,7 @@ DynamicRegistration TextDocumentClientCapabilities::hover( void ) const
 
 void TextDocumentClientCapabilities::setHover( const DynamicRegistration& hover )
 {
-    operator[]( Identifier::hover ) = Data::from_cbor( Data::to_cbor( hover ) );
+    operator[]( Identifier::hover ) = static_cast< const Data& >( hover );
 }
 
 u1 TextDocumentClientCapabilities::hasSignatureHelp( void ) const
@@ -1476,7 +1481,7 @@ DynamicRegistration TextDocumentClientCapabilities::signatureHelp( void ) const
 
 void TextDocumentClientCapabilities::setSignatureHelp( const DynamicRegistration& signatureHelp )
 {
-    operator[]( Identifier::signatureHelp ) = Data::from_cbor( Data::to_cbor( signatureHelp ) );
+    operator[]( Identifier::signatureHelp ) = static_cast< const Data& >( signatureHelp );
 }
 
 u1 TextDocumentClientCapabilities::hasReferences( void ) const
@@ -1491,7 +1496,7 @@ DynamicRegistration TextDocumentClientCapabilities::references( void ) const
 
 void TextDocumentClientCapabilities::setReferences( const DynamicRegistration& references )
 {
-    operator[]( Identifier::references ) = Data::from_cbor( Data::to_cbor( references ) );
+    operator[]( Identifier::references ) = static_cast< const Data& >( references );
 }
 
 u1 TextDocumentClientCapabilities::hasDocumentHighlight( void ) const
@@ -1507,8 +1512,7 @@ DynamicRegistration TextDocumentClientCapabilities::documentHighlight( void ) co
 void TextDocumentClientCapabilities::setDocumentHighlight(
     const DynamicRegistration& documentHighlight )
 {
-    operator[]( Identifier::documentHighlight ) =
-        Data::from_cbor( Data::to_cbor( documentHighlight ) );
+    operator[]( Identifier::documentHighlight ) = static_cast< const Data& >( documentHighlight );
 }
 
 u1 TextDocumentClientCapabilities::hasDocumentSymbol( void ) const
@@ -1523,7 +1527,7 @@ DynamicRegistration TextDocumentClientCapabilities::documentSymbol( void ) const
 
 void TextDocumentClientCapabilities::setDocumentSymbol( const DynamicRegistration& documentSymbol )
 {
-    operator[]( Identifier::documentSymbol ) = Data::from_cbor( Data::to_cbor( documentSymbol ) );
+    operator[]( Identifier::documentSymbol ) = static_cast< const Data& >( documentSymbol );
 }
 
 u1 TextDocumentClientCapabilities::hasFormatting( void ) const
@@ -1538,7 +1542,7 @@ DynamicRegistration TextDocumentClientCapabilities::formatting( void ) const
 
 void TextDocumentClientCapabilities::setFormatting( const DynamicRegistration& formatting )
 {
-    operator[]( Identifier::formatting ) = Data::from_cbor( Data::to_cbor( formatting ) );
+    operator[]( Identifier::formatting ) = static_cast< const Data& >( formatting );
 }
 
 u1 TextDocumentClientCapabilities::hasRangeFormatting( void ) const
@@ -1554,7 +1558,7 @@ DynamicRegistration TextDocumentClientCapabilities::rangeFormatting( void ) cons
 void TextDocumentClientCapabilities::setRangeFormatting(
     const DynamicRegistration& rangeFormatting )
 {
-    operator[]( Identifier::rangeFormatting ) = Data::from_cbor( Data::to_cbor( rangeFormatting ) );
+    operator[]( Identifier::rangeFormatting ) = static_cast< const Data& >( rangeFormatting );
 }
 
 u1 TextDocumentClientCapabilities::hasOnTypeFormatting( void ) const
@@ -1570,8 +1574,7 @@ DynamicRegistration TextDocumentClientCapabilities::onTypeFormatting( void ) con
 void TextDocumentClientCapabilities::setOnTypeFormatting(
     const DynamicRegistration& onTypeFormatting )
 {
-    operator[]( Identifier::onTypeFormatting ) =
-        Data::from_cbor( Data::to_cbor( onTypeFormatting ) );
+    operator[]( Identifier::onTypeFormatting ) = static_cast< const Data& >( onTypeFormatting );
 }
 
 u1 TextDocumentClientCapabilities::hasDefinition( void ) const
@@ -1586,7 +1589,7 @@ DynamicRegistration TextDocumentClientCapabilities::definition( void ) const
 
 void TextDocumentClientCapabilities::setDefinition( const DynamicRegistration& definition )
 {
-    operator[]( Identifier::definition ) = Data::from_cbor( Data::to_cbor( definition ) );
+    operator[]( Identifier::definition ) = static_cast< const Data& >( definition );
 }
 
 u1 TextDocumentClientCapabilities::hasCodeAction( void ) const
@@ -1601,7 +1604,7 @@ DynamicRegistration TextDocumentClientCapabilities::codeAction( void ) const
 
 void TextDocumentClientCapabilities::setCodeAction( const DynamicRegistration& codeAction )
 {
-    operator[]( Identifier::codeAction ) = Data::from_cbor( Data::to_cbor( codeAction ) );
+    operator[]( Identifier::codeAction ) = static_cast< const Data& >( codeAction );
 }
 
 u1 TextDocumentClientCapabilities::hasCodeLens( void ) const
@@ -1616,7 +1619,7 @@ DynamicRegistration TextDocumentClientCapabilities::codeLens( void ) const
 
 void TextDocumentClientCapabilities::setCodeLens( const DynamicRegistration& codeLens )
 {
-    operator[]( Identifier::codeLens ) = Data::from_cbor( Data::to_cbor( codeLens ) );
+    operator[]( Identifier::codeLens ) = static_cast< const Data& >( codeLens );
 }
 
 u1 TextDocumentClientCapabilities::hasDocumentLink( void ) const
@@ -1631,7 +1634,7 @@ DynamicRegistration TextDocumentClientCapabilities::documentLink( void ) const
 
 void TextDocumentClientCapabilities::setDocumentLink( const DynamicRegistration& documentLink )
 {
-    operator[]( Identifier::documentLink ) = Data::from_cbor( Data::to_cbor( documentLink ) );
+    operator[]( Identifier::documentLink ) = static_cast< const Data& >( documentLink );
 }
 
 u1 TextDocumentClientCapabilities::hasRename( void ) const
@@ -1646,7 +1649,7 @@ DynamicRegistration TextDocumentClientCapabilities::rename( void ) const
 
 void TextDocumentClientCapabilities::setRename( const DynamicRegistration& rename )
 {
-    operator[]( Identifier::rename ) = Data::from_cbor( Data::to_cbor( rename ) );
+    operator[]( Identifier::rename ) = static_cast< const Data& >( rename );
 }
 
 void TextDocumentClientCapabilities::validate( const Data& data )
@@ -1705,7 +1708,7 @@ WorkspaceClientCapabilities ClientCapabilities::workspace( void ) const
 
 void ClientCapabilities::setWorkspace( const WorkspaceClientCapabilities& workspace )
 {
-    operator[]( Identifier::workspace ) = Data::from_cbor( Data::to_cbor( workspace ) );
+    operator[]( Identifier::workspace ) = static_cast< const Data& >( workspace );
 }
 
 u1 ClientCapabilities::hasTextDocument( void ) const
@@ -1720,7 +1723,7 @@ TextDocumentClientCapabilities ClientCapabilities::textDocument( void ) const
 
 void ClientCapabilities::setTextDocument( const TextDocumentClientCapabilities& textDocument )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 u1 ClientCapabilities::hasExperimental( void ) const
@@ -1735,7 +1738,7 @@ Data ClientCapabilities::experimental( void ) const
 
 void ClientCapabilities::setExperimental( const Data& experimental )
 {
-    operator[]( Identifier::experimental ) = Data::from_cbor( Data::to_cbor( experimental ) );
+    operator[]( Identifier::experimental ) = static_cast< const Data& >( experimental );
 }
 
 void ClientCapabilities::validate( const Data& data )
@@ -1876,7 +1879,7 @@ SaveOptions TextDocumentSyncOptions::save( void ) const
 
 void TextDocumentSyncOptions::setSave( const SaveOptions& save )
 {
-    operator[]( Identifier::save ) = Data::from_cbor( Data::to_cbor( save ) );
+    operator[]( Identifier::save ) = static_cast< const Data& >( save );
 }
 
 void TextDocumentSyncOptions::validate( const Data& data )
@@ -2319,8 +2322,7 @@ u1 Workspace::hasWorkspaceFolders( void ) const
 
 void Workspace::setWorkspaceFolders( const Workspace::WorkspaceFolders& workspaceFolders )
 {
-    operator[]( Identifier::workspaceFolders ) =
-        Data::from_cbor( Data::to_cbor( workspaceFolders ) );
+    operator[]( Identifier::workspaceFolders ) = static_cast< const Data& >( workspaceFolders );
 }
 
 //
@@ -2419,8 +2421,7 @@ TextDocumentSyncOptions ServerCapabilities::textDocumentSync( void ) const
 
 void ServerCapabilities::setTextDocumentSync( const TextDocumentSyncOptions& textDocumentSync )
 {
-    operator[]( Identifier::textDocumentSync ) =
-        Data::from_cbor( Data::to_cbor( textDocumentSync ) );
+    operator[]( Identifier::textDocumentSync ) = static_cast< const Data& >( textDocumentSync );
 }
 
 void ServerCapabilities::setTextDocumentSync( const TextDocumentSyncKind& textDocumentSync )
@@ -2503,7 +2504,7 @@ void ServerCapabilities::setTypeDefinitionProvider(
     const TypeDefinitionProvider& typeDefinitionProvider )
 {
     operator[]( Identifier::typeDefinitionProvider ) =
-        Data::from_cbor( Data::to_cbor( typeDefinitionProvider ) );
+        static_cast< const Data& >( typeDefinitionProvider );
 }
 
 u1 ServerCapabilities::hasImplementationProvider( void ) const
@@ -2520,7 +2521,7 @@ void ServerCapabilities::setImplementationProvider(
     const ImplementationProvider& implementationProvider )
 {
     operator[]( Identifier::implementationProvider ) =
-        Data::from_cbor( Data::to_cbor( implementationProvider ) );
+        static_cast< const Data& >( implementationProvider );
 }
 
 u1 ServerCapabilities::hasReferencesProvider( void ) const
@@ -2610,8 +2611,7 @@ CodeLensOptions ServerCapabilities::codeLensProvider( void ) const
 
 void ServerCapabilities::setCodeLensProvider( const CodeLensOptions& codeLensProvider )
 {
-    operator[]( Identifier::codeLensProvider ) =
-        Data::from_cbor( Data::to_cbor( codeLensProvider ) );
+    operator[]( Identifier::codeLensProvider ) = static_cast< const Data& >( codeLensProvider );
 }
 
 u1 ServerCapabilities::hasDocumentFormattingProvider( void ) const
@@ -2659,7 +2659,7 @@ void ServerCapabilities::setDocumentOnTypeFormattingProvider(
     const DocumentOnTypeFormattingOptions& documentOnTypeFormattingProvider )
 {
     operator[]( Identifier::documentOnTypeFormattingProvider ) =
-        Data::from_cbor( Data::to_cbor( documentOnTypeFormattingProvider ) );
+        static_cast< const Data& >( documentOnTypeFormattingProvider );
 }
 
 u1 ServerCapabilities::hasRenameProvider( void ) const
@@ -2704,7 +2704,7 @@ ColorProvider ServerCapabilities::colorProvider( void ) const
 
 void ServerCapabilities::setColorProvider( const ColorProvider& colorProvider )
 {
-    operator[]( Identifier::colorProvider ) = Data::from_cbor( Data::to_cbor( colorProvider ) );
+    operator[]( Identifier::colorProvider ) = static_cast< const Data& >( colorProvider );
 }
 
 u1 ServerCapabilities::hasFoldingRangeProvider( void ) const
@@ -2720,7 +2720,7 @@ FoldingRangeProvider ServerCapabilities::foldingRangeProvider( void ) const
 void ServerCapabilities::setFoldingRangeProvider( const FoldingRangeProvider& foldingRangeProvider )
 {
     operator[]( Identifier::foldingRangeProvider ) =
-        Data::from_cbor( Data::to_cbor( foldingRangeProvider ) );
+        static_cast< const Data& >( foldingRangeProvider );
 }
 
 u1 ServerCapabilities::hasExecuteCommandProvider( void ) const
@@ -2737,7 +2737,7 @@ void ServerCapabilities::setExecuteCommandProvider(
     const ExecuteCommandOptions& executeCommandProvider )
 {
     operator[]( Identifier::executeCommandProvider ) =
-        Data::from_cbor( Data::to_cbor( executeCommandProvider ) );
+        static_cast< const Data& >( executeCommandProvider );
 }
 
 u1 ServerCapabilities::hasExperimental( void ) const
@@ -2752,7 +2752,7 @@ Data ServerCapabilities::experimental( void ) const
 
 void ServerCapabilities::setExperimental( const Data& experimental )
 {
-    operator[]( Identifier::experimental ) = Data::from_cbor( Data::to_cbor( experimental ) );
+    operator[]( Identifier::experimental ) = static_cast< const Data& >( experimental );
 }
 
 u1 ServerCapabilities::hasWorkspace( void ) const
@@ -2762,7 +2762,7 @@ u1 ServerCapabilities::hasWorkspace( void ) const
 
 void ServerCapabilities::setWorkspace( const Workspace& workspace )
 {
-    operator[]( Identifier::workspace ) = Data::from_cbor( Data::to_cbor( workspace ) );
+    operator[]( Identifier::workspace ) = static_cast< const Data& >( workspace );
 }
 
 Workspace ServerCapabilities::workspace( void ) const
@@ -2831,7 +2831,7 @@ InitializeParams::InitializeParams(
 {
     operator[]( Identifier::processId ) = processId;
     operator[]( Identifier::rootUri ) = rootUri.toString();
-    operator[]( Identifier::capabilities ) = Data::from_cbor( Data::to_cbor( capabilities ) );
+    operator[]( Identifier::capabilities ) = static_cast< const Data& >( capabilities );
 }
 
 std::size_t InitializeParams::processId( void ) const
@@ -2939,7 +2939,7 @@ InitializeResult::InitializeResult( const Data& data )
 InitializeResult::InitializeResult( const ServerCapabilities& capabilities )
 : Data( Data::object() )
 {
-    operator[]( Identifier::capabilities ) = Data::from_cbor( Data::to_cbor( capabilities ) );
+    operator[]( Identifier::capabilities ) = static_cast< const Data& >( capabilities );
 }
 
 ServerCapabilities InitializeResult::capabilities( void ) const
@@ -3111,7 +3111,7 @@ ShowMessageRequestResult::ShowMessageRequestResult( const Data& data )
 }
 
 ShowMessageRequestResult::ShowMessageRequestResult( const MessageActionItem& item )
-: Data( Data::from_cbor( Data::to_cbor( item ) ) )
+: Data( static_cast< const Data& >( item ) )
 {
 }
 
@@ -3279,7 +3279,7 @@ RegistrationParams::RegistrationParams( const Registrations& registrations )
 : Data( Data::object() )
 {
     operator[]( Identifier::registrations ) = Data::array();
-    for( auto registration : registrations )
+    for( const auto& registration : registrations )
     {
         operator[]( Identifier::registrations ).push_back( registration );
     }
@@ -3418,7 +3418,7 @@ UnregistrationParams::UnregistrationParams( const std::vector< Unregistration >&
 : Data( Data::object() )
 {
     operator[]( Identifier::unregistrations ) = Data::array();
-    for( auto unregistration : unregistrations )
+    for( const auto& unregistration : unregistrations )
     {
         operator[]( Identifier::unregistrations ).push_back( unregistration );
     }
@@ -3503,7 +3503,7 @@ WorkspaceFoldersResult::WorkspaceFoldersResult( const Data& data )
 WorkspaceFoldersResult::WorkspaceFoldersResult( const WorkspaceFolders& workspaceFolders )
 : Data( Data::array() )
 {
-    for( auto folder : workspaceFolders )
+    for( const auto& folder : workspaceFolders )
     {
         push_back( folder );
     }
@@ -3546,11 +3546,11 @@ WorkspaceFoldersChangeEvent::WorkspaceFoldersChangeEvent(
     operator[]( Identifier::added ) = Data::array();
     operator[]( Identifier::removed ) = Data::array();
 
-    for( auto element : added )
+    for( const auto& element : added )
     {
         operator[]( Identifier::added ).push_back( element );
     }
-    for( auto element : removed )
+    for( const auto& element : removed )
     {
         operator[]( Identifier::removed ).push_back( element );
     }
@@ -3609,7 +3609,7 @@ DidChangeWorkspaceFoldersParams::DidChangeWorkspaceFoldersParams( const Data& da
 DidChangeWorkspaceFoldersParams::DidChangeWorkspaceFoldersParams(
     const WorkspaceFoldersChangeEvent& event )
 {
-    operator[]( Identifier::event ) = Data::from_cbor( Data::to_cbor( event ) );
+    operator[]( Identifier::event ) = static_cast< const Data& >( event );
 }
 
 WorkspaceFoldersChangeEvent DidChangeWorkspaceFoldersParams::event( void ) const
@@ -3634,7 +3634,7 @@ DidChangeConfigurationParams::DidChangeConfigurationParams(
     const DidChangeConfigurationSettings& settings )
 : Data( Data::object() )
 {
-    operator[]( Identifier::settings ) = Data::from_cbor( Data::to_cbor( settings ) );
+    operator[]( Identifier::settings ) = static_cast< const Data& >( settings );
     validate( *this );
 }
 
@@ -3736,7 +3736,7 @@ ConfigurationParams::ConfigurationParams( const std::vector< ConfigurationItem >
 : Data( Data::object() )
 {
     operator[]( Identifier::items ) = Data::array();
-    for( auto item : items )
+    for( const auto& item : items )
     {
         operator[]( Identifier::items ).push_back( item );
     }
@@ -3812,7 +3812,7 @@ DidChangeWatchedFilesParams::DidChangeWatchedFilesParams( const std::vector< Fil
 : Data( Data::object() )
 {
     operator[]( Identifier::changes ) = Data::array();
-    for( auto change : changes )
+    for( const auto& change : changes )
     {
         operator[]( Identifier::changes ).push_back( change );
     }
@@ -3903,7 +3903,7 @@ DidChangeWatchedFilesRegistrationOptions::DidChangeWatchedFilesRegistrationOptio
 : Data( Data::object() )
 {
     operator[]( Identifier::watchers ) = Data::array();
-    for( auto watcher : watchers )
+    for( const auto& watcher : watchers )
     {
         operator[]( Identifier::watchers ).push_back( watcher );
     }
@@ -3976,7 +3976,7 @@ SymbolInformation::SymbolInformation(
 {
     operator[]( Identifier::name ) = name;
     operator[]( Identifier::kind ) = static_cast< std::size_t >( kind );
-    operator[]( Identifier::location ) = Data::from_cbor( Data::to_cbor( location ) );
+    operator[]( Identifier::location ) = static_cast< const Data& >( location );
 }
 
 SymbolInformation::SymbolInformation( const Data& data )
@@ -4055,7 +4055,7 @@ WorkspaceSymbolResult::WorkspaceSymbolResult( const Data& data )
 WorkspaceSymbolResult::WorkspaceSymbolResult( const SymbolInformations& symbolInformation )
 : Data( Data::array() )
 {
-    for( auto information : symbolInformation )
+    for( const auto& information : symbolInformation )
     {
         push_back( information );
     }
@@ -4105,7 +4105,7 @@ ApplyWorkspaceEditParams::ApplyWorkspaceEditParams( const Data& data )
 ApplyWorkspaceEditParams::ApplyWorkspaceEditParams( const WorkspaceEdit& edit )
 : Data( Data::object() )
 {
-    operator[]( Identifier::edit ) = Data::from_cbor( Data::to_cbor( edit ) );
+    operator[]( Identifier::edit ) = static_cast< const Data& >( edit );
 }
 
 WorkspaceEdit ApplyWorkspaceEditParams::edit( void ) const
@@ -4179,7 +4179,7 @@ DidOpenTextDocumentParams::DidOpenTextDocumentParams( const Data& data )
 DidOpenTextDocumentParams::DidOpenTextDocumentParams( const TextDocumentItem& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 TextDocumentItem DidOpenTextDocumentParams::textDocument( void ) const
@@ -4223,7 +4223,7 @@ Range TextDocumentContentChangeEvent::range( void ) const
 
 void TextDocumentContentChangeEvent::setRange( const Range& range )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 u1 TextDocumentContentChangeEvent::hasRangeLength( void ) const
@@ -4241,9 +4241,9 @@ void TextDocumentContentChangeEvent::setRangeLength( const std::size_t rangeLeng
     operator[]( Identifier::rangeLength ) = rangeLength;
 }
 
-std::string TextDocumentContentChangeEvent::text( void ) const
+const std::string& TextDocumentContentChangeEvent::text( void ) const
 {
-    return at( Identifier::text ).get< std::string >();
+    return at( Identifier::text ).get_ref< const std::string& >();
 }
 
 void TextDocumentContentChangeEvent::validate( const Data& data )
@@ -4271,10 +4271,10 @@ DidChangeTextDocumentParams::DidChangeTextDocumentParams(
     const TextDocumentContentChangeEvents& contentChanges )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
     operator[]( Identifier::contentChanges ) = Data::array();
 
-    for( auto contentChange : contentChanges )
+    for( const auto& contentChange : contentChanges )
     {
         operator[]( Identifier::contentChanges ).push_back( contentChange );
     }
@@ -4321,7 +4321,7 @@ WillSaveTextDocumentParams::WillSaveTextDocumentParams(
     const TextDocumentIdentifier& textDocument, const TextDocumentSaveReason reason )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
     operator[]( Identifier::reason ) = static_cast< std::size_t >( reason );
 }
 
@@ -4360,7 +4360,7 @@ WillSaveWaitUntilResponse::WillSaveWaitUntilResponse( const TextEdits& textEdit
 : Data( Data::object() )
 {
     operator[]( Identifier::textEdit ) = Data::array();
-    for( auto edit : textEdit )
+    for( const auto& edit : textEdit )
     {
         operator[]( Identifier::textEdit ).push_back( edit );
     }
@@ -4370,7 +4370,7 @@ TextEdits WillSaveWaitUntilResponse::textEdit( void ) const
 {
     auto textEdits = operator[]( Identifier::textEdit );
     auto result = TextEdits();
-    for( auto edit : textEdits )
+    for( const auto& edit : textEdits )
     {
         result.push_back( edit );
     }
@@ -4405,7 +4405,7 @@ DidSaveTextDocumentParams::DidSaveTextDocumentParams( const Data& data )
 DidSaveTextDocumentParams::DidSaveTextDocumentParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 u1 DidSaveTextDocumentParams::hasText( void ) const
@@ -4423,9 +4423,9 @@ TextDocumentIdentifier DidSaveTextDocumentParams::textDocument( void ) const
     return TextDocumentIdentifier( operator[]( Identifier::textDocument ) );
 }
 
-std::string DidSaveTextDocumentParams::text( void ) const
+const std::string& DidSaveTextDocumentParams::text( void ) const
 {
-    return at( Identifier::text ).get< std::string >();
+    return at( Identifier::text ).get_ref< const std::string& >();
 }
 
 void DidSaveTextDocumentParams::validate( const Data& data )
@@ -4445,7 +4445,7 @@ void DidSaveTextDocumentParams::validate( const Data& data )
 DidCloseTextDocumentParams::DidCloseTextDocumentParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 DidCloseTextDocumentParams::DidCloseTextDocumentParams( const Data& data )
@@ -4542,7 +4542,7 @@ u1 CompletionParams::hasContext( void ) const
 
 void CompletionParams::setContext( const CompletionContext& context )
 {
-    operator[]( Identifier::context ) = Data::from_cbor( Data::to_cbor( context ) );
+    operator[]( Identifier::context ) = static_cast< const Data& >( context );
 }
 
 void CompletionParams::validate( const Data& data )
@@ -4611,7 +4611,7 @@ u1 CompletionItem::hasDocumentation( void ) const
 
 void CompletionItem::setDocumentation( const MarkupContent& doc )
 {
-    operator[]( Identifier::documentation ) = Data::from_cbor( Data::to_cbor( doc ) );
+    operator[]( Identifier::documentation ) = static_cast< const Data& >( doc );
 }
 
 MarkupContent CompletionItem::documentation( void ) const
@@ -4717,7 +4717,7 @@ u1 CompletionItem::hasTextEdit( void ) const
 
 void CompletionItem::setTextEdit( const TextEdit& textEdit )
 {
-    operator[]( Identifier::textEdit ) = Data::from_cbor( Data::to_cbor( textEdit ) );
+    operator[]( Identifier::textEdit ) = static_cast< const Data& >( textEdit );
 }
 
 TextEdit CompletionItem::textEdit( void ) const
@@ -4786,7 +4786,7 @@ u1 CompletionItem::hasCommand( void ) const
 
 void CompletionItem::setCommand( const Command& command )
 {
-    operator[]( Identifier::command ) = Data::from_cbor( Data::to_cbor( command ) );
+    operator[]( Identifier::command ) = static_cast< const Data& >( command );
 }
 
 Command CompletionItem::command( void ) const
@@ -4847,7 +4847,7 @@ CompletionList::CompletionList( const u1 isIncomplete, const CompletionItems& it
 {
     operator[]( Identifier::isIncomplete ) = isIncomplete;
     operator[]( Identifier::items ) = Data::array();
-    for( auto item : items )
+    for( const auto& item : items )
     {
         operator[]( Identifier::items ).push_back( item );
     }
@@ -4893,7 +4893,7 @@ CompletionResult::CompletionResult( const Data& data )
 }
 
 CompletionResult::CompletionResult( const CompletionList& list )
-: Data( Data::from_cbor( Data::to_cbor( list ) ) )
+: Data( static_cast< const Data& >( list ) )
 {
 }
 
@@ -4902,7 +4902,7 @@ CompletionResult::CompletionResult( const CompletionItems& items )
 {
     operator[]( Identifier::isIncomplete ) = false;
     operator[]( Identifier::items ) = Data::array();
-    for( auto item : items )
+    for( const auto& item : items )
     {
         operator[]( Identifier::items ).push_back( item );
     }
@@ -4947,7 +4947,7 @@ TriggerCharacters CompletionRegistrationOptions::triggerCharacters( void ) const
 {
     auto triggerCharacters = at( Identifier::triggerCharacters );
     auto result = TriggerCharacters();
-    for( auto triggerCharacter : triggerCharacters )
+    for( const auto& triggerCharacter : triggerCharacters )
     {
         result.push_back( triggerCharacter );
     }
@@ -5080,7 +5080,7 @@ u1 ParameterInformation::hasDocumentation( void ) const
 
 void ParameterInformation::setDocumentation( const MarkupContent& doc )
 {
-    operator[]( Identifier::documentation ) = Data::from_cbor( Data::to_cbor( doc ) );
+    operator[]( Identifier::documentation ) = static_cast< const Data& >( doc );
 }
 
 void ParameterInformation::validate( const Data& data )
@@ -5125,7 +5125,7 @@ u1 SignatureInformation::hasDocumentation( void ) const
 
 void SignatureInformation::setDocumentation( const MarkupContent& doc )
 {
-    operator[]( Identifier::documentation ) = Data::from_cbor( Data::to_cbor( doc ) );
+    operator[]( Identifier::documentation ) = static_cast< const Data& >( doc );
 }
 
 u1 SignatureInformation::hasParameters( void ) const
@@ -5147,7 +5147,7 @@ void SignatureInformation::setParameters( const ParameterInformations& parameter
 {
     operator[]( Identifier::parameters ) = Data::array();
 
-    for( auto parameter : parameters )
+    for( const auto& parameter : parameters )
     {
         operator[]( Identifier::parameters ).push_back( parameter );
     }
@@ -5178,7 +5178,7 @@ SignatureHelp::SignatureHelp( const SignatureInformations& signatures )
 : Data( Data::object() )
 {
     operator[]( Identifier::signatures ) = Data::array();
-    for( auto signature : signatures )
+    for( const auto& signature : signatures )
     {
         operator[]( Identifier::signatures ).push_back( signature );
     }
@@ -5251,7 +5251,7 @@ SignatureHelpResult::SignatureHelpResult( const Data& data )
 }
 
 SignatureHelpResult::SignatureHelpResult( const SignatureHelp& signature )
-: Data( Data::from_cbor( Data::to_cbor( signature ) ) )
+: Data( static_cast< const Data& >( signature ) )
 {
 }
 
@@ -5280,7 +5280,7 @@ LocationLink::LocationLink( const DocumentUri& targetUri, const Range& targetRan
 : Data( Data::object() )
 {
     operator[]( Identifier::targetUri ) = targetUri.toString();
-    operator[]( Identifier::targetRange ) = Data::from_cbor( Data::to_cbor( targetRange ) );
+    operator[]( Identifier::targetRange ) = static_cast< const Data& >( targetRange );
 }
 
 DocumentUri LocationLink::targetUri( void ) const
@@ -5300,7 +5300,7 @@ u1 LocationLink::hasOriginSelectionRange( void ) const
 
 void LocationLink::setOriginSelectionRange( const Range& range )
 {
-    operator[]( Identifier::originSelectionRange ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::originSelectionRange ) = static_cast< const Data& >( range );
 }
 
 Range LocationLink::originSelectionRange( void ) const
@@ -5315,7 +5315,7 @@ u1 LocationLink::hasTargetSelectionRange( void ) const
 
 void LocationLink::setTargetSelectionRange( const Range& range )
 {
-    operator[]( Identifier::targetSelectionRange ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::targetSelectionRange ) = static_cast< const Data& >( range );
 }
 
 Range LocationLink::targetSelectionRange( void ) const
@@ -5399,7 +5399,7 @@ void SignatureHelpRegistrationOptions::setTriggerCharacters(
     const TriggerCharacters& triggerCharacters )
 {
     operator[]( Identifier::triggerCharacters ) = Data::array();
-    for( auto character : triggerCharacters )
+    for( const auto& character : triggerCharacters )
     {
         operator[]( Identifier::triggerCharacters ).push_back( character );
     }
@@ -5446,7 +5446,7 @@ TypeDefinitionResult::TypeDefinitionResult( const Data& data )
 TypeDefinitionResult::TypeDefinitionResult( const Locations& locations )
 : Data( Data::array() )
 {
-    for( auto location : locations )
+    for( const auto& location : locations )
     {
         push_back( location );
     }
@@ -5455,15 +5455,15 @@ TypeDefinitionResult::TypeDefinitionResult( const Locations& locations )
 TypeDefinitionResult::TypeDefinitionResult( const LocationLinks& locationlinks )
 : Data( Data::array() )
 {
-    for( auto link : locationlinks )
+    for( const auto& link : locationlinks )
     {
         push_back( link );
     }
 }
 
 TypeDefinitionResult::TypeDefinitionResult( const Location& location )
+: Data( static_cast< const Data& >( location ) )
 {
-    *this = Data::from_cbor( Data::to_cbor( location ) );
 }
 
 void TypeDefinitionResult::validate( const Data& data )
@@ -5532,7 +5532,7 @@ ReferenceParams::ReferenceParams(
     const ReferenceContext& context )
 : TextDocumentPositionParams( textDocument, position )
 {
-    operator[]( Identifier::context ) = Data::from_cbor( Data::to_cbor( context ) );
+    operator[]( Identifier::context ) = static_cast< const Data& >( context );
 }
 
 ReferenceContext ReferenceParams::context( void ) const
@@ -5561,7 +5561,7 @@ ReferenceResult::ReferenceResult( const Data& data )
 ReferenceResult::ReferenceResult( const Locations& locations )
 : Data( Data::array() )
 {
-    for( auto location : locations )
+    for( const auto& location : locations )
     {
         push_back( location );
     }
@@ -5674,7 +5674,7 @@ CodeActionContext::CodeActionContext( const std::vector< Diagnostic >& diagnosti
 {
     operator[]( Identifier::diagnostics ) = Data::array();
 
-    for( auto diagnostic : diagnostics )
+    for( const auto& diagnostic : diagnostics )
     {
         operator[]( Identifier::diagnostics ).push_back( diagnostic );
     }
@@ -5767,9 +5767,9 @@ CodeActionParams::CodeActionParams(
     const CodeActionContext& context )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
-    operator[]( Identifier::context ) = Data::from_cbor( Data::to_cbor( context ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
+    operator[]( Identifier::context ) = static_cast< const Data& >( context );
 }
 
 TextDocumentIdentifier CodeActionParams::textDocument( void ) const
@@ -5939,12 +5939,12 @@ WorkspaceEdit CodeAction::edit( void ) const
 
 void CodeAction::setEdit( const WorkspaceEdit& edit )
 {
-    operator[]( Identifier::edit ) = Data::from_cbor( Data::to_cbor( edit ) );
+    operator[]( Identifier::edit ) = static_cast< const Data& >( edit );
 }
 
 void CodeAction::setCommand( const Command& command )
 {
-    operator[]( Identifier::command ) = Data::from_cbor( Data::to_cbor( command ) );
+    operator[]( Identifier::command ) = static_cast< const Data& >( command );
 }
 
 u1 CodeAction::hasCommand( void ) const
@@ -5984,14 +5984,30 @@ PublishDiagnosticsParams::PublishDiagnosticsParams(
 : Data( Data::object() )
 {
     operator[]( Identifier::uri ) = uri.toString();
-    operator[]( Identifier::diagnostics ) = Data::array();
+    auto& array = operator[]( Identifier::diagnostics ) = Data::array();
+    array.get_ref< Data::array_t& >().reserve( diagnostics.size() );
 
-    for( auto diagnostic : diagnostics )
+    for( const auto& diagnostic : diagnostics )
     {
-        operator[]( Identifier::diagnostics ).push_back( diagnostic );
+        array.push_back( static_cast< const Data& >( diagnostic ) );
     }
 }
 
+PublishDiagnosticsParams::PublishDiagnosticsParams(
+    const DocumentUri& uri, std::vector< Diagnostic >&& diagnostics )
+: Data( Data::object() )
+{
+    operator[]( Identifier::uri ) = uri.toString();
+    auto& array = operator[]( Identifier::diagnostics ) = Data::array();
+    array.get_ref< Data::array_t& >().reserve( diagnostics.size() );
+
+    for( auto& diagnostic : diagnostics )
+    {
+        array.push_back( static_cast< Data&& >( diagnostic ) );
+    }
+    diagnostics.clear();
+}
+
 DocumentUri PublishDiagnosticsParams::uri( void ) const
 {
     return DocumentUri::fromString( at( Identifier::uri ).get< std::string >() );
@@ -6105,7 +6121,7 @@ Range HoverResult::range( void ) const
 
 void HoverResult::setRange( const Range& range )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 void HoverResult::validate( const Data& data )
@@ -6161,7 +6177,7 @@ DefinitionResult::DefinitionResult( const Locations& locations )
 {
     operator[]( Identifier::location ) = Data::array();
 
-    for( auto location : locations )
+    for( const auto& location : locations )
     {
         operator[]( Identifier::location ).push_back( location );
     }
@@ -6222,7 +6238,7 @@ DocumentHighlight::DocumentHighlight( const Data& data )
 DocumentHighlight::DocumentHighlight( const Range& range )
 : Data( Data::object() )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 Range DocumentHighlight::range( void ) const
 {
@@ -6268,7 +6284,7 @@ DocumentHighlightResult::DocumentHighlightResult( const Data& data )
 DocumentHighlightResult::DocumentHighlightResult( const DocumentHighlights& highlights )
 : Data( Data::array() )
 {
-    for( auto highlight : highlights )
+    for( const auto& highlight : highlights )
     {
         push_back( highlight );
     }
@@ -6296,7 +6312,7 @@ void DocumentHighlightResult::validate( const Data& data )
 DocumentSymbolParams::DocumentSymbolParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 DocumentSymbolParams::DocumentSymbolParams( const Data& data )
@@ -6378,8 +6394,8 @@ DocumentSymbol::DocumentSymbol(
 {
     operator[]( Identifier::name ) = name;
     operator[]( Identifier::kind ) = static_cast< std::size_t >( kind );
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
-    operator[]( Identifier::selectionRange ) = Data::from_cbor( Data::to_cbor( selectionRange ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
+    operator[]( Identifier::selectionRange ) = static_cast< const Data& >( selectionRange );
 }
 
 std::string DocumentSymbol::name( void ) const
@@ -6483,7 +6499,7 @@ CodeLensParams::CodeLensParams( const Data& data )
 CodeLensParams::CodeLensParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 TextDocumentIdentifier CodeLensParams::textDocument( void ) const
@@ -6513,7 +6529,7 @@ CodeLens::CodeLens( const Data& data )
 CodeLens::CodeLens( const Range& range )
 : Data( Data::object() )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 Range CodeLens::range( void ) const
@@ -6533,7 +6549,7 @@ Command CodeLens::command( void ) const
 
 void CodeLens::setCommand( const Command& command )
 {
-    operator[]( Identifier::command ) = Data::from_cbor( Data::to_cbor( command ) );
+    operator[]( Identifier::command ) = static_cast< const Data& >( command );
 }
 
 u1 CodeLens::hasData( void ) const
@@ -6548,7 +6564,7 @@ Data CodeLens::data( void ) const
 
 void CodeLens::setData( const Data& data )
 {
-    operator[]( Identifier::data ) = Data::from_cbor( Data::to_cbor( data ) );
+    operator[]( Identifier::data ) = data;
 }
 
 void CodeLens::validate( const Data& data )
@@ -6657,7 +6673,7 @@ DocumentLinkParams::DocumentLinkParams( const Data& data )
 DocumentLinkParams::DocumentLinkParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 TextDocumentIdentifier DocumentLinkParams::textDocument( void ) const
@@ -6687,7 +6703,7 @@ DocumentLink::DocumentLink( const Data& data )
 DocumentLink::DocumentLink( const Range& range )
 : Data( Data::object() )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 Range DocumentLink::range( void ) const
@@ -6717,7 +6733,7 @@ u1 DocumentLink::hasData( void ) const
 
 void DocumentLink::setData( const Data& data )
 {
-    operator[]( Identifier::data ) = Data::from_cbor( Data::to_cbor( data ) );
+    operator[]( Identifier::data ) = data;
 }
 
 Data DocumentLink::data( void ) const
@@ -6752,7 +6768,7 @@ DocumentLinkResult::DocumentLinkResult( const Data& data )
 DocumentLinkResult::DocumentLinkResult( const DocumentLinks links )
 : Data( Data::array() )
 {
-    for( auto link : links )
+    for( const auto& link : links )
     {
         push_back( link );
     }
@@ -6785,7 +6801,7 @@ DocumentColorParams::DocumentColorParams( const Data& data )
 DocumentColorParams::DocumentColorParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 TextDocumentIdentifier DocumentColorParams::textDocument( void ) const
@@ -6870,8 +6886,8 @@ ColorInformation::ColorInformation( const Data& data )
 
 ColorInformation::ColorInformation( const Range& range, const Color& color )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
-    operator[]( Identifier::color ) = Data::from_cbor( Data::to_cbor( color ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
+    operator[]( Identifier::color ) = static_cast< const Data& >( color );
 }
 
 Range ColorInformation::range( void ) const
@@ -6906,7 +6922,7 @@ DocumentColorResult::DocumentColorResult( const Data& data )
 DocumentColorResult::DocumentColorResult( const ColorInformations& colorInformations )
 : Data( Data::array() )
 {
-    for( auto colorInformation : colorInformations )
+    for( const auto& colorInformation : colorInformations )
     {
         push_back( colorInformation );
     }
@@ -6933,8 +6949,8 @@ ColorPresentationParams::ColorPresentationParams(
     const TextDocumentIdentifier& textDocument, const Color& color, const Range& range )
 : DocumentColorParams( textDocument )
 {
-    operator[]( Identifier::color ) = Data::from_cbor( Data::to_cbor( color ) );
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::color ) = static_cast< const Data& >( color );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 Color ColorPresentationParams::color( void ) const
@@ -6979,7 +6995,7 @@ u1 ColorPresentation::hasTextEdit( void ) const
 
 void ColorPresentation::setTextEdit( const TextEdit& textEdit )
 {
-    operator[]( Identifier::textEdit ) = Data::from_cbor( Data::to_cbor( textEdit ) );
+    operator[]( Identifier::textEdit ) = static_cast< const Data& >( textEdit );
 }
 
 TextEdit ColorPresentation::textEdit( void ) const
@@ -7030,7 +7046,7 @@ ColorPresentationResult::ColorPresentationResult( const Data& data )
 ColorPresentationResult::ColorPresentationResult( ColorPresentations presentations )
 : Data( Data::array() )
 {
-    for( auto presentation : presentations )
+    for( const auto& presentation : presentations )
     {
         push_back( presentation );
     }
@@ -7057,8 +7073,8 @@ DocumentFormattingParams::DocumentFormattingParams(
     const TextDocumentIdentifier& textDocument, const FormattingOptions& options )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
-    operator[]( Identifier::options ) = Data::from_cbor( Data::to_cbor( options ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
+    operator[]( Identifier::options ) = static_cast< const Data& >( options );
 }
 
 TextDocumentIdentifier DocumentFormattingParams::textDocument( void ) const
@@ -7166,7 +7182,7 @@ DocumentFormattingResult::DocumentFormattingResult( const Data& data )
 DocumentFormattingResult::DocumentFormattingResult( const TextEdits& edits )
 : Data( Data::array() )
 {
-    for( auto edit : edits )
+    for( const auto& edit : edits )
     {
         push_back( edit );
     }
@@ -7195,7 +7211,7 @@ DocumentRangeFormattingParams::DocumentRangeFormattingParams(
     const FormattingOptions& options )
 : DocumentFormattingParams( textDocument, options )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
 }
 
 Range DocumentRangeFormattingParams::range( void ) const
@@ -7228,7 +7244,7 @@ DocumentOnTypeFormattingParams::DocumentOnTypeFormattingParams(
     const std::string& ch )
 : DocumentFormattingParams( textDocument, options )
 {
-    operator[]( Identifier::position ) = Data::from_cbor( Data::to_cbor( position ) );
+    operator[]( Identifier::position ) = static_cast< const Data& >( position );
     operator[]( Identifier::ch ) = ch;
 }
 
@@ -7324,8 +7340,8 @@ RenameParams::RenameParams(
     const std::string& newName )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
-    operator[]( Identifier::position ) = Data::from_cbor( Data::to_cbor( position ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
+    operator[]( Identifier::position ) = static_cast< const Data& >( position );
     operator[]( Identifier::newName ) = newName;
 }
 
@@ -7404,7 +7420,7 @@ RenameResult::RenameResult( const Data& data )
 }
 
 RenameResult::RenameResult( const WorkspaceEdit& edit )
-: Data( Data::from_cbor( Data::to_cbor( edit ) ) )
+: Data( static_cast< const Data& >( edit ) )
 {
 }
 
@@ -7438,7 +7454,7 @@ PrepareRenameResult::PrepareRenameResult( const Data& data )
 PrepareRenameResult::PrepareRenameResult( const Range& range, const std::string& placeholder )
 : Data( Data::object() )
 {
-    operator[]( Identifier::range ) = Data::from_cbor( Data::to_cbor( range ) );
+    operator[]( Identifier::range ) = static_cast< const Data& >( range );
     operator[]( Identifier::placeholder ) = placeholder;
 }
 
@@ -7476,7 +7492,7 @@ FoldingRangeParams::FoldingRangeParams( const Data& data )
 FoldingRangeParams::FoldingRangeParams( const TextDocumentIdentifier& textDocument )
 : Data( Data::object() )
 {
-    operator[]( Identifier::textDocument ) = Data::from_cbor( Data::to_cbor( textDocument ) );
+    operator[]( Identifier::textDocument ) = static_cast< const Data& >( textDocument );
 }
 
 TextDocumentIdentifier FoldingRangeParams::textDocument( void ) const
@@ -7612,7 +7628,7 @@ FoldingRangeResult::FoldingRangeResult( const Data& data )
 FoldingRangeResult::FoldingRangeResult( const FoldingRanges& ranges )
 : Data( Data::array() )
 {
-    for( auto range : ranges )
+    for( const auto& range : ranges )
     {
         push_back( range );
     }
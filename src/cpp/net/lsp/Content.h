@@ -100,6 +100,8 @@ namespace libstdhl
 
                 void setData( const Data& data );
 
+                void setData( Data&& data );
+
                 static void validate( const Data& data );
             };
 
@@ -427,7 +429,7 @@ namespace libstdhl
 
                 std::size_t version( void ) const;
 
-                std::string text( void ) const;
+                const std::string& text( void ) const;
 
                 static void validate( const Data& data );
             };
@@ -1805,7 +1807,7 @@ namespace libstdhl
 
                 void setRangeLength( const std::size_t rangeLength );
 
-                std::string text( void ) const;
+                const std::string& text( void ) const;
 
                 static void validate( const Data& data );
             };
@@ -1878,7 +1880,7 @@ namespace libstdhl
 
                 TextDocumentIdentifier textDocument( void ) const;
 
-                std::string text( void ) const;
+                const std::string& text( void ) const;
 
                 static void validate( const Data& data );
             };
@@ -2444,6 +2446,8 @@ namespace libstdhl
 
                 PublishDiagnosticsParams( const DocumentUri& uri, const Diagnostics& diagnostics );
 
+                PublishDiagnosticsParams( const DocumentUri& uri, Diagnostics&& diagnostics );
+
                 DocumentUri uri( void ) const;
 
                 Diagnostics diagnostics( void ) const;
@@ -0,0 +1,384 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Dispatcher.h"
+
+#include "Identifier.h"
+#include "Interface.h"
+
+#include <cstring>
+#include <type_traits>
+
+using namespace libstdhl;
+using namespace Network;
+using namespace LSP;
+
+//
+//
+// Dispatcher
+//
+
+namespace
+{
+    /**
+       all client to server methods handled by the 'ServerInterface'
+    */
+    static constexpr const char* Builtins[] = {
+        // general
+        Identifier::initialize,
+        Identifier::initialized,
+        Identifier::shutdown,
+        Identifier::exit,
+        Identifier::cancelRequest,
+        // workspace
+        Identifier::workspace_didChangeWorkspaceFolders,
+        Identifier::workspace_didChangeConfiguration,
+        Identifier::workspace_didChangeWatchedFiles,
+        Identifier::workspace_symbol,
+        Identifier::workspace_executeCommand,
+        // document
+        Identifier::textDocument_didOpen,
+        Identifier::textDocument_didChange,
+        Identifier::textDocument_willSave,
+        Identifier::textDocument_willSaveWaitUntil,
+        Identifier::textDocument_didSave,
+        Identifier::textDocument_didClose,
+        // language features
+        Identifier::textDocument_completion,
+        Identifier::completionItem_resolve,
+        Identifier::textDocument_hover,
+        Identifier::textDocument_signatureHelp,
+        Identifier::textDocument_definition,
+        Identifier::textDocument_typeDefinition,
+        Identifier::textDocument_implementation,
+        Identifier::textDocument_references,
+        Identifier::textDocument_documentHighlight,
+        Identifier::textDocument_documentSymbol,
+        Identifier::textDocument_codeAction,
+        Identifier::textDocument_codeLens,
+        Identifier::codeLens_resolve,
+        Identifier::textDocument_documentLink,
+        Identifier::documentLink_resolve,
+        Identifier::textDocument_documentColor,
+        Identifier::textDocument_colorPresentation,
+        Identifier::textDocument_formatting,
+        Identifier::textDocument_rangeFormatting,
+        Identifier::textDocument_onTypeFormatting,
+        Identifier::textDocument_rename,
+        Identifier::textDocument_prepareRename,
+        Identifier::textDocument_foldingRange,
+    };
+
+    static constexpr std::size_t Mask = Dispatcher::Capacity - 1;
+
+    static constexpr std::size_t Limit = Dispatcher::Capacity / 4 * 3;
+
+    static constexpr std::size_t length( const char* name )
+    {
+        std::size_t size = 0;
+        while( name[ size ] )
+        {
+            size++;
+        }
+        return size;
+    }
+
+    static constexpr u1 perfect( const u64 seed )
+    {
+        u1 used[ Dispatcher::Capacity ] = {};
+        for( const auto name : Builtins )
+        {
+            const auto slot = Dispatcher::hash( name, length( name ), seed ) & Mask;
+            if( used[ slot ] )
+            {
+                return false;
+            }
+            used[ slot ] = true;
+        }
+        return true;
+    }
+
+    static constexpr u64 search( void )
+    {
+        for( u64 seed = 0; seed < 4096; seed++ )
+        {
+            if( perfect( seed ) )
+            {
+                return seed;
+            }
+        }
+        return ~0ull;
+    }
+
+    static constexpr u64 Seed = search();
+
+    static_assert( Seed != ~0ull, "no perfect hash seed for the built-in methods" );
+
+    static_assert( ( Dispatcher::Capacity & Mask ) == 0, "capacity has to be a power of two" );
+
+    template < typename Base, typename Params >
+    static void validate( const Data& params )
+    {
+        if( std::is_base_of< Base, Params >::value and not std::is_same< Base, Params >::value )
+        {
+            Base::validate( params );
+        }
+    }
+
+    /**
+       validates the parameters like the constructor of 'Params' and provides them in
+       place, parameter types only add accessors to 'Data' (see 'Message::process')
+    */
+    template < typename Params >
+    static const Params& parameters( const Data& params )
+    {
+        static_assert( sizeof( Params ) == sizeof( Data ), "parameters must not add members" );
+
+        validate< TextDocumentPositionParams, Params >( params );
+        validate< DocumentColorParams, Params >( params );
+        validate< DocumentFormattingParams, Params >( params );
+        Params::validate( params );
+
+        return reinterpret_cast< const Params& >( params );
+    }
+
+    template < typename Params, typename Result >
+    static Dispatcher::Request request( Result ( ServerInterface::*method )( const Params& ) )
+    {
+        return [method]( ServerInterface& interface, const Data& params ) -> Data {
+            auto result = ( interface.*method )( parameters< Params >( params ) );
+            return static_cast< Data&& >( result );
+        };
+    }
+
+    template < typename Params >
+    static Dispatcher::Notification notification(
+        void ( ServerInterface::*method )( const Params& ) )
+    {
+        return [method]( ServerInterface& interface, const Data& params ) {
+            ( interface.*method )( parameters< Params >( params ) );
+        };
+    }
+}
+
+Dispatcher::Dispatcher( void )
+: m_methods()
+, m_size( 0 )
+{
+    using I = ServerInterface;
+
+    // general, the lifetime methods wait for all scheduled work and cancellation
+    // has to reach requests which are still running
+    registerRequest(
+        Identifier::initialize, request( &I::initialize ), Execution::SEQUENTIAL );
+    registerNotification(
+        Identifier::initialized,
+        []( ServerInterface& interface, const Data& ) { interface.initialized(); },
+        Execution::SEQUENTIAL );
+    registerRequest(
+        Identifier::shutdown,
+        []( ServerInterface& interface, const Data& ) {
+            interface.shutdown();
+            return Data( nullptr );
+        },
+        Execution::SEQUENTIAL );
+    registerNotification(
+        Identifier::exit,
+        []( ServerInterface& interface, const Data& ) { interface.exit(); },
+        Execution::SEQUENTIAL );
+    registerNotification(
+        Identifier::cancelRequest,
+        []( ServerInterface& interface, const Data& params ) {
+            const auto& cancel = parameters< CancelParams >( params );
+            interface.cancel( cancel.id() );
+            interface.client_cancel( cancel );
+        },
+        Execution::IMMEDIATE );
+
+    // workspace
+    registerNotification(
+        Identifier::workspace_didChangeWorkspaceFolders,
+        notification( &I::workspace_didChangeWorkspaceFolders ) );
+    registerNotification(
+        Identifier::workspace_didChangeConfiguration,
+        notification( &I::workspace_didChangeConfiguration ) );
+    registerNotification(
+        Identifier::workspace_didChangeWatchedFiles,
+        notification( &I::workspace_didChangeWatchedFiles ) );
+    registerRequest( Identifier::workspace_symbol, request( &I::workspace_symbol ) );
+    registerRequest(
+        Identifier::workspace_executeCommand, request( &I::workspace_executeCommand ) );
+
+    // document
+    registerNotification(
+        Identifier::textDocument_didOpen, notification( &I::textDocument_didOpen ) );
+    registerNotification(
+        Identifier::textDocument_didChange, notification( &I::textDocument_didChange ) );
+    registerNotification(
+        Identifier::textDocument_willSave, notification( &I::textDocument_willSave ) );
+    registerRequest(
+        Identifier::textDocument_willSaveWaitUntil,
+        request( &I::textDocument_willSaveWaitUntil ) );
+    registerNotification(
+        Identifier::textDocument_didSave, notification( &I::textDocument_didSave ) );
+    registerNotification(
+        Identifier::textDocument_didClose, notification( &I::textDocument_didClose ) );
+
+    // language features
+    registerRequest( Identifier::textDocument_completion, request( &I::textDocument_completion ) );
+    registerRequest( Identifier::completionItem_resolve, request( &I::completionItem_resolve ) );
+    registerRequest( Identifier::textDocument_hover, request( &I::textDocument_hover ) );
+    registerRequest(
+        Identifier::textDocument_signatureHelp, request( &I::textDocument_signatureHelp ) );
+    registerRequest( Identifier::textDocument_definition, request( &I::textDocument_definition ) );
+    registerRequest(
+        Identifier::textDocument_typeDefinition, request( &I::textDocument_typeDefinition ) );
+    registerRequest(
+        Identifier::textDocument_implementation, request( &I::textDocument_implementation ) );
+    registerRequest( Identifier::textDocument_references, request( &I::textDocument_references ) );
+    registerRequest(
+        Identifier::textDocument_documentHighlight,
+        request( &I::textDocument_documentHighlight ) );
+    registerRequest(
+        Identifier::textDocument_documentSymbol, request( &I::textDocument_documentSymbol ) );
+    registerRequest( Identifier::textDocument_codeAction, request( &I::textDocument_codeAction ) );
+    registerRequest( Identifier::textDocument_codeLens, request( &I::textDocument_codeLens ) );
+    registerRequest( Identifier::codeLens_resolve, request( &I::codeLens_resolve ) );
+    registerRequest(
+        Identifier::textDocument_documentLink, request( &I::textDocument_documentLink ) );
+    registerRequest( Identifier::documentLink_resolve, request( &I::documentLink_resolve ) );
+    registerRequest(
+        Identifier::textDocument_documentColor, request( &I::textDocument_documentColor ) );
+    registerRequest(
+        Identifier::textDocument_colorPresentation,
+        request( &I::textDocument_colorPresentation ) );
+    registerRequest( Identifier::textDocument_formatting, request( &I::textDocument_formatting ) );
+    registerRequest(
+        Identifier::textDocument_rangeFormatting, request( &I::textDocument_rangeFormatting ) );
+    registerRequest(
+        Identifier::textDocument_onTypeFormatting, request( &I::textDocument_onTypeFormatting ) );
+    registerRequest( Identifier::textDocument_rename, request( &I::textDocument_rename ) );
+    registerRequest(
+        Identifier::textDocument_prepareRename, request( &I::textDocument_prepareRename ) );
+    registerRequest(
+        Identifier::textDocument_foldingRange, request( &I::textDocument_foldingRange ) );
+}
+
+void Dispatcher::registerRequest(
+    const std::string& name, const Request& handler, const Execution execution )
+{
+    auto& method = emplace( name );
+    method.request = handler;
+    method.notification = nullptr;
+    method.execution = execution;
+}
+
+void Dispatcher::registerNotification(
+    const std::string& name, const Notification& handler, const Execution execution )
+{
+    auto& method = emplace( name );
+    method.request = nullptr;
+    method.notification = handler;
+    method.execution = execution;
+}
+
+const Dispatcher::Method* Dispatcher::find( const char* name, const std::size_t size ) const
+{
+    auto slot = hash( name, size, Seed ) & Mask;
+    while( not m_methods[ slot ].name.empty() )
+    {
+        const auto& method = m_methods[ slot ];
+        if( method.name.size() == size and std::memcmp( method.name.data(), name, size ) == 0 )
+        {
+            return &method;
+        }
+        slot = ( slot + 1 ) & Mask;
+    }
+    return nullptr;
+}
+
+const Dispatcher::Method* Dispatcher::find( const std::string& name ) const
+{
+    return find( name.data(), name.size() );
+}
+
+std::size_t Dispatcher::size( void ) const
+{
+    return m_size;
+}
+
+Dispatcher::Method& Dispatcher::emplace( const std::string& name )
+{
+    if( name.empty() )
+    {
+        throw std::invalid_argument( "LSP: dispatcher: method name is empty" );
+    }
+
+    auto slot = hash( name.data(), name.size(), Seed ) & Mask;
+    while( not m_methods[ slot ].name.empty() )
+    {
+        if( m_methods[ slot ].name == name )
+        {
+            return m_methods[ slot ];
+        }
+        slot = ( slot + 1 ) & Mask;
+    }
+
+    if( m_size >= Limit )
+    {
+        throw std::domain_error(
+            "LSP: dispatcher: unable to register '" + name + "', table is full" );
+    }
+
+    m_size++;
+    m_methods[ slot ].name = name;
+    return m_methods[ slot ];
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
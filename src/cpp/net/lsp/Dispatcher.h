@@ -0,0 +1,174 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_NETWORK_LSP_DISPATCHER_H_
+#define _LIBSTDHL_CPP_NETWORK_LSP_DISPATCHER_H_
+
+#include <libstdhl/net/lsp/Message>
+
+#include <array>
+#include <functional>
+
+/**
+   @brief    TBD
+
+   TBD
+*/
+
+namespace libstdhl
+{
+    namespace Network
+    {
+        namespace LSP
+        {
+            class ServerInterface;
+
+            /**
+               Method table of request and notification handlers.
+
+               The names of all client to server methods of the protocol are placed with a
+               perfect hash whose seed is searched at compile time, so looking up a known
+               method costs one hash and one string comparison. Registered custom methods
+               share the table and are placed by linear probing behind the built-in ones.
+            */
+            class Dispatcher final
+            {
+              public:
+                using Request =
+                    std::function< Data( ServerInterface& interface, const Data& params ) >;
+
+                using Notification =
+                    std::function< void( ServerInterface& interface, const Data& params ) >;
+
+                /**
+                   how a method is scheduled if the 'ServerInterface' has workers
+                */
+                enum class Execution : u8
+                {
+                    CONCURRENT,  // on the workers, notifications in order per document
+                    SEQUENTIAL,  // on the reading thread after all scheduled work finished
+                    IMMEDIATE    // on the reading thread right away
+                };
+
+                struct Method
+                {
+                    std::string name;
+
+                    Request request;
+
+                    Notification notification;
+
+                    Execution execution;
+                };
+
+                /**
+                   amount of slots, at most three quarters are used to keep probing short
+                */
+                static constexpr std::size_t Capacity = 256;
+
+                static constexpr u64 hash(
+                    const char* name, const std::size_t size, const u64 seed )
+                {
+                    u64 value = 0xcbf29ce484222325ull ^ seed;
+                    for( std::size_t i = 0; i < size; i++ )
+                    {
+                        value ^= static_cast< u8 >( name[ i ] );
+                        value *= 0x100000001b3ull;
+                    }
+                    return value ^ ( value >> 29 );
+                }
+
+                /**
+                   table with the handlers of all methods of the 'ServerInterface'
+                */
+                Dispatcher( void );
+
+                /**
+                   adds or replaces the handler of the request 'name'
+                */
+                void registerRequest(
+                    const std::string& name,
+                    const Request& handler,
+                    const Execution execution = Execution::CONCURRENT );
+
+                /**
+                   adds or replaces the handler of the notification 'name'
+                */
+                void registerNotification(
+                    const std::string& name,
+                    const Notification& handler,
+                    const Execution execution = Execution::CONCURRENT );
+
+                /**
+                   method named [name, name + size) or 'nullptr', does not allocate
+                */
+                const Method* find( const char* name, const std::size_t size ) const;
+
+                const Method* find( const std::string& name ) const;
+
+                /**
+                   amount of registered methods
+                */
+                std::size_t size( void ) const;
+
+              private:
+                Method& emplace( const std::string& name );
+
+                std::array< Method, Capacity > m_methods;
+
+                std::size_t m_size;
+            };
+        }
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_NETWORK_LSP_DISPATCHER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,265 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Executor.h"
+
+#include <cassert>
+
+using namespace libstdhl;
+using namespace Network;
+using namespace LSP;
+
+//
+//
+// Cancellation
+//
+
+namespace
+{
+    static thread_local const Cancellation* s_current = nullptr;
+}
+
+Cancellation::Scope::Scope( const Cancellation* token )
+: m_previous( s_current )
+{
+    s_current = token;
+}
+
+Cancellation::Scope::~Scope( void )
+{
+    s_current = m_previous;
+}
+
+Cancellation::Cancellation( void )
+: m_cancelled( false )
+{
+}
+
+void Cancellation::cancel( void )
+{
+    m_cancelled.store( true, std::memory_order_release );
+}
+
+u1 Cancellation::cancelled( void ) const
+{
+    return m_cancelled.load( std::memory_order_acquire );
+}
+
+const Cancellation* Cancellation::current( void )
+{
+    return s_current;
+}
+
+//
+//
+// Executor
+//
+
+Executor::Executor( const std::size_t workers )
+: m_queue()
+, m_strands()
+, m_pending( 0 )
+, m_stop( false )
+, m_mutex()
+, m_produced()
+, m_finished()
+, m_threads()
+{
+    assert( workers > 0 );
+
+    for( std::size_t i = 0; i < workers; i++ )
+    {
+        m_threads.emplace_back( &Executor::run, this );
+    }
+}
+
+Executor::~Executor( void )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_stop = true;
+    }
+
+    m_produced.notify_all();
+    for( auto& thread : m_threads )
+    {
+        thread.join();
+    }
+}
+
+std::size_t Executor::workers( void ) const
+{
+    return m_threads.size();
+}
+
+void Executor::submit( const Task& task )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_queue.emplace_back( task );
+        m_pending++;
+    }
+
+    m_produced.notify_one();
+}
+
+void Executor::submit( const std::string& key, const Task& task, const Access access )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_strands[ key ].queue.emplace_back( Entry{ task, access } );
+        m_pending++;
+        schedule( key );
+    }
+
+    m_produced.notify_all();
+}
+
+void Executor::wait( void )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    m_finished.wait( lock, [this] { return m_pending == 0; } );
+}
+
+std::size_t Executor::pending( void )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    return m_pending;
+}
+
+void Executor::run( void )
+{
+    while( true )
+    {
+        Task task;
+
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            m_produced.wait( lock, [this] {
+                return not m_queue.empty() or ( m_stop and m_pending == 0 );
+            } );
+
+            if( m_queue.empty() )
+            {
+                // stop requested and all submitted tasks are finished
+                return;
+            }
+
+            task = std::move( m_queue.front() );
+            m_queue.pop_front();
+        }
+
+        task();
+        task = nullptr;
+
+        {
+            std::lock_guard< std::mutex > guard( m_mutex );
+            m_pending--;
+        }
+
+        m_finished.notify_all();
+        m_produced.notify_all();
+    }
+}
+
+void Executor::schedule( const std::string& key )
+{
+    auto strand = m_strands.find( key );
+    assert( strand != m_strands.end() );
+    auto& state = strand->second;
+
+    while( not state.queue.empty() and not state.exclusive )
+    {
+        const u1 exclusive = ( state.queue.front().access == Access::EXCLUSIVE );
+        if( exclusive and state.shared > 0 )
+        {
+            // waits for the running shared tasks
+            break;
+        }
+
+        auto entry = std::move( state.queue.front() );
+        state.queue.pop_front();
+
+        if( exclusive )
+        {
+            state.exclusive = true;
+        }
+        else
+        {
+            state.shared++;
+        }
+
+        m_queue.emplace_back( [this, key, exclusive, task = std::move( entry.task )]() {
+            task();
+
+            std::lock_guard< std::mutex > guard( m_mutex );
+            auto strand = m_strands.find( key );
+            auto& state = strand->second;
+            if( exclusive )
+            {
+                state.exclusive = false;
+            }
+            else
+            {
+                state.shared--;
+            }
+
+            if( state.queue.empty() and state.shared == 0 and not state.exclusive )
+            {
+                m_strands.erase( strand );
+            }
+            else
+            {
+                schedule( key );
+            }
+        } );
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,210 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_NETWORK_LSP_EXECUTOR_H_
+#define _LIBSTDHL_CPP_NETWORK_LSP_EXECUTOR_H_
+
+#include <libstdhl/Type>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+   @brief    TBD
+
+   TBD
+*/
+
+namespace libstdhl
+{
+    namespace Network
+    {
+        namespace LSP
+        {
+            /**
+               Cancellation state of a single request, polled by its handler.
+            */
+            class Cancellation final
+            {
+              public:
+                using Ptr = std::shared_ptr< Cancellation >;
+
+                /**
+                   makes 'token' the current token of the calling thread for its lifetime
+                */
+                class Scope final
+                {
+                  public:
+                    Scope( const Cancellation* token );
+
+                    ~Scope( void );
+
+                  private:
+                    const Cancellation* m_previous;
+                };
+
+                Cancellation( void );
+
+                void cancel( void );
+
+                u1 cancelled( void ) const;
+
+                /**
+                   token of the request processed by the calling thread or 'nullptr'
+                */
+                static const Cancellation* current( void );
+
+              private:
+                std::atomic< u1 > m_cancelled;
+            };
+
+            /**
+               Fixed pool of worker threads for request and notification handlers.
+
+               Unordered tasks are taken by the next idle worker. Tasks submitted with a
+               key are ordered like a reader-writer lock in submission order: an exclusive
+               task starts after all earlier tasks of its key finished and blocks all later
+               ones, consecutive shared tasks of a key run in parallel. Different keys and
+               unordered tasks proceed in parallel. Tasks must not throw.
+            */
+            class Executor final
+            {
+              public:
+                using Ptr = std::shared_ptr< Executor >;
+
+                using Task = std::function< void( void ) >;
+
+                enum class Access : u8
+                {
+                    SHARED,
+                    EXCLUSIVE
+                };
+
+                Executor( const std::size_t workers );
+
+                /**
+                   finishes all submitted tasks before the workers are joined
+                */
+                ~Executor( void );
+
+                std::size_t workers( void ) const;
+
+                void submit( const Task& task );
+
+                void submit(
+                    const std::string& key,
+                    const Task& task,
+                    const Access access = Access::EXCLUSIVE );
+
+                /**
+                   blocks until all submitted tasks are finished
+                */
+                void wait( void );
+
+                /**
+                   amount of submitted tasks which are not finished yet
+                */
+                std::size_t pending( void );
+
+              private:
+                void run( void );
+
+                struct Entry
+                {
+                    Task task;
+
+                    Access access;
+                };
+
+                struct Strand
+                {
+                    std::deque< Entry > queue;
+
+                    std::size_t shared = 0;
+
+                    u1 exclusive = false;
+                };
+
+                /**
+                   moves the runnable front entries of 'key' to the queue, needs the lock
+                */
+                void schedule( const std::string& key );
+
+                std::deque< Task > m_queue;
+
+                std::unordered_map< std::string, Strand > m_strands;
+
+                std::size_t m_pending;
+
+                u1 m_stop;
+
+                std::mutex m_mutex;
+
+                std::condition_variable m_produced;
+
+                std::condition_variable m_finished;
+
+                std::vector< std::thread > m_threads;
+            };
+        }
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_NETWORK_LSP_EXECUTOR_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
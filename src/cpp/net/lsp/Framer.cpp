@@ -0,0 +1,214 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Framer.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace libstdhl;
+using namespace Network;
+using namespace LSP;
+
+static const std::string SEPARATOR = NL + NL;
+
+//
+//
+// Framer::View
+//
+
+Framer::View::View( void )
+: m_data( nullptr )
+, m_size( 0 )
+{
+}
+
+Framer::View::View( const char* data, const std::size_t size )
+: m_data( data )
+, m_size( size )
+{
+}
+
+const char* Framer::View::data( void ) const
+{
+    return m_data;
+}
+
+std::size_t Framer::View::size( void ) const
+{
+    return m_size;
+}
+
+std::string Framer::View::str( void ) const
+{
+    return std::string( m_data, m_size );
+}
+
+Message Framer::View::parse( void ) const
+{
+    return Message::parse( m_data, m_size );
+}
+
+//
+//
+// Framer
+//
+
+constexpr std::size_t Framer::MaxHeader;
+
+Framer::Framer( const std::size_t capacity )
+: m_buffer( std::max( capacity, MaxHeader ) )
+, m_begin( 0 )
+, m_end( 0 )
+, m_scan( 0 )
+, m_length( 0 )
+{
+}
+
+void Framer::feed( const char* data, const std::size_t size )
+{
+    if( m_end + size > m_buffer.size() )
+    {
+        // reclaim the consumed bytes before growing the buffer
+        std::memmove( m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin );
+        m_end -= m_begin;
+        m_scan -= m_begin;
+        m_begin = 0;
+
+        if( m_end + size > m_buffer.size() )
+        {
+            m_buffer.resize( std::max( 2 * m_buffer.size(), m_end + size ) );
+        }
+    }
+
+    std::memcpy( m_buffer.data() + m_end, data, size );
+    m_end += size;
+}
+
+void Framer::feed( const std::string& data )
+{
+    feed( data.data(), data.size() );
+}
+
+u1 Framer::next( View& payload )
+{
+    const auto buffer = m_buffer.data();
+
+    if( m_length == 0 )
+    {
+        const auto end = buffer + m_end;
+        const auto separator =
+            std::search( buffer + m_scan, end, SEPARATOR.begin(), SEPARATOR.end() );
+
+        if( separator == end )
+        {
+            if( m_end - m_begin > MaxHeader )
+            {
+                clear();
+                throw std::domain_error(
+                    "LSP: header exceeds " + std::to_string( MaxHeader ) + " bytes" );
+            }
+
+            // a separator may start in the last bytes of this chunk
+            m_scan = std::max( m_begin, m_end - std::min( m_end, SEPARATOR.size() - 1 ) );
+            return false;
+        }
+
+        const auto header = buffer + m_begin;
+        const auto size = static_cast< std::size_t >( separator - header );
+
+        // the header is consumed even if it is invalid, framing resumes after it
+        m_begin += size + SEPARATOR.size();
+        m_scan = m_begin;
+
+        const auto protocol = Protocol::parse( header, size );
+        if( protocol.length() == 0 )
+        {
+            throw std::domain_error( "LSP: missing content length" );
+        }
+
+        m_length = protocol.length();
+    }
+
+    if( m_end - m_begin < m_length )
+    {
+        return false;
+    }
+
+    payload = View( buffer + m_begin, m_length );
+
+    m_begin += m_length;
+    m_scan = m_begin;
+    m_length = 0;
+
+    if( m_begin == m_end )
+    {
+        // the yielded views stay intact until the next 'feed' writes to the buffer
+        m_begin = 0;
+        m_end = 0;
+        m_scan = 0;
+    }
+
+    return true;
+}
+
+std::size_t Framer::buffered( void ) const
+{
+    return m_end - m_begin;
+}
+
+void Framer::clear( void )
+{
+    m_begin = 0;
+    m_end = 0;
+    m_scan = 0;
+    m_length = 0;
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,147 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_NETWORK_LSP_FRAMER_H_
+#define _LIBSTDHL_CPP_NETWORK_LSP_FRAMER_H_
+
+#include <libstdhl/net/lsp/Message>
+#include <libstdhl/net/lsp/Protocol>
+
+#include <vector>
+
+/**
+   @brief    TBD
+
+   TBD
+*/
+
+namespace libstdhl
+{
+    namespace Network
+    {
+        namespace LSP
+        {
+            /**
+               Incremental framer for base protocol streams (stdio, sockets).
+
+               Arbitrary chunks of the stream are appended with 'feed' and 'next' yields
+               the payload of every completed message as a view into the internal buffer.
+               Headers are parsed in place and consumed bytes are reclaimed by moving the
+               unread tail to the front, so a connection keeps reusing one buffer.
+            */
+            class Framer final
+            {
+              public:
+                /**
+                   payload of a framed message, valid until the next 'feed' or 'clear'
+                */
+                class View
+                {
+                  public:
+                    View( void );
+
+                    View( const char* data, const std::size_t size );
+
+                    const char* data( void ) const;
+
+                    std::size_t size( void ) const;
+
+                    std::string str( void ) const;
+
+                    Message parse( void ) const;
+
+                  private:
+                    const char* m_data;
+
+                    std::size_t m_size;
+                };
+
+                /**
+                   headers longer than this are treated as a corrupted stream
+                */
+                static constexpr std::size_t MaxHeader = 8192;
+
+                Framer( const std::size_t capacity = 1 << 16 );
+
+                void feed( const char* data, const std::size_t size );
+
+                void feed( const std::string& data );
+
+                /**
+                   yields the next completed payload, a malformed header is skipped and
+                   reported with a 'std::domain_error'
+                */
+                u1 next( View& payload );
+
+                /**
+                   number of received bytes not yet yielded
+                */
+                std::size_t buffered( void ) const;
+
+                void clear( void );
+
+              private:
+                std::vector< char > m_buffer;
+
+                std::size_t m_begin;
+
+                std::size_t m_end;
+
+                std::size_t m_scan;
+
+                u64 m_length;
+            };
+        }
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_NETWORK_LSP_FRAMER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
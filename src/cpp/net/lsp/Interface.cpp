@@ -41,6 +41,7 @@
 
 #include "Interface.h"
 
+#include "Exception.h"
 #include "Identifier.h"
 
 #include <libstdhl/data/log/Timestamp>
@@ -49,6 +50,119 @@ using namespace libstdhl;
 using namespace Network;
 using namespace LSP;
 
+namespace
+{
+    static ResponseMessage process(
+        ServerInterface& interface,
+        const std::string& id,
+        const Dispatcher::Request& handler,
+        const Data& params,
+        const Cancellation* token )
+    {
+        auto response = ResponseMessage( id );
+
+        const auto cancel = [&]() {
+            response.setError( ErrorCode::RequestCancelled, "request '" + id + "' cancelled" );
+        };
+
+        if( token and token->cancelled() )
+        {
+            cancel();
+            return response;
+        }
+
+        Cancellation::Scope scope( token );
+        try
+        {
+            auto result = handler( interface, params );
+            if( token and token->cancelled() )
+            {
+                cancel();
+            }
+            else
+            {
+                response.setResult( std::move( result ) );
+            }
+        }
+        catch( const Exception& e )
+        {
+            response.setError( e.code(), e.message(), e.data() );
+        }
+        catch( const std::invalid_argument& e )
+        {
+            response.setError(
+                ErrorCode::ParseError, "parse error: '" + std::string( e.what() ) + "'" );
+        }
+        catch( const std::exception& e )
+        {
+            response.setError(
+                ErrorCode::InternalError, "internal error: '" + std::string( e.what() ) + "'" );
+        }
+
+        return response;
+    }
+
+    static void process(
+        ServerInterface& interface,
+        const std::string& name,
+        const Dispatcher::Notification& handler,
+        const Data& params )
+    {
+        auto response = ResponseMessage();
+
+        try
+        {
+            handler( interface, params );
+        }
+        catch( const std::invalid_argument& e )
+        {
+            response.setError(
+                ErrorCode::ParseError,
+                "notification method '" + name + "': parse error: '" + std::string( e.what() ) +
+                    "'" );
+        }
+        catch( const std::exception& e )
+        {
+            response.setError(
+                ErrorCode::InternalError,
+                "notification method '" + name + "': internal error: '" +
+                    std::string( e.what() ) + "'" );
+        }
+
+        if( response.hasError() )
+        {
+            interface.respond( response );
+        }
+    }
+
+    static const Data& parameters( const Message& message )
+    {
+        static const Data none;
+        const auto params = message.find( Identifier::params );
+        return params != message.end() ? *params : none;
+    }
+
+    /**
+       notifications about the same document are processed in order
+    */
+    static std::string document( const Data& params )
+    {
+        if( params.is_object() )
+        {
+            const auto document = params.find( Identifier::textDocument );
+            if( document != params.end() and document->is_object() )
+            {
+                const auto uri = document->find( Identifier::uri );
+                if( uri != document->end() and uri->is_string() )
+                {
+                    return uri->get< std::string >();
+                }
+            }
+        }
+        return std::string();
+    }
+}
+
 ServerInterface::ServerInterface( void )
 : m_responseBuffer()
 , m_responseBufferSlot( 0 )
@@ -61,9 +175,26 @@ ServerInterface::ServerInterface( void )
 , m_requestBufferSlot( 0 )
 , m_requestBufferLock()
 , m_requestCallback()
+, m_dispatcher()
+, m_executor()
+, m_coalescer()
+, m_debounce( 0 )
+, m_pending()
+, m_pendingLock()
 {
 }
 
+ServerInterface::~ServerInterface( void )
+{
+    // finishes the scheduled work while the pending requests are still alive
+    m_coalescer.reset();
+    if( m_executor )
+    {
+        m_executor->wait();
+        m_executor.reset();
+    }
+}
+
 //
 //
 // ServerInterface Lifetime
@@ -249,6 +380,12 @@ void ServerInterface::flush( const std::function< void( const Message& ) >& call
     m_requestBuffer[ pos ].clear();
 }
 
+std::size_t ServerInterface::notifications( void )
+{
+    std::lock_guard< std::mutex > guard( m_notificationBufferLock );
+    return m_notificationBuffer[ m_notificationBufferSlot ].size();
+}
+
 void ServerInterface::respond( const ResponseMessage& message )
 {
     std::lock_guard< std::mutex > guard( m_responseBufferLock );
@@ -266,6 +403,185 @@ void ServerInterface::handle( const ResponseMessage& message )
     }
 }
 
+Dispatcher& ServerInterface::dispatcher( void )
+{
+    return m_dispatcher;
+}
+
+const Dispatcher& ServerInterface::dispatcher( void ) const
+{
+    return m_dispatcher;
+}
+
+void ServerInterface::setWorkers( const std::size_t workers )
+{
+    // delivers the pending changes to the current workers
+    m_coalescer.reset();
+
+    if( m_executor )
+    {
+        m_executor->wait();
+        m_executor.reset();
+    }
+
+    if( workers > 0 )
+    {
+        m_executor = std::make_shared< Executor >( workers );
+    }
+
+    coalesce();
+}
+
+std::size_t ServerInterface::workers( void ) const
+{
+    return m_executor ? m_executor->workers() : 0;
+}
+
+void ServerInterface::setDebounce( const std::chrono::milliseconds quiet )
+{
+    m_coalescer.reset();
+    m_debounce = quiet;
+    coalesce();
+}
+
+std::chrono::milliseconds ServerInterface::debounce( void ) const
+{
+    return m_debounce;
+}
+
+void ServerInterface::wait( void )
+{
+    if( m_coalescer )
+    {
+        m_coalescer->flush();
+    }
+
+    if( m_executor )
+    {
+        m_executor->wait();
+    }
+}
+
+u1 ServerInterface::cancel( const std::string& id )
+{
+    std::lock_guard< std::mutex > guard( m_pendingLock );
+    const auto pending = m_pending.find( id );
+    if( pending == m_pending.end() )
+    {
+        return false;
+    }
+
+    pending->second->cancel();
+    return true;
+}
+
+u1 ServerInterface::cancelled( void ) const
+{
+    const auto token = Cancellation::current();
+    return token and token->cancelled();
+}
+
+void ServerInterface::execute( const RequestMessage& message, const Dispatcher::Method& method )
+{
+    const auto id = message.id();
+
+    if( not m_executor or method.execution != Dispatcher::Execution::CONCURRENT )
+    {
+        if( method.execution == Dispatcher::Execution::SEQUENTIAL )
+        {
+            wait();
+        }
+
+        respond( process( *this, id, method.request, parameters( message ), nullptr ) );
+        return;
+    }
+
+    // the task outlives the message, it owns the only copy of the parameters
+    auto params = parameters( message );
+    const auto key = document( params );
+    if( m_coalescer and not key.empty() )
+    {
+        m_coalescer->flush( key );
+    }
+
+    const auto token = std::make_shared< Cancellation >();
+    {
+        std::lock_guard< std::mutex > guard( m_pendingLock );
+        m_pending[ id ] = token;
+    }
+
+    auto task = [this, id, token, handler = method.request, params = std::move( params )]() {
+        auto response = process( *this, id, handler, params, token.get() );
+
+        {
+            std::lock_guard< std::mutex > guard( m_pendingLock );
+            const auto pending = m_pending.find( id );
+            if( pending != m_pending.end() and pending->second == token )
+            {
+                m_pending.erase( pending );
+            }
+        }
+
+        respond( response );
+    };
+
+    if( key.empty() )
+    {
+        m_executor->submit( task );
+    }
+    else
+    {
+        // runs after the earlier notifications of the document and in parallel to
+        // other requests of the document
+        m_executor->submit( key, task, Executor::Access::SHARED );
+    }
+}
+
+void ServerInterface::execute(
+    const NotificationMessage& message, const Dispatcher::Method& method )
+{
+    const auto& name = message.at( Identifier::method ).get_ref< const std::string& >();
+
+    if( not m_executor or method.execution != Dispatcher::Execution::CONCURRENT )
+    {
+        if( method.execution == Dispatcher::Execution::SEQUENTIAL )
+        {
+            wait();
+        }
+
+        process( *this, name, method.notification, parameters( message ) );
+        return;
+    }
+
+    // the task outlives the message, it owns the only copy of the parameters
+    auto params = parameters( message );
+    const auto key = document( params );
+
+    if( m_coalescer and not key.empty() )
+    {
+        if( name == Identifier::textDocument_didChange )
+        {
+            try
+            {
+                m_coalescer->add( DidChangeTextDocumentParams( params ) );
+                return;
+            }
+            catch( const std::invalid_argument& )
+            {
+                // the handler reports the invalid parameters
+            }
+        }
+
+        m_coalescer->flush( key );
+    }
+
+    m_executor->submit(
+        key,
+        [this, name, handler = method.notification, params = std::move( params )]() {
+            process( *this, name, handler, params );
+        } );
+}
+
 void ServerInterface::request(
     const RequestMessage& message, const std::function< void( const ResponseMessage& ) >& callback )
 {
@@ -280,6 +596,33 @@ void ServerInterface::notify( const NotificationMessage& message )
     m_notificationBuffer[ m_notificationBufferSlot ].emplace_back( message );
 }
 
+void ServerInterface::coalesce( void )
+{
+    m_coalescer.reset();
+
+    if( not m_executor or m_debounce.count() == 0 )
+    {
+        return;
+    }
+
+    const auto executor = m_executor;
+    m_coalescer = std::make_shared< Coalescer >(
+        m_debounce,
+        [this, executor](
+            const std::string& uri, const Data& params, const Cancellation::Ptr& token ) {
+            executor->submit( uri, [this, params, token]() {
+                const auto method =
+                    m_dispatcher.find( std::string( Identifier::textDocument_didChange ) );
+                if( method and method->notification )
+                {
+                    Cancellation::Scope scope( token.get() );
+                    process(
+                        *this, Identifier::textDocument_didChange, method->notification, params );
+                }
+            } );
+        } );
+}
+
 std::string ServerInterface::nextId( void )
 {
     auto timestamp = Log::Timestamp();
@@ -43,6 +43,9 @@
 #ifndef _LIBSTDHL_CPP_NETWORK_LSP_INTERFACE_H_
 #define _LIBSTDHL_CPP_NETWORK_LSP_INTERFACE_H_
 
+#include <libstdhl/net/lsp/Coalescer>
+#include <libstdhl/net/lsp/Dispatcher>
+#include <libstdhl/net/lsp/Executor>
 #include <libstdhl/net/lsp/Message>
 
 #include <mutex>
@@ -69,7 +72,7 @@ namespace libstdhl
               public:
                 ServerInterface( void );
 
-                virtual ~ServerInterface( void ) = default;
+                virtual ~ServerInterface( void );
 
                 //
                 //
@@ -360,8 +363,68 @@ namespace libstdhl
 
                 void flush( const std::function< void( const Message& ) >& callback );
 
+                /**
+                   amount of notifications waiting for the next flush
+                */
+                std::size_t notifications( void );
+
                 void respond( const ResponseMessage& message );
 
+                /**
+                   method table used to process requests and notifications, custom and
+                   '$/' methods are registered here
+                */
+                Dispatcher& dispatcher( void );
+
+                const Dispatcher& dispatcher( void ) const;
+
+                /**
+                   processes concurrent requests and notifications on 'workers' threads,
+                   zero (default) processes everything on the reading thread, requests about
+                   a document run after the earlier notifications of the document, derived
+                   servers with workers call 'wait' before they are destroyed, because the
+                   workers can still call their handlers
+                */
+                void setWorkers( const std::size_t workers );
+
+                std::size_t workers( void ) const;
+
+                /**
+                   with workers, 'textDocument/didChange' notifications of a document are
+                   merged and delivered after no further change arrived for 'quiet', zero
+                   (default) delivers every notification, other messages about a document
+                   deliver its pending changes first, 'didChange' handlers have to apply the
+                   edits before they poll 'cancelled'
+                */
+                void setDebounce( const std::chrono::milliseconds quiet );
+
+                std::chrono::milliseconds debounce( void ) const;
+
+                /**
+                   blocks until all scheduled requests and notifications are processed,
+                   pending document changes are delivered right away
+                */
+                void wait( void );
+
+                /**
+                   cancels the queued or running request 'id', false if it is not pending
+                */
+                u1 cancel( const std::string& id );
+
+                /**
+                   true if the request processed by the calling thread has been cancelled,
+                   long running handlers poll this to stop early
+                */
+                u1 cancelled( void ) const;
+
+                /**
+                   schedules 'method' for 'message' as specified by its execution
+                */
+                void execute( const RequestMessage& message, const Dispatcher::Method& method );
+
+                void execute(
+                    const NotificationMessage& message, const Dispatcher::Method& method );
+
                 void handle( const ResponseMessage& message );
 
               private:
@@ -373,6 +436,8 @@ namespace libstdhl
 
                 std::string nextId( void );
 
+                void coalesce( void );
+
               private:
                 std::vector< Message > m_responseBuffer[ 2 ];
                 std::size_t m_responseBufferSlot;
@@ -389,6 +454,16 @@ namespace libstdhl
                     m_requestCallback;
 
                 std::mutex m_serverFlushLock;
+
+                Dispatcher m_dispatcher;
+
+                Executor::Ptr m_executor;
+
+                Coalescer::Ptr m_coalescer;
+                std::chrono::milliseconds m_debounce;
+
+                std::unordered_map< std::string, Cancellation::Ptr > m_pending;
+                std::mutex m_pendingLock;
             };
         }
     }
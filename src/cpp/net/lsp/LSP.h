@@ -43,10 +43,15 @@
 #ifndef _LIBSTDHL_CPP_NETWORK_LSP_H_
 #define _LIBSTDHL_CPP_NETWORK_LSP_H_
 
+#include <libstdhl/net/lsp/Coalescer>
 #include <libstdhl/net/lsp/Content>
+#include <libstdhl/net/lsp/Dispatcher>
 #include <libstdhl/net/lsp/Exception>
+#include <libstdhl/net/lsp/Executor>
+#include <libstdhl/net/lsp/Framer>
 #include <libstdhl/net/lsp/Identifier>
 #include <libstdhl/net/lsp/Interface>
+#include <libstdhl/net/lsp/LogSink>
 #include <libstdhl/net/lsp/Message>
 #include <libstdhl/net/lsp/Packet>
 #include <libstdhl/net/lsp/Protocol>
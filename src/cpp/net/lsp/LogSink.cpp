@@ -0,0 +1,283 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "LogSink.h"
+
+#include <libstdhl/data/log/Data>
+#include <libstdhl/data/log/Stream>
+
+using namespace libstdhl;
+using namespace Network;
+using namespace LSP;
+
+LogSink::LogSink( ServerInterface& server, Log::Formatter& formatter )
+: m_server( server )
+, m_formatter( formatter )
+, m_window( 100 )
+, m_limit( 16 * 1024 )
+, m_capacity( 1024 * 1024 )
+, m_notifications( 64 )
+, m_batches()
+, m_pending( 0 )
+, m_dropped( 0 )
+, m_unreported( 0 )
+, m_buffer()
+, m_mutex()
+, m_produced()
+, m_stop( false )
+, m_thread()
+{
+    m_thread = std::thread( &LogSink::run, this );
+}
+
+LogSink::~LogSink( void )
+{
+    {
+        std::lock_guard< std::mutex > guard( m_mutex );
+        m_stop = true;
+    }
+
+    m_produced.notify_one();
+    m_thread.join();
+}
+
+void LogSink::setWindow( const std::chrono::milliseconds window )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    m_window = window;
+}
+
+void LogSink::setLimit( const std::size_t limit )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    m_limit = limit;
+}
+
+void LogSink::setCapacity( const std::size_t capacity )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    m_capacity = capacity;
+}
+
+void LogSink::setNotifications( const std::size_t notifications )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    m_notifications = notifications;
+}
+
+void LogSink::flush( void )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    send( lock );
+}
+
+std::size_t LogSink::dropped( void )
+{
+    std::lock_guard< std::mutex > guard( m_mutex );
+    return m_dropped;
+}
+
+MessageType LogSink::messageType( const Log::Level::ID level )
+{
+    switch( level )
+    {
+        case Log::Level::ID::EMERGENCY:  // [[fallthrough]]
+        case Log::Level::ID::ALERT:      // [[fallthrough]]
+        case Log::Level::ID::CRITICAL:   // [[fallthrough]]
+        case Log::Level::ID::ERROR:
+        {
+            return MessageType::Error;
+        }
+        case Log::Level::ID::WARNING:
+        {
+            return MessageType::Warning;
+        }
+        case Log::Level::ID::NOTICE:  // [[fallthrough]]
+        case Log::Level::ID::INFORMATIONAL:
+        {
+            return MessageType::Info;
+        }
+        default:
+        {
+            return MessageType::Log;
+        }
+    }
+}
+
+void LogSink::process( const Log::Stream& stream )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    for( auto& data : stream.data() )
+    {
+        if( m_pending >= m_capacity )
+        {
+            m_dropped++;
+            m_unreported++;
+            continue;
+        }
+
+        m_buffer.clear();
+        data.accept( m_formatter, m_buffer );
+
+        const auto type = messageType( data.level().id() );
+
+        if( m_batches.empty() or m_batches.back().type != type or
+            m_batches.back().text.size() >= m_limit )
+        {
+            m_batches.emplace_back( Batch{ type, m_buffer, std::chrono::steady_clock::now() } );
+        }
+        else
+        {
+            auto& batch = m_batches.back();
+            batch.text += "\n";
+            batch.text += m_buffer;
+        }
+
+        m_pending += m_buffer.size() + 1;
+    }
+
+    lock.unlock();
+    m_produced.notify_one();
+}
+
+void LogSink::run( void )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    while( true )
+    {
+        if( m_stop )
+        {
+            send( lock );
+            return;
+        }
+
+        if( m_batches.empty() )
+        {
+            m_produced.wait( lock );
+            continue;
+        }
+
+        if( not due( std::chrono::steady_clock::now() ) )
+        {
+            // the front batch holds the oldest record
+            m_produced.wait_until( lock, m_batches.front().since + m_window );
+            continue;
+        }
+
+        if( m_server.notifications() >= m_notifications )
+        {
+            // the client does not keep up, keep coalescing until the server was flushed
+            m_produced.wait_for( lock, m_window );
+            continue;
+        }
+
+        send( lock );
+    }
+}
+
+u1 LogSink::due( const std::chrono::steady_clock::time_point& now ) const
+{
+    if( m_batches.empty() )
+    {
+        return false;
+    }
+
+    if( now - m_batches.front().since >= m_window )
+    {
+        return true;
+    }
+
+    for( const auto& batch : m_batches )
+    {
+        if( batch.text.size() >= m_limit )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LogSink::send( std::unique_lock< std::mutex >& lock )
+{
+    std::deque< Batch > batches;
+    batches.swap( m_batches );
+    m_pending = 0;
+
+    if( m_unreported > 0 )
+    {
+        // the records were dropped after the pending ones arrived
+        const auto text = std::to_string( m_unreported ) + " log records dropped, capacity of " +
+                          std::to_string( m_capacity ) + " bytes reached";
+
+        if( not batches.empty() and batches.back().type == MessageType::Warning )
+        {
+            batches.back().text += "\n" + text;
+        }
+        else
+        {
+            batches.emplace_back(
+                Batch{ MessageType::Warning, text, std::chrono::steady_clock::now() } );
+        }
+        m_unreported = 0;
+    }
+
+    lock.unlock();
+
+    for( const auto& batch : batches )
+    {
+        m_server.window_logMessage( LogMessageParams( batch.type, batch.text ) );
+    }
+
+    lock.lock();
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,172 @@
+//
+//  Copyright (C) 2014-2024 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber et al.
+//  <https://github.com/casm-lang/libstdhl/graphs/contributors>
+//
+//  This file is part of libstdhl.
+//
+//  libstdhl is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libstdhl is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libstdhl. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libstdhl is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libstdhl
+//  statically or dynamically with other modules is making a combined work
+//  based on libstdhl. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libstdhl give you permission to link libstdhl
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libstdhl. If you modify libstdhl, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#pragma once
+#ifndef _LIBSTDHL_CPP_NETWORK_LSP_LOG_SINK_H_
+#define _LIBSTDHL_CPP_NETWORK_LSP_LOG_SINK_H_
+
+#include <libstdhl/data/log/Channel>
+#include <libstdhl/data/log/Formatter>
+#include <libstdhl/data/log/Level>
+#include <libstdhl/net/lsp/Interface>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+   @brief    TBD
+
+   TBD
+*/
+
+namespace libstdhl
+{
+    namespace Network
+    {
+        namespace LSP
+        {
+            /**
+               Forwards log records as coalesced 'window/logMessage' notifications.
+
+               Records are formatted and appended to the latest batch while their message
+               type stays the same, a record of another type starts a new batch, so the
+               notifications keep the arrival order. Pending batches are sent as one
+               notification each once the oldest record is older than 'window' or a batch
+               exceeds 'limit' bytes. While the server holds more than
+               'notifications' unflushed notifications (the client is slow), batches are
+               kept back, and once 'capacity' bytes are pending, further records are dropped
+               and reported with the next warning batch, so a thread which logs and flushes
+               the server never blocks.
+            */
+            class LogSink final : public Log::Channel
+            {
+              public:
+                using Ptr = std::shared_ptr< LogSink >;
+
+                LogSink( ServerInterface& server, Log::Formatter& formatter );
+
+                ~LogSink( void );
+
+                void setWindow( const std::chrono::milliseconds window );
+
+                void setLimit( const std::size_t limit );
+
+                void setCapacity( const std::size_t capacity );
+
+                void setNotifications( const std::size_t notifications );
+
+                /**
+                   sends all pending batches immediately
+                */
+                void flush( void );
+
+                /**
+                   amount of records dropped because 'capacity' was reached
+                */
+                std::size_t dropped( void );
+
+                static MessageType messageType( const Log::Level::ID level );
+
+              private:
+                struct Batch
+                {
+                    MessageType type;
+                    std::string text;
+                    std::chrono::steady_clock::time_point since;
+                };
+
+                void run( void );
+
+                u1 due( const std::chrono::steady_clock::time_point& now ) const;
+
+                void send( std::unique_lock< std::mutex >& lock );
+
+                ServerInterface& m_server;
+
+                Log::Formatter& m_formatter;
+
+                std::chrono::milliseconds m_window;
+
+                std::size_t m_limit;
+
+                std::size_t m_capacity;
+
+                std::size_t m_notifications;
+
+                std::deque< Batch > m_batches;
+
+                std::size_t m_pending;
+
+                std::size_t m_dropped;
+
+                std::size_t m_unreported;
+
+                std::string m_buffer;
+
+                std::mutex m_mutex;
+
+                std::condition_variable m_produced;
+
+                u1 m_stop;
+
+                std::thread m_thread;
+
+              public:
+                void process( const Log::Stream& stream ) override;
+            };
+        }
+    }
+}
+
+#endif  // _LIBSTDHL_CPP_NETWORK_LSP_LOG_SINK_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -42,11 +42,11 @@
 #include "Message.h"
 
 #include "Content.h"
-#include "Exception.h"
 #include "Identifier.h"
 #include "Interface.h"
 
-#include "../../String.h"
+#include <algorithm>
+#include <cstring>
 
 /**
    @brief    TBD
@@ -58,6 +58,331 @@ using namespace libstdhl;
 using namespace Network;
 using namespace LSP;
 
+//
+//
+// Scanner
+//
+
+namespace
+{
+    /**
+       string values of members named 'text' of at least this size are kept out of the
+       JSON parser and unescaped once directly into their final string
+    */
+    static constexpr std::size_t LargeText = 4096;
+
+    static constexpr std::size_t MaxDepth = 512;
+
+    struct Text
+    {
+        const char* begin;
+
+        const char* end;
+
+        std::string pointer;
+    };
+
+    /**
+       structural scan of a JSON-RPC payload, which recognizes the 'jsonrpc', 'id' and
+       'method' members and locates large 'text' strings without building JSON values
+    */
+    class Scanner
+    {
+      public:
+        Scanner( const char* data, const std::size_t size )
+        : m_position( data )
+        , m_end( data + size )
+        {
+        }
+
+        u1 scan( Message::Header& header, std::vector< Text >& texts )
+        {
+            whitespace();
+            if( not consume( '{' ) )
+            {
+                return false;
+            }
+
+            u1 first = true;
+            while( true )
+            {
+                whitespace();
+                if( first and consume( '}' ) )
+                {
+                    break;
+                }
+                first = false;
+
+                std::string key;
+                if( not string( key ) )
+                {
+                    return false;
+                }
+
+                whitespace();
+                if( not consume( ':' ) )
+                {
+                    return false;
+                }
+                whitespace();
+
+                if( key == Identifier::jsonrpc and peek( '"' ) )
+                {
+                    if( not string( header.jsonrpc ) )
+                    {
+                        return false;
+                    }
+                }
+                else if( key == Identifier::method and peek( '"' ) )
+                {
+                    header.hasMethod = true;
+                    if( not string( header.method ) )
+                    {
+                        return false;
+                    }
+                }
+                else if( key == Identifier::id )
+                {
+                    header.hasId = true;
+                    if( peek( '"' ) )
+                    {
+                        if( not string( header.identifier ) )
+                        {
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        const auto begin = m_position;
+                        if( not value( 0, nullptr, false ) )
+                        {
+                            return false;
+                        }
+                        header.identifier.assign( begin, m_position );
+                    }
+                }
+                else
+                {
+                    m_pointer = "/";
+                    pointer( key );
+                    if( not value( 1, &texts, false ) )
+                    {
+                        return false;
+                    }
+                }
+
+                whitespace();
+                if( consume( ',' ) )
+                {
+                    continue;
+                }
+                if( consume( '}' ) )
+                {
+                    break;
+                }
+                return false;
+            }
+
+            whitespace();
+            return m_position == m_end;
+        }
+
+      private:
+        void whitespace( void )
+        {
+            while( m_position < m_end and ( *m_position == ' ' or *m_position == '\n' or
+                                            *m_position == '\r' or *m_position == '\t' ) )
+            {
+                m_position++;
+            }
+        }
+
+        u1 peek( const char c ) const
+        {
+            return m_position < m_end and *m_position == c;
+        }
+
+        u1 consume( const char c )
+        {
+            if( not peek( c ) )
+            {
+                return false;
+            }
+            m_position++;
+            return true;
+        }
+
+        /**
+           skips a string starting at the current quote, 'escaped' is set if the contents
+           have to be unescaped
+        */
+        u1 skip( u1& escaped )
+        {
+            if( not consume( '"' ) )
+            {
+                return false;
+            }
+
+            escaped = false;
+            while( m_position < m_end )
+            {
+                const auto c = *m_position++;
+                if( c == '"' )
+                {
+                    return true;
+                }
+                if( c == '\\' )
+                {
+                    escaped = true;
+                    m_position++;
+                }
+            }
+            return false;
+        }
+
+        u1 string( std::string& result )
+        {
+            const auto begin = m_position + 1;
+            u1 escaped = false;
+            if( not skip( escaped ) )
+            {
+                return false;
+            }
+
+            if( not escaped )
+            {
+                result.assign( begin, m_position - 1 );
+                return true;
+            }
+            return Json::unescape( begin, m_position - 1, result );
+        }
+
+        void pointer( const std::string& key )
+        {
+            for( const auto c : key )
+            {
+                if( c == '~' )
+                {
+                    m_pointer += "~0";
+                }
+                else if( c == '/' )
+                {
+                    m_pointer += "~1";
+                }
+                else
+                {
+                    m_pointer += c;
+                }
+            }
+        }
+
+        u1 value( const std::size_t depth, std::vector< Text >* texts, const u1 text )
+        {
+            if( depth > MaxDepth or m_position == m_end )
+            {
+                return false;
+            }
+
+            if( *m_position == '"' )
+            {
+                const auto begin = m_position;
+                u1 escaped = false;
+                if( not skip( escaped ) )
+                {
+                    return false;
+                }
+
+                if( text and texts and
+                    static_cast< std::size_t >( m_position - begin ) >= LargeText )
+                {
+                    texts->push_back( Text{ begin, m_position, m_pointer } );
+                }
+                return true;
+            }
+
+            if( *m_position == '{' or *m_position == '[' )
+            {
+                const u1 object = ( *m_position++ == '{' );
+                const auto length = m_pointer.size();
+                std::size_t index = 0;
+
+                whitespace();
+                if( consume( object ? '}' : ']' ) )
+                {
+                    return true;
+                }
+
+                while( true )
+                {
+                    whitespace();
+
+                    std::string key;
+                    if( object )
+                    {
+                        if( not string( key ) )
+                        {
+                            return false;
+                        }
+                        whitespace();
+                        if( not consume( ':' ) )
+                        {
+                            return false;
+                        }
+                        whitespace();
+                    }
+
+                    if( texts )
+                    {
+                        m_pointer.resize( length );
+                        m_pointer += '/';
+                        if( object )
+                        {
+                            pointer( key );
+                        }
+                        else
+                        {
+                            m_pointer += std::to_string( index );
+                        }
+                    }
+
+                    if( not value( depth + 1, texts, object and key == Identifier::text ) )
+                    {
+                        return false;
+                    }
+                    index++;
+
+                    whitespace();
+                    if( consume( ',' ) )
+                    {
+                        continue;
+                    }
+                    if( consume( object ? '}' : ']' ) )
+                    {
+                        m_pointer.resize( length );
+                        return true;
+                    }
+                    return false;
+                }
+            }
+
+            // number, boolean or null
+            const auto begin = m_position;
+            while( m_position < m_end and
+                   std::strchr( ",}] \n\r\t", *m_position ) == nullptr )
+            {
+                m_position++;
+            }
+            return m_position != begin;
+        }
+
+        const char* m_position;
+
+        const char* m_end;
+
+        std::string m_pointer;
+    };
+}
+
 //
 //
 // Message
@@ -71,11 +396,33 @@ Message::Message( const ID id, const Data& data )
     operator[]( Identifier::jsonrpc ) = Identifier::jsonrpc_version;
 }
 
+Message::Message( const ID id, Data&& data )
+: Data( std::move( data ) )
+, m_id( id )
+{
+    assert( id != ID::UNKNOWN );
+    operator[]( Identifier::jsonrpc ) = Identifier::jsonrpc_version;
+}
+
 Message::ID Message::id( void ) const
 {
     return m_id;
 }
 
+Message::ID Message::Header::id( void ) const
+{
+    if( hasId )
+    {
+        // contains 'id' and 'method' ==> request message
+        // contains 'id' and NOT 'method' ==> response message
+        return hasMethod ? ID::REQUEST_MESSAGE : ID::RESPONSE_MESSAGE;
+    }
+
+    // contains NOT 'id' and 'method' ==> notification message
+    // contains NOT 'id' and NOT 'method' ==> invalid message, cannot be parsed
+    return hasMethod ? ID::NOTIFICATION_MESSAGE : ID::UNKNOWN;
+}
+
 const Data& Message::obj( void ) const
 {
     return static_cast< const Data& >( *this );
@@ -87,19 +434,19 @@ void Message::process( ServerInterface& interface ) const
     {
         case ID::REQUEST_MESSAGE:
         {
-            const auto msg = reinterpret_cast< const RequestMessage& >( *this );
+            const auto& msg = reinterpret_cast< const RequestMessage& >( *this );
             msg.process( interface );
             break;
         }
         case ID::NOTIFICATION_MESSAGE:
         {
-            const auto msg = reinterpret_cast< const NotificationMessage& >( *this );
+            const auto& msg = reinterpret_cast< const NotificationMessage& >( *this );
             msg.process( interface );
             break;
         }
         case ID::RESPONSE_MESSAGE:
         {
-            const auto msg = reinterpret_cast< const ResponseMessage& >( *this );
+            const auto& msg = reinterpret_cast< const ResponseMessage& >( *this );
             msg.process( interface );
             break;
         }
@@ -123,68 +470,83 @@ void Message::validate( const Data& data )
 
 Message Message::parse( const std::string& data )
 {
-    ID id = ID::UNKNOWN;
-    Data payload;
+    return parse( data.data(), data.size() );
+}
 
-    // parse JSON data from string
-    payload = Json::Object::parse( data );
-    Message::validate( payload );
+Message Message::parse( const char* data, const std::size_t size )
+{
+    Header header;
+    std::vector< Text > texts;
 
-    const auto& jsonrpc = payload.at( Identifier::jsonrpc ).get< std::string >();
-    if( jsonrpc.compare( Identifier::jsonrpc_version ) != 0 )
+    if( not Scanner( data, size ).scan( header, texts ) )
     {
-        throw std::invalid_argument(
-            "LSP: unsupported version '" + jsonrpc + "', only version '" +
-            Identifier::jsonrpc_version + "' is supported" );
+        // reports the syntax error of the payload
+        Json::Object::parse( data, data + size );
+        throw std::invalid_argument( "LSP: invalid JSON-RPC message payload" );
     }
 
-    if( payload.find( Identifier::id ) != payload.end() )
+    Data payload;
+
+    if( texts.empty() )
     {
-        if( payload.find( Identifier::method ) != payload.end() )
-        {
-            // contains 'id' and 'method'
-            // ==> request message
-            id = ID::REQUEST_MESSAGE;
-        }
-        else
-        {
-            // contains 'id' and NOT 'method'
-            // ==> response message
-            id = ID::RESPONSE_MESSAGE;
-        }
+        // parse JSON data in place
+        payload = Json::parse( data, size );
     }
     else
     {
-        if( payload.find( Identifier::method ) != payload.end() )
+        // parse the payload without the large texts, which are unescaped directly into
+        // the string values afterwards
+        std::string reduced;
+        auto position = data;
+        for( const auto& text : texts )
         {
-            // contains NOT 'id' and 'method'
-            // ==> notification message
-            id = ID::NOTIFICATION_MESSAGE;
+            reduced.append( position, text.begin );
+            reduced += "\"\"";
+            position = text.end;
         }
-        else
+        reduced.append( position, data + size );
+
+        payload = Json::parse( reduced );
+
+        for( const auto& text : texts )
         {
-            // contains NOT 'id' and NOT 'method'
-            // ==> invalid message, cannot be parsed
-            id = ID::UNKNOWN;
+            std::string value;
+            if( not Json::unescape( text.begin + 1, text.end - 1, value ) )
+            {
+                throw std::invalid_argument( "LSP: invalid string at '" + text.pointer + "'" );
+            }
+            payload[ Data::json_pointer( text.pointer ) ].get_ref< std::string& >().swap(
+                value );
         }
     }
 
+    Message::validate( payload );
+
+    if( header.jsonrpc.compare( Identifier::jsonrpc_version ) != 0 )
+    {
+        throw std::invalid_argument(
+            "LSP: unsupported version '" + header.jsonrpc + "', only version '" +
+            Identifier::jsonrpc_version + "' is supported" );
+    }
+
+    const auto id = header.id();
+
     switch( id )
     {
         case ID::REQUEST_MESSAGE:
         {
             RequestMessage::validate( payload );
-            return RequestMessage( payload );
+            return RequestMessage( std::move( payload ) );
         }
         case ID::RESPONSE_MESSAGE:
         {
             ResponseMessage::validate( payload );
-            return ResponseMessage( data );
+            return ResponseMessage( std::move( payload ) );
         }
         case ID::NOTIFICATION_MESSAGE:
         {
             NotificationMessage::validate( payload );
-            return NotificationMessage( payload );
+            return NotificationMessage( std::move( payload ) );
         }
         case ID::UNKNOWN:  // [[fallthrough]]
         case ID::_SIZE_:
@@ -206,6 +568,11 @@ RequestMessage::RequestMessage( const Data& data )
 {
 }
 
+RequestMessage::RequestMessage( Data&& data )
+: Message( ID::REQUEST_MESSAGE, std::move( data ) )
+{
+}
+
 RequestMessage::RequestMessage( const std::size_t id, const std::string& method )
 : Message( ID::REQUEST_MESSAGE )
 {
@@ -252,240 +619,30 @@ Data RequestMessage::params( void ) const
 
 void RequestMessage::setParams( const Data& data )
 {
-    operator[]( Identifier::params ) = Data::from_cbor( Data::to_cbor( data ) );
+    operator[]( Identifier::params ) = data;
 }
 
-void RequestMessage::process( ServerInterface& interface ) const
+void RequestMessage::setParams( Data&& data )
 {
-    auto response = ResponseMessage( id() );
-
-    const auto& m = method();
-    const auto mv = String::value( m );
+    operator[]( Identifier::params ) = std::move( data );
+}
 
-    try
-    {
-        switch( mv )
-        {
-            // default
-            case String::value( Identifier::initialize ):
-            {
-                const auto& parameters = InitializeParams( params() );
-                const auto& result = interface.initialize( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::shutdown ):
-            {
-                interface.shutdown();
-                response.setResult( nullptr );
-                break;
-            }
-                // workspace
-            case String::value( Identifier::workspace_symbol ):
-            {
-                const auto& parameters = WorkspaceSymbolParams( params() );
-                auto result = interface.workspace_symbol( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::workspace_executeCommand ):
-            {
-                const auto& parameters = ExecuteCommandParams( params() );
-                const auto& result = interface.workspace_executeCommand( parameters );
-                response.setResult( result );
-                break;
-            }
-                // document
-            case String::value( Identifier::textDocument_willSaveWaitUntil ):
-            {
-                const auto& parameters = WillSaveTextDocumentParams( params() );
-                const auto& result = interface.textDocument_willSaveWaitUntil( parameters );
-                response.setResult( result );
-                break;
-            }
+void RequestMessage::process( ServerInterface& interface ) const
+{
+    const auto& m = at( Identifier::method ).get_ref< const std::string& >();
+    const auto method = interface.dispatcher().find( m );
 
-            // language features
-            case String::value( Identifier::textDocument_completion ):
-            {
-                const auto& parameters = CompletionParams( params() );
-                const auto& result = interface.textDocument_completion( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::completionItem_resolve ):
-            {
-                const auto& parameters = CompletionParams( params() );
-                const auto& result = interface.completionItem_resolve( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_hover ):
-            {
-                const auto& parameters = HoverParams( params() );
-                const auto& result = interface.textDocument_hover( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_signatureHelp ):
-            {
-                const auto& parameters = SignatureHelpParams( params() );
-                const auto& result = interface.textDocument_signatureHelp( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_definition ):
-            {
-                const auto& parameters = DefinitionParams( params() );
-                const auto& result = interface.textDocument_definition( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_typeDefinition ):
-            {
-                const auto& parameters = TypeDefinitionParams( params() );
-                const auto& result = interface.textDocument_typeDefinition( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_implementation ):
-            {
-                const auto& parameters = TextDocumentImplementationParams( params() );
-                const auto& result = interface.textDocument_implementation( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_references ):
-            {
-                const auto& parameters = ReferenceParams( params() );
-                const auto& result = interface.textDocument_references( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_documentHighlight ):
-            {
-                const auto& parameters = DocumentHighlightParams( params() );
-                const auto& result = interface.textDocument_documentHighlight( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_documentSymbol ):
-            {
-                const auto& parameters = DocumentSymbolParams( params() );
-                const auto& result = interface.textDocument_documentSymbol( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_codeAction ):
-            {
-                const auto& parameters = CodeActionParams( params() );
-                const auto& result = interface.textDocument_codeAction( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_codeLens ):
-            {
-                const auto& parameters = CodeLensParams( params() );
-                const auto& result = interface.textDocument_codeLens( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::codeLens_resolve ):
-            {
-                const auto& parameters = CodeLensResolveParams( params() );
-                const auto& result = interface.codeLens_resolve( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_documentLink ):
-            {
-                const auto& parameters = DocumentLinkParams( params() );
-                const auto& result = interface.textDocument_documentLink( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::documentLink_resolve ):
-            {
-                const auto& parameters = DocumentLinkResolveParams( params() );
-                const auto& result = interface.documentLink_resolve( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_documentColor ):
-            {
-                const auto& parameters = DocumentColorParams( params() );
-                const auto& result = interface.textDocument_documentColor( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_colorPresentation ):
-            {
-                const auto& parameters = ColorPresentationParams( params() );
-                const auto& result = interface.textDocument_colorPresentation( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_formatting ):
-            {
-                const auto& parameters = DocumentFormattingParams( params() );
-                const auto& result = interface.textDocument_formatting( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_rangeFormatting ):
-            {
-                const auto& parameters = DocumentRangeFormattingParams( params() );
-                const auto& result = interface.textDocument_rangeFormatting( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_onTypeFormatting ):
-            {
-                const auto& parameters = DocumentOnTypeFormattingParams( params() );
-                const auto& result = interface.textDocument_onTypeFormatting( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_rename ):
-            {
-                const auto& parameters = RenameParams( params() );
-                const auto& result = interface.textDocument_rename( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_prepareRename ):
-            {
-                const auto& parameters = PrepareRenameParams( params() );
-                const auto& result = interface.textDocument_prepareRename( parameters );
-                response.setResult( result );
-                break;
-            }
-            case String::value( Identifier::textDocument_foldingRange ):
-            {
-                const auto& parameters = FoldingRangeParams( params() );
-                const auto& result = interface.textDocument_foldingRange( parameters );
-                response.setResult( result );
-                break;
-            }
-            default:
-            {
-                response.setError(
-                    ErrorCode::MethodNotFound,
-                    "request method '" + m + "' not specified in interface implementation" );
-                break;
-            }
-        };
-    }
-    catch( const Exception& e )
-    {
-        response.setError( e.code(), e.message(), e.data() );
-    }
-    catch( const std::invalid_argument& e )
+    if( not method or not method->request )
     {
+        auto response = ResponseMessage( id() );
         response.setError(
-            ErrorCode::ParseError, "parse error: '" + std::string( e.what() ) + "'" );
+            ErrorCode::MethodNotFound,
+            "request method '" + m + "' not specified in interface implementation" );
+        interface.respond( response );
+        return;
     }
 
-    interface.respond( response );
+    interface.execute( *this, *method );
 }
 
 void RequestMessage::validate( const Data& data )
@@ -507,6 +664,11 @@ NotificationMessage::NotificationMessage( const Data& data )
 {
 }
 
+NotificationMessage::NotificationMessage( Data&& data )
+: Message( ID::NOTIFICATION_MESSAGE, std::move( data ) )
+{
+}
+
 NotificationMessage::NotificationMessage( const std::string& method )
 : Message( ID::NOTIFICATION_MESSAGE )
 {
@@ -531,105 +693,30 @@ Data NotificationMessage::params( void ) const
 
 void NotificationMessage::setParams( const Data& data )
 {
-    operator[]( Identifier::params ) = Data::from_cbor( Data::to_cbor( data ) );
+    operator[]( Identifier::params ) = data;
 }
 
-void NotificationMessage::process( ServerInterface& interface ) const
+void NotificationMessage::setParams( Data&& data )
 {
-    auto response = ResponseMessage();
+    operator[]( Identifier::params ) = std::move( data );
+}
 
-    const auto& m = method();
-    const auto mv = String::value( m );
+void NotificationMessage::process( ServerInterface& interface ) const
+{
+    const auto& m = at( Identifier::method ).get_ref< const std::string& >();
+    const auto method = interface.dispatcher().find( m );
 
-    try
+    if( method and method->notification )
     {
-        switch( mv )
-        {
-            // general
-            case String::value( Identifier::initialized ):
-            {
-                interface.initialized();
-                break;
-            }
-            case String::value( Identifier::cancelRequest ):
-            {
-                const auto& parameters = CancelParams( params() );
-                interface.client_cancel( parameters );
-                break;
-            }
-            case String::value( Identifier::exit ):
-            {
-                interface.exit();
-                break;
-            }
-            // workspace
-            case String::value( Identifier::workspace_didChangeWorkspaceFolders ):
-            {
-                const auto& parameters = DidChangeWorkspaceFoldersParams( params() );
-                interface.workspace_didChangeWorkspaceFolders( parameters );
-                break;
-            }
-            case String::value( Identifier::workspace_didChangeConfiguration ):
-            {
-                const auto& parameters = DidChangeConfigurationParams( params() );
-                interface.workspace_didChangeConfiguration( parameters );
-                break;
-            }
-            case String::value( Identifier::workspace_didChangeWatchedFiles ):
-            {
-                const auto& parameters = DidChangeWatchedFilesParams( params() );
-                interface.workspace_didChangeWatchedFiles( parameters );
-                break;
-            }
-            // document
-            case String::value( Identifier::textDocument_didOpen ):
-            {
-                const auto& parameters = DidOpenTextDocumentParams( params() );
-                interface.textDocument_didOpen( parameters );
-                break;
-            }
-            case String::value( Identifier::textDocument_didChange ):
-            {
-                const auto& parameters = DidChangeTextDocumentParams( params() );
-                interface.textDocument_didChange( parameters );
-                break;
-            }
-            case String::value( Identifier::textDocument_willSave ):
-            {
-                const auto& parameters = WillSaveTextDocumentParams( params() );
-                interface.textDocument_willSave( parameters );
-                break;
-            }
-            case String::value( Identifier::textDocument_didSave ):
-            {
-                const auto& parameters = DidSaveTextDocumentParams( params() );
-                interface.textDocument_didSave( parameters );
-                break;
-            }
-            case String::value( Identifier::textDocument_didClose ):
-            {
-                const auto& parameters = DidCloseTextDocumentParams( params() );
-                interface.textDocument_didClose( parameters );
-                break;
-            }
-            default:
-            {
-                response.setError(
-                    ErrorCode::MethodNotFound,
-                    "notification method '" + m + "' not specified in interface implementation" );
-                break;
-            }
-        };
+        interface.execute( *this, *method );
     }
-    catch( const std::invalid_argument& e )
+    else if( m.compare( 0, 2, "$/" ) != 0 )
     {
+        // unknown '$/' notifications are protocol dependent and can be ignored
+        auto response = ResponseMessage();
         response.setError(
-            ErrorCode::ParseError,
-            "notification method '" + m + "': parse error: '" + std::string( e.what() ) + "'" );
-    }
-
-    if( response.hasError() )
-    {
+            ErrorCode::MethodNotFound,
+            "notification method '" + m + "' not specified in interface implementation" );
         interface.respond( response );
     }
 }
@@ -652,6 +739,11 @@ ResponseMessage::ResponseMessage( const Data& data )
 {
 }
 
+ResponseMessage::ResponseMessage( Data&& data )
+: Message( ID::RESPONSE_MESSAGE, std::move( data ) )
+{
+}
+
 ResponseMessage::ResponseMessage( const std::size_t id )
 : Message( ID::RESPONSE_MESSAGE )
 {
@@ -687,7 +779,12 @@ Data ResponseMessage::result( void ) const
 
 void ResponseMessage::setResult( const Data& result )
 {
-    operator[]( Identifier::result ) = Data::from_cbor( Data::to_cbor( result ) );
+    operator[]( Identifier::result ) = result;
+}
+
+void ResponseMessage::setResult( Data&& result )
+{
+    operator[]( Identifier::result ) = std::move( result );
 }
 
 u1 ResponseMessage::hasError( void ) const
@@ -702,7 +799,12 @@ ResponseError ResponseMessage::error( void ) const
 
 void ResponseMessage::setError( const ResponseError& error )
 {
-    operator[]( Identifier::error ) = Data::from_cbor( Data::to_cbor( error ) );
+    operator[]( Identifier::error ) = static_cast< const Data& >( error );
+}
+
+void ResponseMessage::setError( ResponseError&& error )
+{
+    operator[]( Identifier::error ) = static_cast< Data&& >( error );
 }
 
 void ResponseMessage::setError( const ErrorCode code, const std::string& name )
@@ -714,7 +816,7 @@ void ResponseMessage::setError( const ErrorCode code, const std::string& name, c
 {
     auto error = ResponseError( code, name );
     error.setData( data );
-    setError( error );
+    setError( std::move( error ) );
 }
 
 void ResponseMessage::process( ServerInterface& interface ) const
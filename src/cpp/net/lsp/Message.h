@@ -78,10 +78,42 @@ namespace libstdhl
                     _SIZE_,
                 };
 
+                /**
+                   members of a payload which are recognized before the JSON object is
+                   built, e.g. to dispatch or cancel a message early
+                */
+                struct Header
+                {
+                    std::string jsonrpc;
+
+                    std::string method;
+
+                    /**
+                       request or response id, numbers are kept in their textual form
+                    */
+                    std::string identifier;
+
+                    u1 hasMethod = false;
+
+                    u1 hasId = false;
+
+                    ID id( void ) const;
+                };
+
                 Message( const ID id, const Data& data = Data::object() );
 
+                Message( const ID id, Data&& data );
+
                 Message( void ) = default;
 
+                Message( const Message& other ) = default;
+
+                Message( Message&& other ) = default;
+
+                Message& operator=( const Message& other ) = default;
+
+                Message& operator=( Message&& other ) = default;
+
                 virtual ~Message( void ) = default;
 
                 ID id( void ) const;
@@ -94,6 +126,8 @@ namespace libstdhl
 
                 static Message parse( const std::string& data );
 
+                static Message parse( const char* data, const std::size_t size );
+
               protected:
                 ID m_id;
             };
@@ -111,6 +145,8 @@ namespace libstdhl
               public:
                 RequestMessage( const Data& data );
 
+                RequestMessage( Data&& data );
+
                 RequestMessage( const std::size_t id, const std::string& method );
 
                 RequestMessage( const std::string& id, const std::string& method );
@@ -125,6 +161,8 @@ namespace libstdhl
 
                 void setParams( const Data& data );
 
+                void setParams( Data&& data );
+
                 virtual void process( ServerInterface& interface ) const override;
 
                 static void validate( const Data& data );
@@ -161,6 +199,8 @@ namespace libstdhl
               public:
                 NotificationMessage( const Data& data );
 
+                NotificationMessage( Data&& data );
+
                 NotificationMessage( const std::string& method );
 
                 std::string method( void ) const;
@@ -171,6 +211,8 @@ namespace libstdhl
 
                 void setParams( const Data& data );
 
+                void setParams( Data&& data );
+
                 virtual void process( ServerInterface& interface ) const override;
 
                 static void validate( const Data& data );
@@ -192,6 +234,8 @@ namespace libstdhl
               public:
                 ResponseMessage( const Data& data );
 
+                ResponseMessage( Data&& data );
+
                 ResponseMessage( const std::size_t id );
 
                 ResponseMessage( const std::string& id );
@@ -206,12 +250,16 @@ namespace libstdhl
 
                 void setResult( const Data& result );
 
+                void setResult( Data&& result );
+
                 u1 hasError( void ) const;
 
                 ResponseError error( void ) const;
 
                 void setError( const ResponseError& error );
 
+                void setError( ResponseError&& error );
+
                 void setError( const ErrorCode code, const std::string& name );
 
                 void setError( const ErrorCode code, const std::string& name, const Data& data );
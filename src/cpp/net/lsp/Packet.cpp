@@ -41,8 +41,6 @@
 
 #include "Packet.h"
 
-#include "../../String.h"
-
 using namespace libstdhl;
 using namespace Network;
 using namespace LSP;
@@ -55,12 +53,19 @@ using namespace LSP;
 LSP::Packet::Packet( const Protocol& header, const Message& payload )
 : m_header( header )
 , m_payload( payload )
-, m_data( m_header.data() + NL + payload.dump() )
+, m_data( m_header.data() + NL + Json::dump( payload ) )
 {
 }
 
 LSP::Packet::Packet( const Message& payload )
-: Packet( Protocol( payload.dump().length() ), payload )
+: Packet( payload, Json::dump( payload ) )
+{
+}
+
+LSP::Packet::Packet( const Message& payload, const std::string& data )
+: m_header( data.length() )
+, m_payload( payload )
+, m_data( m_header.data() + NL + data )
 {
 }
 
@@ -108,24 +113,24 @@ void LSP::Packet::process( ServerInterface& interface ) const
 
 LSP::Packet LSP::Packet::parse( const std::string& data )
 {
-    std::vector< std::string > lines;
-    String::split( data, "\r\n\r\n", lines );
-
-    if( lines.size() != 2 )
+    const auto separator = data.find( "\r\n\r\n" );
+    if( separator == std::string::npos )
     {
         throw std::domain_error( "LSP: invalid package data" );
     }
 
-    Protocol header = Protocol::parse( lines.front() );
+    Protocol header = Protocol::parse( data.data(), separator );
 
-    if( lines.back().size() != header.length() )
+    const auto offset = separator + 2 * NL.size();
+    const auto size = data.size() - offset;
+    if( size != header.length() )
     {
         throw std::domain_error(
-            "LSP: invalid payload length: " + std::to_string( lines.back().size() ) +
+            "LSP: invalid payload length: " + std::to_string( size ) +
             " != " + std::to_string( header.length() ) );
     }
 
-    Message payload = Message::parse( lines.back() );
+    Message payload = Message::parse( data.data() + offset, size );
 
     return Packet( header, payload );
 }
@@ -91,6 +91,8 @@ namespace libstdhl
                 static Packet parse( const std::string& data );
 
               private:
+                Packet( const Message& payload, const std::string& data );
+
                 Protocol m_header;
                 Message m_payload;
                 std::string m_data;
@@ -41,10 +41,8 @@
 
 #include "Protocol.h"
 
-#include <libstdhl/String>
-
-#include <cstring>
-#include <vector>
+#include <algorithm>
+#include <cctype>
 
 using namespace libstdhl;
 using namespace Network;
@@ -82,30 +80,92 @@ std::string LSP::Protocol::type( void ) const
 
 LSP::Protocol LSP::Protocol::parse( const std::string& data )
 {
-    std::vector< std::string > parts;
-    String::split( data, "\r\n", parts );
+    return parse( data.data(), data.size() );
+}
+
+static u1 equals( const char* data, const std::size_t size, const std::string& name )
+{
+    if( size != name.size() )
+    {
+        return false;
+    }
+
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        if( std::tolower( static_cast< u8 >( data[ i ] ) ) != std::tolower( name[ i ] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+LSP::Protocol LSP::Protocol::parse( const char* data, const std::size_t size )
+{
+    static const std::string TYPE_UTF8 = "application/vscode-jsonrpc; charset=utf8";
+
+    const auto end = data + size;
 
     u64 length = 0;
-    for( auto p : parts )
+    for( auto line = data; line < end; )
     {
+        auto next = std::search( line, end, NL.begin(), NL.end() );
+        if( next == line )
+        {
+            line = next + NL.size();
+            continue;
+        }
+
+        const auto colon = std::find( line, next, ':' );
+        if( colon == next )
+        {
+            throw std::domain_error(
+                "LSP: invalid header field '" + std::string( line, next ) + "'" );
+        }
+
+        auto value = colon + 1;
+        auto last = next;
+        while( value < last and std::isspace( static_cast< u8 >( *value ) ) )
+        {
+            value++;
+        }
+        while( last > value and std::isspace( static_cast< u8 >( *( last - 1 ) ) ) )
+        {
+            last--;
+        }
+
         // check for content length field
-        if( strncmp( p.c_str(), CL.c_str(), CL.size() ) == 0 )
+        if( equals( line, colon - line, CL ) )
         {
-            length = std::stoull( p.substr( CL.size() + 1 ) );
+            length = 0;
+            for( auto c = value; c < last; c++ )
+            {
+                if( not std::isdigit( static_cast< u8 >( *c ) ) or length > ( ( u64 )-1 - 9 ) / 10 )
+                {
+                    length = 0;
+                    break;
+                }
+                length = length * 10 + ( *c - '0' );
+            }
+
             if( length == 0 )
             {
-                throw std::domain_error( "LSP: invalid content length '" + p + "'" );
+                throw std::domain_error(
+                    "LSP: invalid content length '" + std::string( line, next ) + "'" );
             }
         }
         // check for content type field
-        else if( strncmp( p.c_str(), CT.c_str(), CT.size() ) == 0 )
+        else if( equals( line, colon - line, CT ) )
         {
-            const auto type = String::trim( p.substr( CL.size() ) );
-            if( type.compare( TYPE ) != 0 )
+            const auto type = std::string( value, last );
+            if( type.compare( TYPE ) != 0 and type.compare( TYPE_UTF8 ) != 0 )
             {
                 throw std::domain_error( "LSP: invalid content type '" + type + "'" );
             }
         }
+
+        line = ( next == end ) ? end : next + NL.size();
     }
 
     return Protocol( length );
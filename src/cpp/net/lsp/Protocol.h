@@ -83,6 +83,12 @@ namespace libstdhl
 
                 static Protocol parse( const std::string& data );
 
+                /**
+                   parses the header block 'data' (without the terminating empty line) in
+                   place, header names are matched case-insensitively
+                */
+                static Protocol parse( const char* data, const std::size_t size );
+
               private:
                 u64 m_length;
                 std::string m_type;